@@ -1,8 +1,47 @@
 #include "src/Game.h"
 
-int main()
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// usage: arcanoid [--seed <n>] [--marathon <level.lvl>]
+//                 [--autoplay] [--autoplay-skill <0..1>] [--autoplay-delay <seconds>]
+int main(int argc, char* argv[])
 {
-    Game game;
+    GameOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--marathon") == 0 && i + 1 < argc)
+        {
+            options.marathonLevel = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--autoplay") == 0)
+        {
+            options.autoplay = true;
+        }
+        else if (std::strcmp(argv[i], "--autoplay-skill") == 0 && i + 1 < argc)
+        {
+            options.autoplay = true;
+            options.autoplaySkill = std::strtof(argv[++i], nullptr);
+        }
+        else if (std::strcmp(argv[i], "--autoplay-delay") == 0 && i + 1 < argc)
+        {
+            options.autoplay = true;
+            options.autoplayReactionDelay = std::strtof(argv[++i], nullptr);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--seed <n>] [--marathon <level.lvl>] [--autoplay]"
+                      << " [--autoplay-skill <0..1>] [--autoplay-delay <seconds>]" << std::endl;
+            return 1;
+        }
+    }
+
+    Game game(options);
     game.run();
     return 0;
 }
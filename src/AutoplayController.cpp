@@ -0,0 +1,56 @@
+#include "AutoplayController.h"
+#include "ECS/ECSManager.h"
+#include "ECS/Components.h"
+#include "GameState.h"
+#include "Sim/BallPath.h"
+#include <algorithm>
+#include <cmath>
+
+AutoplayController::AutoplayController(float skill, float reactionDelay, const RandomStream& random)
+    : skill(std::clamp(skill, 0.0f, 1.0f)), reactionDelay(std::max(reactionDelay, 0.0f)), random(random)
+{
+}
+
+void AutoplayController::steer(float deltaTime, ECSManager& ecs, Entity paddle, InputComponent& input)
+{
+    input.leftPressed = false;
+    input.rightPressed = false;
+
+    auto paddlePosition = ecs.getComponent<PositionComponent>(paddle);
+    auto paddleCollider = ecs.getComponent<ColliderComponent>(paddle);
+    auto ballPosition = ecs.getComponent<PositionComponent>(ball);
+    auto ballVelocity = ecs.getComponent<VelocityComponent>(ball);
+    auto ballCollider = ecs.getComponent<ColliderComponent>(ball);
+    if (!paddlePosition || !paddleCollider || !ballPosition || !ballVelocity || !ballCollider) return;
+
+    const float paddleWidth = paddleCollider->size.x;
+    const bool falling = ballVelocity->velocity.y > 0.0f;
+    if (falling && !ballFalling)
+    {
+        const float miss = (1.0f - skill) * AIM_ERROR * (2.0f * random.nextFloat() - 1.0f);
+        // Middle 40% of the paddle.
+        const float spot = 0.2f * (2.0f * random.nextFloat() - 1.0f);
+        aimOffset = miss + spot;
+    }
+    ballFalling = falling;
+
+    sinceDecision += deltaTime;
+    if (!hasTarget || sinceDecision >= reactionDelay)
+    {
+        sinceDecision = 0.0f;
+        hasTarget = true;
+        const float interceptY = paddlePosition->position.y - ballCollider->radius;
+        const sf::Vector2f position = ballPosition->position;
+        const sf::Vector2f velocity = ballVelocity->velocity;
+        target = predictBallCrossingX(position.x, position.y, velocity.x, velocity.y, ballCollider->radius,
+                                      interceptY, static_cast<float>(GAME_STATE.WINDOW_WIDTH)) +
+                 aimOffset * paddleWidth;
+    }
+
+    // Within one frame's travel counts as there, so the paddle does not
+    // jitter around the target.
+    const float delta = target - (paddlePosition->position.x + paddleWidth / 2.0f);
+    const float deadZone = std::max(input.moveSpeed * deltaTime, 1.0f);
+    input.leftPressed = delta < -deadZone;
+    input.rightPressed = delta > deadZone;
+}
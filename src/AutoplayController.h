@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ECS/Entity.h"
+#include "ECS/Systems/InputSystem.h"
+#include "Random.h"
+
+// Plays the paddle for soak and performance runs. The ball's next crossing
+// of the paddle is predicted in closed form by unfolding its reflections
+// off the walls and ceiling (bricks are not taken into account), so a
+// decision costs a handful of component lookups and no frame stepping.
+//
+// Skill 1 always reaches the predicted point; lower skill aims off by up to
+// (1 - skill) * AIM_ERROR paddle widths, re-rolled for every descent. The
+// bot re-aims at most once per reaction delay, so it lags behind bounces
+// the way a player does. A random spot along the paddle is aimed at to
+// vary the rebound angle.
+class AutoplayController : public PaddleController
+{
+public:
+    static constexpr float AIM_ERROR = 1.5f;
+
+    AutoplayController(float skill, float reactionDelay, const RandomStream& random);
+
+    void setBall(Entity entity)
+    {
+        if (entity != ball) hasTarget = false;
+        ball = entity;
+    }
+    void steer(float deltaTime, ECSManager& ecs, Entity paddle, InputComponent& input) override;
+
+private:
+    float skill;
+    float reactionDelay;
+    RandomStream random;
+
+    Entity ball = INVALID_ENTITY;
+    float sinceDecision = 0.0f;
+    float target = 0.0f;
+    bool hasTarget = false;
+    // Offset from the predicted point, in paddle widths.
+    float aimOffset = 0.0f;
+    bool ballFalling = false;
+};
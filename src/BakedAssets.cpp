@@ -0,0 +1,48 @@
+#include "BakedAssets.h"
+#include "Checksum.h"
+#include "Compression.h"
+#include <iostream>
+
+namespace
+{
+template<typename Buffer>
+bool unpackInto(const BakedAsset& asset, Buffer& out)
+{
+    out.resize(asset.size);
+    const auto input = std::as_bytes(std::span(asset.data, asset.compressedSize));
+    const auto output = std::as_writable_bytes(std::span(out.data(), out.size()));
+    if (!lzDecompress(input, output) || crc32(out.data(), out.size()) != asset.crc)
+    {
+        std::cerr << "Baked asset is corrupt: " << asset.name << std::endl;
+        out.clear();
+        return false;
+    }
+    return true;
+}
+}
+
+const BakedAsset* BakedAssets::findFont(std::string_view name)
+{
+    for (const BakedAsset& font : fonts())
+    {
+        if (font.name == name) return &font;
+    }
+    return nullptr;
+}
+
+const BakedLevel* BakedAssets::findLevel(int number)
+{
+    const auto table = levels();
+    if (number < 1 || number > static_cast<int>(table.size())) return nullptr;
+    return &table[number - 1];
+}
+
+bool BakedAssets::unpack(const BakedAsset& asset, std::vector<std::byte>& out)
+{
+    return unpackInto(asset, out);
+}
+
+bool BakedAssets::unpack(const BakedAsset& asset, std::string& out)
+{
+    return unpackInto(asset, out);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// An asset compressed with lzCompress and compiled into the executable by
+// tools/asset_baker.cpp (see CMakeLists.txt). `crc` is the crc32 of the
+// uncompressed bytes.
+struct BakedAsset
+{
+    std::string_view name;
+    const std::uint8_t* data;
+    std::size_t compressedSize;
+    std::size_t size;
+    std::uint32_t crc;
+};
+
+// Levels are baked in the binary level format after being parsed and
+// validated at build time.
+struct BakedLevel
+{
+    int number;
+    std::uint32_t brickCount;
+    BakedAsset asset;
+};
+
+// Checked with static_assert in the generated table: levels are numbered
+// 1..n in order and none is empty.
+constexpr bool isValidLevelTable(std::span<const BakedLevel> levels)
+{
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        const BakedLevel& level = levels[i];
+        if (level.number != static_cast<int>(i) + 1 || level.brickCount == 0 || level.asset.data == nullptr ||
+            level.asset.compressedSize == 0 || level.asset.size == 0)
+        {
+            return false;
+        }
+    }
+    return !levels.empty();
+}
+
+class BakedAssets
+{
+public:
+    // Defined in the generated source.
+    static std::span<const BakedAsset> fonts();
+    static std::span<const BakedLevel> levels();
+
+    static const BakedAsset* findFont(std::string_view name);
+    static const BakedLevel* findLevel(int number);
+    static int getLevelCount() { return static_cast<int>(levels().size()); }
+
+    // Decompresses and verifies the checksum.
+    static bool unpack(const BakedAsset& asset, std::vector<std::byte>& out);
+    static bool unpack(const BakedAsset& asset, std::string& out);
+};
@@ -0,0 +1,34 @@
+#include "BonusTable.h"
+#include "GameState.h"
+#include "LevelFile.h"
+#include <array>
+
+namespace
+{
+const std::array<BonusDefinition, LEVEL_BONUS_TYPE_COUNT>& table()
+{
+    static const std::array<BonusDefinition, LEVEL_BONUS_TYPE_COUNT> bonuses = {{
+        {BonusType::SlowBall, BonusTarget::Ball, Stat::BallSpeed, 0.5f, 0.0f, GAME_STATE.SLOW_BALL_DURATION,
+         sf::Color::Red},
+        {BonusType::FastPlatform, BonusTarget::Paddle, Stat::PaddleSpeed, 1.5f, 0.0f,
+         GAME_STATE.FAST_PLATFORM_DURATION, sf::Color::Green},
+        {BonusType::BigPlatform, BonusTarget::Paddle, Stat::PaddleWidth, 1.5f, 0.0f, GAME_STATE.BIG_PLATFORM_DURATION,
+         sf::Color::Blue},
+        {BonusType::Laser, BonusTarget::Paddle, Stat::LaserRate, 1.0f, GAME_STATE.LASER_FIRE_RATE,
+         GAME_STATE.LASER_DURATION, sf::Color::Magenta},
+    }};
+    return bonuses;
+}
+}
+
+const BonusDefinition& BonusTable::get(BonusType type)
+{
+    const auto& bonuses = table();
+    const std::size_t index = static_cast<std::size_t>(type);
+    return bonuses[index < bonuses.size() ? index : 0];
+}
+
+std::span<const BonusDefinition> BonusTable::all()
+{
+    return table();
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ECS/Components.h"
+#include <SFML/Graphics.hpp>
+#include <span>
+
+enum class BonusTarget : std::uint8_t
+{
+    Ball,
+    Paddle,
+};
+
+// What collecting a bonus does: add `offset` to one stat of the ball or
+// paddle and multiply it by `factor`, for `duration` seconds.
+struct BonusDefinition
+{
+    BonusType type;
+    BonusTarget target;
+    Stat stat;
+    float factor;
+    float offset;
+    float duration;
+    sf::Color color;
+};
+
+// One entry per BonusType, in enum order. A new bonus is a new BonusType
+// value and a new row in BonusTable.cpp.
+class BonusTable
+{
+public:
+    static const BonusDefinition& get(BonusType type);
+    static std::span<const BonusDefinition> all();
+};
@@ -0,0 +1,52 @@
+#include "Checksum.h"
+
+#include <array>
+#include <cstring>
+
+namespace {
+using CrcTables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+CrcTables makeTables()
+{
+    CrcTables tables{};
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        tables[0][i] = c;
+    }
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        for (std::size_t t = 1; t < 8; ++t)
+            tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+    }
+    return tables;
+}
+}
+
+// Slicing-by-8: eight table lookups per 8 input bytes.
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc)
+{
+    static const CrcTables tables = makeTables();
+
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    crc = ~crc;
+
+    while (size >= 8)
+    {
+        const std::uint32_t lo = crc ^ (static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+                                        (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24));
+        const std::uint32_t hi = static_cast<std::uint32_t>(bytes[4]) | (static_cast<std::uint32_t>(bytes[5]) << 8) |
+                                 (static_cast<std::uint32_t>(bytes[6]) << 16) | (static_cast<std::uint32_t>(bytes[7]) << 24);
+        crc = tables[7][lo & 0xFF] ^ tables[6][(lo >> 8) & 0xFF] ^ tables[5][(lo >> 16) & 0xFF] ^ tables[4][lo >> 24] ^
+              tables[3][hi & 0xFF] ^ tables[2][(hi >> 8) & 0xFF] ^ tables[1][(hi >> 16) & 0xFF] ^ tables[0][hi >> 24];
+        bytes += 8;
+        size -= 8;
+    }
+
+    while (size--)
+        crc = tables[0][(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+}
@@ -0,0 +1,135 @@
+#include "Compression.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+constexpr std::size_t MIN_MATCH = 4;
+constexpr std::size_t MAX_OFFSET = 0xFFFF;
+constexpr int HASH_BITS = 16;
+// Matches may not start in the last bytes, so the final sequence always
+// carries literals (as in LZ4).
+constexpr std::size_t END_LITERALS = 5;
+
+std::uint32_t read32(const std::byte* p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::uint32_t hash(std::uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void writeLength(std::vector<std::byte>& out, std::size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        out.push_back(std::byte{255});
+    }
+    out.push_back(static_cast<std::byte>(length));
+}
+
+void writeSequence(std::vector<std::byte>& out, const std::byte* literals, std::size_t literalLength,
+                   std::size_t offset, std::size_t matchLength)
+{
+    const std::size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+    out.push_back(static_cast<std::byte>((std::min<std::size_t>(literalLength, 15) << 4) |
+                                         std::min<std::size_t>(matchCode, 15)));
+    if (literalLength >= 15) writeLength(out, literalLength - 15);
+    out.insert(out.end(), literals, literals + literalLength);
+    if (matchLength == 0) return;
+
+    out.push_back(static_cast<std::byte>(offset & 0xFF));
+    out.push_back(static_cast<std::byte>(offset >> 8));
+    if (matchCode >= 15) writeLength(out, matchCode - 15);
+}
+
+bool readLength(std::span<const std::byte> input, std::size_t& position, std::size_t& length)
+{
+    std::uint8_t next;
+    do
+    {
+        if (position >= input.size()) return false;
+        next = static_cast<std::uint8_t>(input[position++]);
+        length += next;
+    } while (next == 255);
+    return true;
+}
+}
+
+// Greedy parse with a single-entry hash table of 4-byte sequences.
+std::vector<std::byte> lzCompress(std::span<const std::byte> input)
+{
+    std::vector<std::byte> out;
+    out.reserve(input.size() / 2 + 16);
+    std::vector<std::uint32_t> table(std::size_t{1} << HASH_BITS, UINT32_MAX);
+
+    const std::byte* data = input.data();
+    const std::size_t matchLimit = input.size() > END_LITERALS ? input.size() - END_LITERALS : 0;
+    std::size_t anchor = 0;
+    std::size_t position = 0;
+    while (position + MIN_MATCH <= matchLimit)
+    {
+        const std::uint32_t sequence = read32(data + position);
+        std::uint32_t& slot = table[hash(sequence)];
+        const std::size_t candidate = slot;
+        slot = static_cast<std::uint32_t>(position);
+
+        if (candidate == UINT32_MAX || position - candidate > MAX_OFFSET || read32(data + candidate) != sequence)
+        {
+            position++;
+            continue;
+        }
+
+        std::size_t length = MIN_MATCH;
+        while (position + length < matchLimit && data[candidate + length] == data[position + length])
+        {
+            length++;
+        }
+
+        writeSequence(out, data + anchor, position - anchor, position - candidate, length);
+        position += length;
+        anchor = position;
+    }
+
+    writeSequence(out, data + anchor, input.size() - anchor, 0, 0);
+    return out;
+}
+
+bool lzDecompress(std::span<const std::byte> input, std::span<std::byte> output)
+{
+    std::size_t in = 0;
+    std::size_t out = 0;
+    while (in < input.size())
+    {
+        const auto token = static_cast<std::uint8_t>(input[in++]);
+
+        std::size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(input, in, literalLength)) return false;
+        if (literalLength > input.size() - in || literalLength > output.size() - out) return false;
+        std::copy_n(input.data() + in, literalLength, output.data() + out);
+        in += literalLength;
+        out += literalLength;
+
+        if (in == input.size()) break;
+
+        if (input.size() - in < 2) return false;
+        const std::size_t offset = static_cast<std::size_t>(input[in]) | static_cast<std::size_t>(input[in + 1]) << 8;
+        in += 2;
+        std::size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !readLength(input, in, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > out || matchLength > output.size() - out) return false;
+
+        // Byte by byte: the source may overlap the bytes being written.
+        for (std::size_t i = 0; i < matchLength; ++i, ++out)
+        {
+            output[out] = output[out - offset];
+        }
+    }
+    return out == output.size();
+}
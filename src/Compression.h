@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// LZ77 compression in the LZ4 block layout: each sequence is a token byte
+// (literal length << 4 | match length - 4), extra length bytes when a nibble
+// is 15, the literals, then a 2-byte little-endian match offset. The last
+// sequence has literals only. Used for assets baked into the executable,
+// where decompression speed matters more than ratio.
+std::vector<std::byte> lzCompress(std::span<const std::byte> input);
+
+// `output` must be exactly the uncompressed size. Returns false on malformed
+// input instead of reading or writing out of bounds.
+bool lzDecompress(std::span<const std::byte> input, std::span<std::byte> output);
@@ -0,0 +1,43 @@
+#include "CpuUsageMeter.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+double CpuUsageMeter::processCpuSeconds()
+{
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0.0;
+    auto toTicks = [](const FILETIME& time) {
+        return (static_cast<unsigned long long>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return static_cast<double>(toTicks(kernel) + toTicks(user)) * 1e-7;
+#else
+    timespec time{};
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) return 0.0;
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+#endif
+}
+
+void CpuUsageMeter::restart()
+{
+    wallStart = std::chrono::steady_clock::now();
+    cpuStart = processCpuSeconds();
+}
+
+double CpuUsageMeter::getElapsedSeconds() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+}
+
+double CpuUsageMeter::getCpuPercent() const
+{
+    const double elapsed = getElapsedSeconds();
+    if (elapsed <= 0.0) return 0.0;
+    return (processCpuSeconds() - cpuStart) / elapsed * 100.0;
+}
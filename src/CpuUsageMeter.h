@@ -0,0 +1,21 @@
+#pragma once
+
+#include <chrono>
+
+// Measures the process CPU time consumed since restart() relative to the
+// wall-clock time, as a percentage of one core.
+class CpuUsageMeter
+{
+public:
+    CpuUsageMeter() { restart(); }
+
+    void restart();
+    double getElapsedSeconds() const;
+    double getCpuPercent() const;
+
+private:
+    static double processCpuSeconds();
+
+    std::chrono::steady_clock::time_point wallStart;
+    double cpuStart = 0.0;
+};
@@ -0,0 +1,144 @@
+#include "ComponentPool.h"
+#include <algorithm>
+
+std::shared_ptr<Component> ComponentPool::share(Entity entity) const
+{
+    const std::uint32_t slot = slotOf(entity);
+    if (slot == NONE) return nullptr;
+    return std::shared_ptr<Component>(owners[componentOwners[slot]].storage, components[slot]);
+}
+
+std::uint32_t ComponentPool::addOwner(std::shared_ptr<void> storage)
+{
+    if (freeOwners.empty())
+    {
+        owners.push_back({std::move(storage), 0});
+        return static_cast<std::uint32_t>(owners.size() - 1);
+    }
+    const std::uint32_t owner = freeOwners.back();
+    freeOwners.pop_back();
+    owners[owner].storage = std::move(storage);
+    return owner;
+}
+
+void ComponentPool::releaseOwner(std::uint32_t owner)
+{
+    if (--owners[owner].users > 0) return;
+    owners[owner].storage.reset();
+    freeOwners.push_back(owner);
+}
+
+void ComponentPool::set(Entity entity, Component* component, std::uint32_t owner)
+{
+    owners[owner].users++;
+    const std::uint32_t slot = slotOf(entity);
+    if (slot != NONE)
+    {
+        releaseOwner(componentOwners[slot]);
+        components[slot] = component;
+        componentOwners[slot] = owner;
+        return;
+    }
+
+    const std::size_t page = entity >> PAGE_BITS;
+    if (page >= pages.size()) pages.resize(page + 1);
+    Page& target = pages[page];
+    if (!target.slots)
+    {
+        target.slots = std::make_unique<std::uint32_t[]>(PAGE_SIZE);
+        std::fill_n(target.slots.get(), PAGE_SIZE, NONE);
+    }
+    target.slots[entity & (PAGE_SIZE - 1)] = static_cast<std::uint32_t>(entities.size());
+    target.count++;
+    entities.push_back(entity);
+    components.push_back(component);
+    componentOwners.push_back(owner);
+}
+
+void ComponentPool::set(Entity entity, std::shared_ptr<Component> component)
+{
+    Component* raw = component.get();
+    if (!raw)
+    {
+        erase(entity);
+        return;
+    }
+    set(entity, raw, addOwner(std::move(component)));
+}
+
+// Clears the slot of `entity` and frees its page once nothing is left on it.
+void ComponentPool::release(Entity entity)
+{
+    Page& page = pages[entity >> PAGE_BITS];
+    page.slots[entity & (PAGE_SIZE - 1)] = NONE;
+    if (--page.count == 0) page.slots.reset();
+}
+
+bool ComponentPool::erase(Entity entity)
+{
+    const std::uint32_t slot = slotOf(entity);
+    if (slot == NONE) return false;
+
+    releaseOwner(componentOwners[slot]);
+    const std::uint32_t last = static_cast<std::uint32_t>(entities.size() - 1);
+    if (slot != last)
+    {
+        entities[slot] = entities[last];
+        components[slot] = components[last];
+        componentOwners[slot] = componentOwners[last];
+        slotRef(entities[slot]) = slot;
+    }
+    entities.pop_back();
+    components.pop_back();
+    componentOwners.pop_back();
+    release(entity);
+    return true;
+}
+
+void ComponentPool::erase(std::span<const Entity> batch)
+{
+    // Swapping a few components out is cheaper than walking the pool.
+    if (batch.size() * 8 < entities.size())
+    {
+        for (Entity entity : batch) erase(entity);
+        return;
+    }
+    if (batch.empty()) return;
+
+    // One pass over the pool against a bitmap of the batch, which keeps
+    // the batch's random order away from the pool's arrays.
+    const auto [lowest, highest] = std::minmax_element(batch.begin(), batch.end());
+    const Entity first = *lowest;
+    std::vector<bool> erased(static_cast<std::size_t>(*highest - first) + 1, false);
+    for (Entity entity : batch) erased[entity - first] = true;
+
+    std::size_t kept = 0;
+    for (std::size_t slot = 0; slot < entities.size(); ++slot)
+    {
+        const Entity entity = entities[slot];
+        if (entity >= first && entity - first < erased.size() && erased[entity - first])
+        {
+            releaseOwner(componentOwners[slot]);
+            release(entity);
+            continue;
+        }
+        if (kept != slot)
+        {
+            entities[kept] = entity;
+            components[kept] = components[slot];
+            componentOwners[kept] = componentOwners[slot];
+            slotRef(entity) = static_cast<std::uint32_t>(kept);
+        }
+        kept++;
+    }
+    entities.resize(kept);
+    components.resize(kept);
+    componentOwners.resize(kept);
+}
+
+void ComponentPool::reserve(std::size_t count)
+{
+    entities.reserve(count);
+    components.reserve(count);
+    componentOwners.reserve(count);
+}
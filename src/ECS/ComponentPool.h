@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Component.h"
+#include "Entity.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+// The components of one type, as a sparse set: the components and their
+// entities are packed in parallel arrays, and a paged array indexed by
+// entity id holds each entity's slot in them. Lookups, inserts and erases
+// are a couple of array accesses, with no hashing and no per-component
+// allocation. Pages are allocated for the id ranges in use and released
+// once empty, so ids that only ever grow, as in a streamed level, do not
+// keep memory alive.
+//
+// Ownership is counted per owner, not per component: the components added
+// from one block share an owner holding the block, and erasing them only
+// decrements a plain counter until the last one releases it.
+class ComponentPool
+{
+public:
+    // nullptr if `entity` has no component here.
+    Component* find(Entity entity)
+    {
+        const std::uint32_t slot = slotOf(entity);
+        return slot != NONE ? components[slot] : nullptr;
+    }
+    const Component* find(Entity entity) const
+    {
+        const std::uint32_t slot = slotOf(entity);
+        return slot != NONE ? components[slot] : nullptr;
+    }
+    // find() that shares ownership of the component.
+    std::shared_ptr<Component> share(Entity entity) const;
+
+    // Registers storage for set(); it is released once no component added
+    // with it is left. An owner no component is added with is kept until
+    // the pool goes away.
+    std::uint32_t addOwner(std::shared_ptr<void> storage);
+    // Adds the component of `entity`, or replaces it. `component` lives in
+    // the storage of `owner` and is not null.
+    void set(Entity entity, Component* component, std::uint32_t owner);
+    // A null component erases the entity's.
+    void set(Entity entity, std::shared_ptr<Component> component);
+    bool erase(Entity entity);
+    // Same as erasing each in turn. Large batches are removed in one pass
+    // over the pool that keeps the order of the remaining components.
+    void erase(std::span<const Entity> batch);
+
+    void reserve(std::size_t count);
+    std::size_t size() const { return entities.size(); }
+    bool empty() const { return entities.empty(); }
+
+    // In insertion order, except that erase(Entity) moves the last
+    // component into the gap.
+    const std::vector<Entity>& getEntities() const { return entities; }
+    const std::vector<Component*>& getComponents() const { return components; }
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+    static constexpr unsigned PAGE_BITS = 12;
+    static constexpr std::size_t PAGE_SIZE = std::size_t(1) << PAGE_BITS;
+
+    struct Page
+    {
+        std::unique_ptr<std::uint32_t[]> slots;
+        std::uint32_t count = 0;
+    };
+
+    struct Owner
+    {
+        std::shared_ptr<void> storage;
+        std::uint32_t users = 0;
+    };
+
+    std::uint32_t slotOf(Entity entity) const
+    {
+        const std::size_t page = entity >> PAGE_BITS;
+        if (page >= pages.size() || !pages[page].slots) return NONE;
+        return pages[page].slots[entity & (PAGE_SIZE - 1)];
+    }
+    std::uint32_t& slotRef(Entity entity) { return pages[entity >> PAGE_BITS].slots[entity & (PAGE_SIZE - 1)]; }
+    void release(Entity entity);
+    void releaseOwner(std::uint32_t owner);
+
+    std::vector<Entity> entities;
+    std::vector<Component*> components;
+    std::vector<std::uint32_t> componentOwners;
+    std::vector<Page> pages;
+    std::vector<Owner> owners;
+    std::vector<std::uint32_t> freeOwners;
+};
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "Component.h"
+#include "Reflection.h"
+#include "../Physics.h"
+#include "../TimerWheel.h"
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <cmath>
+#include <cstdint>
 
 
 struct PositionComponent : public Component
@@ -23,7 +28,7 @@ struct VelocityComponent : public Component
     {
         if (speed == 0.0f && (vx != 0.0f || vy != 0.0f))
         {
-            speed = std::sqrt(vx * vx + vy * vy);
+            speed = static_cast<float>(Physics::length(Scalar(vx), Scalar(vy)));
         }
     }
 };
@@ -45,7 +50,7 @@ struct ShapeComponent : public Component
         struct { float radius; } circle;
     };
 
-    ShapeComponent(Type t, sf::Color c = sf::Color::White)
+    ShapeComponent(Type t = Type::Rectangle, sf::Color c = sf::Color::White)
         : type(t), color(c)
     {
         if (t == Type::Rectangle)
@@ -74,7 +79,10 @@ struct ColliderComponent : public Component
     float radius; 
     sf::Vector2f size; 
 
-    ColliderComponent(Type t, float r = 0.0f)
+    // Spatial index layer of colliders of type t.
+    static constexpr std::uint32_t layerOf(Type t) { return 1u << static_cast<std::uint32_t>(t); }
+
+    ColliderComponent(Type t = Type::Brick, float r = 0.0f)
         : type(t), radius(r), size(0.0f, 0.0f) {}
 
     ColliderComponent(Type t, float w, float h)
@@ -89,6 +97,14 @@ struct InputComponent : public Component
     float moveSpeed = 400.0f;
 };
 
+// Paddle cannons; they fire while fireRate (shots per second) is above 0.
+struct LaserComponent : public Component
+{
+    float fireRate = 0.0f;
+    // Seconds until the next shot.
+    float cooldown = 0.0f;
+};
+
 struct DurableBrick : public Component
 {
     int maxHits = 1;
@@ -111,12 +127,24 @@ struct DurableBrick : public Component
     }
 };
 
+// Hits every brick within `radius` of its center when destroyed.
+struct ExplosiveBrick : public Component
+{
+    // Far past any level's blasts; saves with larger radii are rejected.
+    static constexpr float MAX_RADIUS = 4096.0f;
+
+    float radius = 0.0f;
+
+    ExplosiveBrick(float r = 0.0f) : radius(r) {}
+};
+
 
 enum class BonusType
 {
     SlowBall,      
     FastPlatform,  
-    BigPlatform    
+    BigPlatform,
+    Laser
 };
 
 
@@ -128,13 +156,235 @@ struct BonusComponent : public Component
     BonusComponent(BonusType t = BonusType::SlowBall) : type(t) {}
 };
 
+constexpr bool isValidBonusType(BonusType type)
+{
+    return static_cast<unsigned>(type) <= static_cast<unsigned>(BonusType::Laser);
+}
+
 
-struct ActiveBonusComponent : public Component
+// Stats that bonuses can modify. The effective value of each is stored where
+// the systems already read it: VelocityComponent::speed, InputComponent::
+// moveSpeed, the rectangle width of ShapeComponent and ColliderComponent,
+// and LaserComponent::fireRate.
+enum class Stat : std::uint8_t
 {
-    BonusType type;
-    float remainingTime;
-    float originalValue; 
-    
-    ActiveBonusComponent(BonusType t, float time, float original = 0.0f)
-        : type(t), remainingTime(time), originalValue(original) {}
+    BallSpeed,
+    PaddleSpeed,
+    PaddleWidth,
+    LaserRate,
+};
+
+constexpr std::size_t STAT_COUNT = 4;
+
+struct StatModifier
+{
+    // Collecting the same bonus again refreshes its modifier.
+    BonusType source = BonusType::SlowBall;
+    Stat stat = Stat::BallSpeed;
+    float factor = 1.0f;
+    // Added to the base before the factors apply.
+    float offset = 0.0f;
+    // Kept in step with `expiry` only when saving; the timer is what counts.
+    float remainingTime = 0.0f;
+    // Saved, but stale after a load until the modifier is re-armed.
+    TimerHandle expiry;
+};
+
+// Base stat values and the modifiers active on them. Effective values are
+// (base + sum of offsets) times the product of the factors, recomputed by StatModifiers
+// whenever the list or a base changes.
+struct StatModifiersComponent : public Component
+{
+    static constexpr std::size_t MAX_MODIFIERS = 8;
+
+    std::array<float, STAT_COUNT> base{};
+    std::array<StatModifier, MAX_MODIFIERS> modifiers{};
+    std::uint8_t count = 0;
+
+    StatModifier* find(BonusType source)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (modifiers[i].source == source) return &modifiers[i];
+        }
+        return nullptr;
+    }
+
+    // Adds `modifier`, or replaces the one from the same source. Returns
+    // nullptr when the list is full.
+    StatModifier* set(const StatModifier& modifier)
+    {
+        StatModifier* slot = find(modifier.source);
+        if (!slot)
+        {
+            if (count == MAX_MODIFIERS) return nullptr;
+            slot = &modifiers[count++];
+        }
+        *slot = modifier;
+        return slot;
+    }
+
+    bool erase(BonusType source)
+    {
+        StatModifier* modifier = find(source);
+        if (!modifier) return false;
+        *modifier = modifiers[--count];
+        return true;
+    }
+
+    float factor(Stat stat) const
+    {
+        float product = 1.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (modifiers[i].stat == stat) product *= modifiers[i].factor;
+        }
+        return product;
+    }
+
+    float offset(Stat stat) const
+    {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (modifiers[i].stat == stat) sum += modifiers[i].offset;
+        }
+        return sum;
+    }
+};
+
+
+template<> struct ComponentFields<PositionComponent>
+{
+    static constexpr std::string_view name = "Position";
+    static constexpr auto fields = std::make_tuple(
+        field("position", &PositionComponent::position));
 };
+
+template<> struct ComponentFields<VelocityComponent>
+{
+    static constexpr std::string_view name = "Velocity";
+    static constexpr auto fields = std::make_tuple(
+        field("velocity", &VelocityComponent::velocity),
+        field("speed", &VelocityComponent::speed));
+};
+
+template<> struct ComponentFields<ShapeComponent>
+{
+    static constexpr std::string_view name = "Shape";
+    // `rectangle` is the larger union member, so it also carries circle.radius.
+    static constexpr auto fields = std::make_tuple(
+        field("type", &ShapeComponent::type),
+        field("color", &ShapeComponent::color),
+        field("extent", &ShapeComponent::rectangle));
+
+    static bool validate(const ShapeComponent& shape)
+    {
+        return shape.type == ShapeComponent::Type::Rectangle || shape.type == ShapeComponent::Type::Circle;
+    }
+};
+
+template<> struct ComponentFields<ColliderComponent>
+{
+    static constexpr std::string_view name = "Collider";
+    static constexpr auto fields = std::make_tuple(
+        field("type", &ColliderComponent::type),
+        field("radius", &ColliderComponent::radius),
+        field("size", &ColliderComponent::size));
+
+    static bool validate(const ColliderComponent& collider)
+    {
+        return static_cast<unsigned>(collider.type) <= static_cast<unsigned>(ColliderComponent::Type::Brick);
+    }
+};
+
+template<> struct ComponentFields<InputComponent>
+{
+    static constexpr std::string_view name = "Input";
+    static constexpr auto fields = std::make_tuple(
+        field("moveSpeed", &InputComponent::moveSpeed));
+};
+
+template<> struct ComponentFields<LaserComponent>
+{
+    static constexpr std::string_view name = "Laser";
+    static constexpr auto fields = std::make_tuple(
+        field("fireRate", &LaserComponent::fireRate),
+        field("cooldown", &LaserComponent::cooldown));
+};
+
+template<> struct ComponentFields<DurableBrick>
+{
+    static constexpr std::string_view name = "DurableBrick";
+    static constexpr auto fields = std::make_tuple(
+        field("maxHits", &DurableBrick::maxHits),
+        field("currentHits", &DurableBrick::currentHits));
+
+    // getHealthPercentage divides by maxHits.
+    static bool validate(const DurableBrick& brick)
+    {
+        return brick.maxHits >= 1 && brick.currentHits >= 0 && brick.currentHits <= brick.maxHits;
+    }
+};
+
+template<> struct ComponentFields<ExplosiveBrick>
+{
+    static constexpr std::string_view name = "ExplosiveBrick";
+    static constexpr auto fields = std::make_tuple(
+        field("radius", &ExplosiveBrick::radius));
+
+    // The radius reaches SpatialGrid::queryRadius, which turns it into cells.
+    static bool validate(const ExplosiveBrick& brick)
+    {
+        return std::isfinite(brick.radius) && brick.radius >= 0.0f && brick.radius <= ExplosiveBrick::MAX_RADIUS;
+    }
+};
+
+template<> struct ComponentFields<BonusComponent>
+{
+    static constexpr std::string_view name = "Bonus";
+    static constexpr auto fields = std::make_tuple(
+        field("type", &BonusComponent::type),
+        field("collected", &BonusComponent::collected));
+
+    static bool validate(const BonusComponent& bonus)
+    {
+        return isValidBonusType(bonus.type);
+    }
+};
+
+// Bases are not saved: they are derived from the saved stats on load.
+template<> struct ComponentFields<StatModifiersComponent>
+{
+    static constexpr std::string_view name = "StatModifiers";
+    static constexpr auto fields = std::make_tuple(
+        field("modifiers", &StatModifiersComponent::modifiers),
+        field("count", &StatModifiersComponent::count));
+
+    static bool validate(const StatModifiersComponent& modifiers)
+    {
+        if (modifiers.count > StatModifiersComponent::MAX_MODIFIERS) return false;
+        for (std::size_t i = 0; i < modifiers.count; ++i)
+        {
+            const StatModifier& modifier = modifiers.modifiers[i];
+            if (!isValidBonusType(modifier.source) || static_cast<std::size_t>(modifier.stat) >= STAT_COUNT)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Every component saved and loaded by WorldSerializer.
+using ReflectedComponents = ComponentList<
+    PositionComponent,
+    VelocityComponent,
+    ShapeComponent,
+    ColliderComponent,
+    InputComponent,
+    LaserComponent,
+    DurableBrick,
+    ExplosiveBrick,
+    BonusComponent,
+    StatModifiersComponent>;
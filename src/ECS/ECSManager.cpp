@@ -1,17 +1,35 @@
 #include "ECSManager.h"
 #include "System.h"
+#include <algorithm>
 
 Entity ECSManager::createEntity()
 {
     return nextEntity++;
 }
 
+Entity ECSManager::createEntities(std::size_t count)
+{
+    const Entity first = nextEntity;
+    nextEntity += static_cast<Entity>(count);
+    return first;
+}
+
 void ECSManager::destroyEntity(Entity entity)
 {
-    for (auto& compMap : components)
+    for (ComponentPool& pool : pools)
     {
-        compMap.second.erase(entity);
+        pool.erase(entity);
     }
+    spatialIndex.removeEntity(entity);
+}
+
+void ECSManager::destroyEntities(std::span<const Entity> entities)
+{
+    for (ComponentPool& pool : pools)
+    {
+        if (!pool.empty()) pool.erase(entities);
+    }
+    spatialIndex.removeEntities(entities);
 }
 
 bool ECSManager::isValid(Entity entity) const
@@ -19,6 +37,14 @@ bool ECSManager::isValid(Entity entity) const
     return entity != INVALID_ENTITY && entity < nextEntity;
 }
 
+void ECSManager::swapComponents(ECSManager& other)
+{
+    pools.swap(other.pools);
+    spatialIndex.begin();
+    other.spatialIndex.begin();
+    nextEntity = other.nextEntity = std::max(nextEntity, other.nextEntity);
+}
+
 void ECSManager::addSystem(std::shared_ptr<System> system)
 {
     systems.push_back(system);
@@ -2,91 +2,215 @@
 
 #include "Entity.h"
 #include "Component.h"
+#include "ComponentPool.h"
 #include "System.h"
-#include <unordered_map>
+#include "SpatialGrid.h"
+#include <atomic>
+#include <deque>
 #include <vector>
+#include <algorithm>
 #include <memory>
-#include <typeindex>
+#include <span>
 
 class ECSManager
 {
 public:
     
     Entity createEntity();
+    // Creates `count` consecutive entities and returns the first.
+    Entity createEntities(std::size_t count);
+    // Also drops the entity from the spatial index.
     void destroyEntity(Entity entity);
+    // Same as destroying each in turn, but visits every pool once.
+    void destroyEntities(std::span<const Entity> entities);
     bool isValid(Entity entity) const;
 
+    // Region queries over the spatial index: fn(entity) for every indexed
+    // entity whose box overlaps the region and shares a layer with
+    // `layers`. The index holds the boxes its owner last built
+    // (CollisionSystem rebuilds it every frame from the colliders).
+    template<typename Fn>
+    void queryAABB(sf::Vector2f min, sf::Vector2f max, Fn&& fn, std::uint32_t layers = SpatialGrid::ALL_LAYERS)
+    {
+        spatialIndex.query(min, max, layers, [&](std::uint32_t box) { fn(spatialIndex.getEntity(box)); });
+    }
+    template<typename Fn>
+    void queryRadius(sf::Vector2f center, float radius, Fn&& fn, std::uint32_t layers = SpatialGrid::ALL_LAYERS)
+    {
+        spatialIndex.queryRadius(center, radius, layers, [&](std::uint32_t box) { fn(spatialIndex.getEntity(box)); });
+    }
+    SpatialGrid& getSpatialIndex() { return spatialIndex; }
+
     
     template<typename T>
     void addComponent(Entity entity, std::shared_ptr<T> component)
     {
         static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
-        components[std::type_index(typeid(T))][entity] = component;
+        pool<T>().set(entity, std::move(component));
+    }
+
+    // Adds block[i] to entities[i]. The block stays one allocation that the
+    // components share, so bulk loads do not pay for a heap allocation per
+    // component.
+    template<typename T>
+    void addComponents(std::span<const Entity> entities, std::vector<T>&& block)
+    {
+        static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
+        if (entities.empty()) return;
+        auto storage = std::make_shared<std::vector<T>>(std::move(block));
+        ComponentPool& target = pool<T>();
+        const std::uint32_t owner = target.addOwner(storage);
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            target.set(entities[i], &(*storage)[i], owner);
+        }
     }
 
     template<typename T>
     void removeComponent(Entity entity)
     {
         static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
-        components[std::type_index(typeid(T))].erase(entity);
+        if (ComponentPool* found = findPool<T>()) found->erase(entity);
+    }
+
+    // Same as removing each in turn.
+    template<typename T>
+    void removeComponents(std::span<const Entity> entities)
+    {
+        static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
+        if (ComponentPool* found = findPool<T>()) found->erase(entities);
     }
 
     template<typename T>
     std::shared_ptr<T> getComponent(Entity entity)
     {
         static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
-        auto it = components[std::type_index(typeid(T))].find(entity);
-        if (it != components[std::type_index(typeid(T))].end())
-        {
-            return std::static_pointer_cast<T>(it->second);
-        }
-        return nullptr;
+        const ComponentPool* found = findPool<T>();
+        return found ? std::static_pointer_cast<T>(found->share(entity)) : nullptr;
     }
 
     template<typename T>
     std::shared_ptr<const T> getComponent(Entity entity) const
     {
         static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
-        auto it = components.find(std::type_index(typeid(T)));
-        if (it != components.end())
-        {
-            auto entityIt = it->second.find(entity);
-            if (entityIt != it->second.end())
-            {
-                return std::static_pointer_cast<const T>(entityIt->second);
-            }
-        }
-        return nullptr;
+        const ComponentPool* found = findPool<T>();
+        return found ? std::static_pointer_cast<const T>(found->share(entity)) : nullptr;
     }
 
+    // getComponent without the reference counting of a shared_ptr, for hot
+    // loops. The pointer is valid until the component is removed.
     template<typename T>
-    bool hasComponent(Entity entity)
+    T* findComponent(Entity entity)
     {
         static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
-        return components[std::type_index(typeid(T))].find(entity) != 
-               components[std::type_index(typeid(T))].end();
+        ComponentPool* found = findPool<T>();
+        return found ? static_cast<T*>(found->find(entity)) : nullptr;
     }
 
     template<typename T>
-    std::vector<Entity> getEntitiesWithComponent()
+    bool hasComponent(Entity entity)
+    {
+        static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
+        const ComponentPool* found = findPool<T>();
+        return found && found->find(entity);
+    }
+
+    template<typename T, typename Fn>
+    void forEachComponent(Fn&& fn) const
+    {
+        static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
+        const ComponentPool* found = findPool<T>();
+        if (!found) return;
+        const auto& entities = found->getEntities();
+        const auto& pooled = found->getComponents();
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            fn(entities[i], static_cast<const T&>(*pooled[i]));
+        }
+    }
+
+    template<typename T, typename Fn>
+    void forEachComponent(Fn&& fn)
     {
         static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
-        std::vector<Entity> entities;
-        auto& compMap = components[std::type_index(typeid(T))];
-        for (const auto& pair : compMap)
+        const ComponentPool* found = findPool<T>();
+        if (!found) return;
+        const auto& entities = found->getEntities();
+        const auto& pooled = found->getComponents();
+        for (std::size_t i = 0; i < entities.size(); ++i)
         {
-            entities.push_back(pair.first);
+            fn(entities[i], static_cast<T&>(*pooled[i]));
         }
-        return entities;
     }
 
+    template<typename T>
+    std::size_t getComponentCount() const
+    {
+        const ComponentPool* found = findPool<T>();
+        return found ? found->size() : 0;
+    }
+
+    template<typename T>
+    void reserveComponents(std::size_t count)
+    {
+        pool<T>().reserve(count);
+    }
+
+    template<typename T>
+    std::vector<Entity> getEntitiesWithComponent()
+    {
+        static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
+        const ComponentPool* found = findPool<T>();
+        return found ? found->getEntities() : std::vector<Entity>();
+    }
+
+    
+    // Exchanges all components with `other`; both keep issuing ids above
+    // either manager's entities.
+    void swapComponents(ECSManager& other);
+
     
     void addSystem(std::shared_ptr<System> system);
     void updateSystems(float deltaTime);
 
 private:
-    std::unordered_map<std::type_index, std::unordered_map<Entity, std::shared_ptr<Component>>> components;
+    // Index of T's pool in `pools`, the same in every manager.
+    template<typename T>
+    static std::size_t typeIndex()
+    {
+        static const std::size_t index = nextTypeIndex++;
+        return index;
+    }
+
+    template<typename T>
+    ComponentPool& pool()
+    {
+        const std::size_t index = typeIndex<T>();
+        if (index >= pools.size()) pools.resize(index + 1);
+        return pools[index];
+    }
+
+    template<typename T>
+    ComponentPool* findPool()
+    {
+        const std::size_t index = typeIndex<T>();
+        return index < pools.size() ? &pools[index] : nullptr;
+    }
+
+    template<typename T>
+    const ComponentPool* findPool() const
+    {
+        const std::size_t index = typeIndex<T>();
+        return index < pools.size() ? &pools[index] : nullptr;
+    }
+
+    static inline std::atomic<std::size_t> nextTypeIndex{0};
+
+    // A deque, so adding a pool leaves the others where they are for
+    // forEachComponent callbacks that add components of a new type.
+    std::deque<ComponentPool> pools;
     std::vector<std::shared_ptr<System>> systems;
+    SpatialGrid spatialIndex;
     Entity nextEntity = 1;
 };
 
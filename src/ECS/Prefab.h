@@ -0,0 +1,239 @@
+#pragma once
+
+#include "ECSManager.h"
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+class Prefab;
+
+// The components of one entity being instantiated from a prefab; get<T>()
+// returns this entity's copy of the template component, to be adjusted
+// before it is added to the ECS.
+class PrefabInstance
+{
+public:
+    template<typename T>
+    T& get();
+
+    std::size_t getIndex() const { return index; }
+
+private:
+    friend class Prefab;
+    struct Block
+    {
+        virtual ~Block() = default;
+        virtual void* element(std::size_t index) = 0;
+        virtual void commit(ECSManager& ecs, std::span<const Entity> entities) = 0;
+    };
+    struct BlockEntry
+    {
+        std::type_index type;
+        std::unique_ptr<Block> block;
+    };
+
+    explicit PrefabInstance(std::vector<BlockEntry>& blocks) : blocks(blocks) {}
+
+    std::vector<BlockEntry>& blocks;
+    std::size_t index = 0;
+};
+
+// A bundle of template components that new entities are cloned from, after
+// the Prototype pattern in diagrams/2.3. instantiate() copies every template
+// into one block per component type and hands the blocks to
+// ECSManager::addComponents, so N entities cost one allocation per component
+// type instead of one per component.
+class Prefab
+{
+public:
+    Prefab() = default;
+    Prefab(const Prefab& other);
+    Prefab& operator=(const Prefab& other);
+    Prefab(Prefab&&) noexcept = default;
+    Prefab& operator=(Prefab&&) noexcept = default;
+
+    // Adds or replaces the template component of type T.
+    template<typename T>
+    Prefab& with(const T& component);
+    template<typename T>
+    Prefab& without();
+
+    // nullptr if the prefab has no T.
+    template<typename T>
+    T* find();
+    template<typename T>
+    const T* find() const;
+
+    // Creates `count` consecutive entities and returns the first. init is
+    // called as init(PrefabInstance&) once per entity, in order.
+    template<typename InitFn>
+    Entity instantiate(ECSManager& ecs, std::size_t count, InitFn&& init) const;
+    Entity instantiate(ECSManager& ecs) const
+    {
+        return instantiate(ecs, 1, [](PrefabInstance&) {});
+    }
+
+private:
+    struct Template
+    {
+        virtual ~Template() = default;
+        virtual std::unique_ptr<Template> clone() const = 0;
+        virtual std::unique_ptr<PrefabInstance::Block> makeBlock(std::size_t count) const = 0;
+        virtual void* value() = 0;
+    };
+
+    template<typename T>
+    struct TypedTemplate : Template
+    {
+        explicit TypedTemplate(const T& component) : component(component) {}
+
+        std::unique_ptr<Template> clone() const override { return std::make_unique<TypedTemplate>(component); }
+        std::unique_ptr<PrefabInstance::Block> makeBlock(std::size_t count) const override;
+        void* value() override { return &component; }
+
+        T component;
+    };
+
+    template<typename T>
+    struct TypedBlock : PrefabInstance::Block
+    {
+        TypedBlock(std::size_t count, const T& component) : components(count, component) {}
+
+        void* element(std::size_t index) override { return &components[index]; }
+        void commit(ECSManager& ecs, std::span<const Entity> entities) override
+        {
+            ecs.addComponents(entities, std::move(components));
+        }
+
+        std::vector<T> components;
+    };
+
+    struct Entry
+    {
+        std::type_index type;
+        std::unique_ptr<Template> component;
+    };
+
+    Entry* findEntry(std::type_index type);
+    const Entry* findEntry(std::type_index type) const;
+
+    std::vector<Entry> templates;
+};
+
+template<typename T>
+T& PrefabInstance::get()
+{
+    for (BlockEntry& entry : blocks)
+    {
+        if (entry.type == std::type_index(typeid(T)))
+        {
+            return *static_cast<T*>(entry.block->element(index));
+        }
+    }
+    throw std::logic_error(std::string("Prefab has no component ") + typeid(T).name());
+}
+
+inline Prefab::Prefab(const Prefab& other)
+{
+    *this = other;
+}
+
+inline Prefab& Prefab::operator=(const Prefab& other)
+{
+    if (this == &other) return *this;
+    templates.clear();
+    templates.reserve(other.templates.size());
+    for (const Entry& entry : other.templates)
+    {
+        templates.push_back({entry.type, entry.component->clone()});
+    }
+    return *this;
+}
+
+inline Prefab::Entry* Prefab::findEntry(std::type_index type)
+{
+    for (Entry& entry : templates)
+    {
+        if (entry.type == type) return &entry;
+    }
+    return nullptr;
+}
+
+inline const Prefab::Entry* Prefab::findEntry(std::type_index type) const
+{
+    return const_cast<Prefab*>(this)->findEntry(type);
+}
+
+template<typename T>
+Prefab& Prefab::with(const T& component)
+{
+    static_assert(std::is_base_of_v<Component, T>, "T must inherit from Component");
+    if (Entry* entry = findEntry(std::type_index(typeid(T))))
+    {
+        entry->component = std::make_unique<TypedTemplate<T>>(component);
+    }
+    else
+    {
+        templates.push_back({std::type_index(typeid(T)), std::make_unique<TypedTemplate<T>>(component)});
+    }
+    return *this;
+}
+
+template<typename T>
+Prefab& Prefab::without()
+{
+    std::erase_if(templates, [](const Entry& entry) { return entry.type == std::type_index(typeid(T)); });
+    return *this;
+}
+
+template<typename T>
+T* Prefab::find()
+{
+    Entry* entry = findEntry(std::type_index(typeid(T)));
+    return entry ? static_cast<T*>(entry->component->value()) : nullptr;
+}
+
+template<typename T>
+const T* Prefab::find() const
+{
+    return const_cast<Prefab*>(this)->find<T>();
+}
+
+template<typename T>
+std::unique_ptr<PrefabInstance::Block> Prefab::TypedTemplate<T>::makeBlock(std::size_t count) const
+{
+    return std::make_unique<TypedBlock<T>>(count, component);
+}
+
+template<typename InitFn>
+Entity Prefab::instantiate(ECSManager& ecs, std::size_t count, InitFn&& init) const
+{
+    std::vector<PrefabInstance::BlockEntry> blocks;
+    blocks.reserve(templates.size());
+    for (const Entry& entry : templates)
+    {
+        blocks.push_back({entry.type, entry.component->makeBlock(count)});
+    }
+
+    PrefabInstance instance(blocks);
+    for (; instance.index < count; ++instance.index)
+    {
+        init(instance);
+    }
+
+    const Entity first = ecs.createEntities(count);
+    std::vector<Entity> entities(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        entities[i] = first + static_cast<Entity>(i);
+    }
+    for (PrefabInstance::BlockEntry& entry : blocks)
+    {
+        entry.block->commit(ecs, entities);
+    }
+    return first;
+}
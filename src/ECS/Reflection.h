@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Compile-time component reflection. A component becomes serializable by
+// specializing ComponentFields<T> next to its definition:
+//
+//   template<> struct ComponentFields<PositionComponent> {
+//       static constexpr std::string_view name = "Position";
+//       static constexpr auto fields = std::make_tuple(field("position", &PositionComponent::position));
+//   };
+//
+// and listing it in ReflectedComponents (Components.h). It may also define
+//
+//   static bool validate(const PositionComponent& component);
+//
+// to reject loaded values the game cannot run with; WorldSerializer::
+// validateWorld() calls it on every component of that type.
+
+template<typename Owner, typename Member>
+struct ComponentField
+{
+    std::string_view name;
+    Member Owner::* pointer;
+
+    using Type = Member;
+};
+
+template<typename Owner, typename Member>
+constexpr ComponentField<Owner, Member> field(std::string_view name, Member Owner::* pointer)
+{
+    return {name, pointer};
+}
+
+template<typename T>
+struct ComponentFields;
+
+template<typename T>
+concept ReflectedComponent = requires {
+    { ComponentFields<T>::name } -> std::convertible_to<std::string_view>;
+    ComponentFields<T>::fields;
+};
+
+template<typename T>
+concept ValidatedComponent = requires(const T& component) {
+    { ComponentFields<T>::validate(component) } -> std::convertible_to<bool>;
+};
+
+template<typename... Ts>
+struct ComponentList {};
+
+
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(std::vector<std::byte>& out) : out(out) {}
+
+    void writeBytes(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::byte*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+    template<typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeString(std::string_view value)
+    {
+        write(static_cast<std::uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+    // Reserves space for a value that is patched later with patch().
+    std::size_t reserve(std::size_t size)
+    {
+        std::size_t offset = out.size();
+        out.resize(out.size() + size);
+        return offset;
+    }
+
+    template<typename T>
+    void patch(std::size_t offset, const T& value)
+    {
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    std::size_t size() const { return out.size(); }
+
+private:
+    std::vector<std::byte>& out;
+};
+
+// Bounds-checked reader; every read returns false instead of overrunning.
+class BinaryReader
+{
+public:
+    explicit BinaryReader(std::span<const std::byte> data) : data(data) {}
+
+    bool readBytes(void* destination, std::size_t size)
+    {
+        if (size > remaining()) return false;
+        std::memcpy(destination, data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+
+    template<typename T>
+    bool read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return readBytes(&value, sizeof(T));
+    }
+
+    bool readString(std::string& value)
+    {
+        std::uint32_t length = 0;
+        if (!read(length) || length > remaining()) return false;
+        value.assign(reinterpret_cast<const char*>(data.data() + offset), length);
+        offset += length;
+        return true;
+    }
+
+    // Returns a view of the next `size` bytes without copying them.
+    bool view(std::size_t size, std::span<const std::byte>& result)
+    {
+        if (size > remaining()) return false;
+        result = data.subspan(offset, size);
+        offset += size;
+        return true;
+    }
+
+    std::size_t remaining() const { return data.size() - offset; }
+
+private:
+    std::span<const std::byte> data;
+    std::size_t offset = 0;
+};
+
+// Per-field encoding. Trivially copyable members are stored as fixed-size
+// columns and copied with memcpy; other member types specialize FieldCodec.
+template<typename T>
+struct FieldCodec
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Specialize FieldCodec for non-trivially-copyable fields");
+};
+
+template<>
+struct FieldCodec<std::string>
+{
+    static void write(BinaryWriter& writer, const std::string& value) { writer.writeString(value); }
+    static bool read(BinaryReader& reader, std::string& value) { return reader.readString(value); }
+};
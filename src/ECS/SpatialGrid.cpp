@@ -0,0 +1,160 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : baseCellSize(cellSize), cellSize(cellSize), inverseCellSize(1.0f / cellSize)
+{
+}
+
+void SpatialGrid::begin()
+{
+    boxes.clear();
+    entityTable.clear();
+    columns = 0;
+    rows = 0;
+}
+
+std::uint32_t SpatialGrid::add(Entity entity, sf::Vector2f position, sf::Vector2f size, std::uint32_t layers)
+{
+    boxes.push_back({entity, layers, position.x, position.y, position.x + size.x, position.y + size.y, true});
+    return static_cast<std::uint32_t>(boxes.size() - 1);
+}
+
+namespace
+{
+std::size_t hashEntity(Entity entity)
+{
+    return static_cast<std::size_t>(entity * 0x9E3779B1u);
+}
+}
+
+void SpatialGrid::build()
+{
+    std::size_t tableSize = 16;
+    while (tableSize < boxes.size() * 2) tableSize *= 2;
+    entityTable.assign(tableSize, NONE);
+    for (std::uint32_t index = 0; index < boxes.size(); ++index)
+    {
+        std::size_t slot = hashEntity(boxes[index].entity) & (tableSize - 1);
+        while (entityTable[slot] != NONE) slot = (slot + 1) & (tableSize - 1);
+        entityTable[slot] = index;
+    }
+
+    if (boxes.empty()) return;
+
+    float left = std::numeric_limits<float>::max();
+    float top = std::numeric_limits<float>::max();
+    float right = std::numeric_limits<float>::lowest();
+    float bottom = std::numeric_limits<float>::lowest();
+    for (const Box& box : boxes)
+    {
+        left = std::min(left, box.left);
+        top = std::min(top, box.top);
+        right = std::max(right, box.right);
+        bottom = std::max(bottom, box.bottom);
+    }
+
+    cellSize = baseCellSize;
+    while (true)
+    {
+        const double cells = std::ceil((right - left) / cellSize + 1.0) * std::ceil((bottom - top) / cellSize + 1.0);
+        if (cells <= static_cast<double>(MAX_CELLS)) break;
+        cellSize *= 2.0f;
+    }
+    inverseCellSize = 1.0f / cellSize;
+    originX = left;
+    originY = top;
+    columns = static_cast<int>((right - left) * inverseCellSize) + 1;
+    rows = static_cast<int>((bottom - top) * inverseCellSize) + 1;
+
+    // Counting sort of the boxes into cells; cellStart[c + 1] counts cell c
+    // first and becomes its end offset.
+    const std::size_t cellCount = static_cast<std::size_t>(columns) * rows;
+    cellStart.assign(cellCount + 1, 0);
+    for (const Box& box : boxes)
+    {
+        for (int row = rowOf(box.top); row <= rowOf(box.bottom); ++row)
+        {
+            for (int column = columnOf(box.left); column <= columnOf(box.right); ++column)
+            {
+                cellStart[static_cast<std::size_t>(row) * columns + column + 1]++;
+            }
+        }
+    }
+    for (std::size_t cell = 0; cell < cellCount; ++cell)
+    {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+
+    cellBoxes.resize(cellStart[cellCount]);
+    std::vector<std::uint32_t>& next = stamps;
+    next.assign(cellStart.begin(), cellStart.end() - 1);
+    for (std::uint32_t index = 0; index < boxes.size(); ++index)
+    {
+        const Box& box = boxes[index];
+        for (int row = rowOf(box.top); row <= rowOf(box.bottom); ++row)
+        {
+            for (int column = columnOf(box.left); column <= columnOf(box.right); ++column)
+            {
+                cellBoxes[next[static_cast<std::size_t>(row) * columns + column]++] = index;
+            }
+        }
+    }
+
+    cellEnd.assign(cellStart.begin() + 1, cellStart.end());
+    stamps.assign(boxes.size(), 0);
+    stamp = 0;
+}
+
+std::uint32_t SpatialGrid::find(Entity entity) const
+{
+    if (entityTable.empty()) return NONE;
+    const std::size_t mask = entityTable.size() - 1;
+    for (std::size_t slot = hashEntity(entity) & mask; entityTable[slot] != NONE; slot = (slot + 1) & mask)
+    {
+        if (boxes[entityTable[slot]].entity == entity) return entityTable[slot];
+    }
+    return NONE;
+}
+
+void SpatialGrid::removeEntity(Entity entity)
+{
+    const std::uint32_t index = find(entity);
+    if (index != NONE) remove(index);
+}
+
+void SpatialGrid::removeEntities(std::span<const Entity> entities)
+{
+    // A table lookup per entity costs more than one pass over the boxes
+    // once the batch is a sizeable share of them.
+    if (entities.size() * 8 < boxes.size())
+    {
+        for (Entity entity : entities) removeEntity(entity);
+        return;
+    }
+    if (entities.empty()) return;
+
+    const auto [lowest, highest] = std::minmax_element(entities.begin(), entities.end());
+    const Entity first = *lowest;
+    removing.assign(static_cast<std::size_t>(*highest - first) + 1, false);
+    for (Entity entity : entities) removing[entity - first] = true;
+    for (Box& box : boxes)
+    {
+        if (box.entity >= first && box.entity - first < removing.size() && removing[box.entity - first])
+        {
+            box.alive = false;
+        }
+    }
+}
+
+std::uint32_t SpatialGrid::nextStamp()
+{
+    if (++stamp == 0)
+    {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        stamp = 1;
+    }
+    return stamp;
+}
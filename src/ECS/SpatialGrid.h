@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Entity.h"
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Uniform grid of axis-aligned boxes for broadphase tests, rebuilt from
+// scratch whenever the boxes move: begin(), add() each box, then build().
+// Storage is kept between builds, so rebuilding a grid of about the same
+// size allocates nothing.
+//
+// Each box carries a layer mask; queries only report boxes sharing a bit
+// with the mask they are given.
+class SpatialGrid
+{
+public:
+    static constexpr std::uint32_t ALL_LAYERS = UINT32_MAX;
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+    // The cell size grows for a build whose boxes would need more cells.
+    static constexpr std::size_t MAX_CELLS = 1 << 18;
+
+    explicit SpatialGrid(float cellSize = 64.0f);
+
+    // Takes effect at the next build().
+    void setCellSize(float size) { baseCellSize = size; }
+
+    // Empties the grid and starts a new build.
+    void begin();
+    // Returns the box index, which stays valid until the next begin(). An
+    // entity has at most one box.
+    std::uint32_t add(Entity entity, sf::Vector2f position, sf::Vector2f size, std::uint32_t layers = 1);
+    void build();
+
+    // Calls fn(index) once for every live box overlapping [min, max), in
+    // cell order. Removed boxes are dropped from the cells it visits, so a
+    // chain of queries over a shrinking region does not rescan them.
+    template<typename Fn>
+    void query(sf::Vector2f min, sf::Vector2f max, std::uint32_t layers, Fn&& fn);
+    // Calls fn(index) for every live box within `radius` of `center`.
+    template<typename Fn>
+    void queryRadius(sf::Vector2f center, float radius, std::uint32_t layers, Fn&& fn);
+
+    // Removed boxes are skipped by later queries.
+    void remove(std::uint32_t index) { boxes[index].alive = false; }
+    void removeEntity(Entity entity);
+    // Same as removing each in turn.
+    void removeEntities(std::span<const Entity> entities);
+    // The box of `entity`, or NONE.
+    std::uint32_t find(Entity entity) const;
+
+    bool isAlive(std::uint32_t index) const { return boxes[index].alive; }
+    Entity getEntity(std::uint32_t index) const { return boxes[index].entity; }
+    std::uint32_t getLayers(std::uint32_t index) const { return boxes[index].layers; }
+    sf::Vector2f getPosition(std::uint32_t index) const { return {boxes[index].left, boxes[index].top}; }
+    sf::Vector2f getSize(std::uint32_t index) const
+    {
+        return {boxes[index].right - boxes[index].left, boxes[index].bottom - boxes[index].top};
+    }
+    std::size_t size() const { return boxes.size(); }
+
+private:
+    struct Box
+    {
+        Entity entity;
+        std::uint32_t layers;
+        float left;
+        float top;
+        float right;
+        float bottom;
+        bool alive;
+    };
+
+    // Inline: every query starts with four of these.
+    int columnOf(float x) const
+    {
+        const float column = std::floor((x - originX) * inverseCellSize);
+        return static_cast<int>(std::clamp(column, 0.0f, static_cast<float>(columns - 1)));
+    }
+    int rowOf(float y) const
+    {
+        const float row = std::floor((y - originY) * inverseCellSize);
+        return static_cast<int>(std::clamp(row, 0.0f, static_cast<float>(rows - 1)));
+    }
+    std::uint32_t nextStamp();
+
+    float baseCellSize;
+    float cellSize;
+    float inverseCellSize;
+    float originX = 0.0f;
+    float originY = 0.0f;
+    int columns = 0;
+    int rows = 0;
+
+    std::vector<Box> boxes;
+    // Cell c holds cellBoxes[cellStart[c], cellEnd[c]); cellEnd[c] starts
+    // at cellStart[c + 1] and shrinks as queries drop removed boxes.
+    std::vector<std::uint32_t> cellStart;
+    std::vector<std::uint32_t> cellEnd;
+    std::vector<std::uint32_t> cellBoxes;
+    // Last query that reported each box, so boxes spanning several cells
+    // are reported once.
+    std::vector<std::uint32_t> stamps;
+    std::uint32_t stamp = 0;
+    // Open-addressed entity -> box table, a power of two at least twice the
+    // box count.
+    std::vector<std::uint32_t> entityTable;
+    // Scratch for removeEntities(): marks the batch by entity id.
+    std::vector<bool> removing;
+};
+
+template<typename Fn>
+void SpatialGrid::query(sf::Vector2f min, sf::Vector2f max, std::uint32_t layers, Fn&& fn)
+{
+    if (columns == 0 || rows == 0) return;
+
+    const int firstColumn = columnOf(min.x);
+    const int lastColumn = columnOf(max.x);
+    const int firstRow = rowOf(min.y);
+    const int lastRow = rowOf(max.y);
+    const std::uint32_t current = nextStamp();
+
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+        for (int column = firstColumn; column <= lastColumn; ++column)
+        {
+            const std::size_t cell = static_cast<std::size_t>(row) * columns + column;
+            std::uint32_t kept = cellStart[cell];
+            for (std::uint32_t i = kept; i < cellEnd[cell]; ++i)
+            {
+                const std::uint32_t index = cellBoxes[i];
+                const Box& box = boxes[index];
+                if (!box.alive) continue;
+                cellBoxes[kept++] = index;
+                if (!(box.layers & layers) || stamps[index] == current) continue;
+                stamps[index] = current;
+                if (box.right > min.x && box.left < max.x && box.bottom > min.y && box.top < max.y)
+                {
+                    fn(index);
+                }
+            }
+            cellEnd[cell] = kept;
+        }
+    }
+}
+
+template<typename Fn>
+void SpatialGrid::queryRadius(sf::Vector2f center, float radius, std::uint32_t layers, Fn&& fn)
+{
+    const float radiusSquared = radius * radius;
+    query(center - sf::Vector2f(radius, radius), center + sf::Vector2f(radius, radius), layers,
+          [&](std::uint32_t index) {
+              const Box& box = boxes[index];
+              const float dx = center.x < box.left ? box.left - center.x : center.x > box.right ? center.x - box.right : 0.0f;
+              const float dy = center.y < box.top ? box.top - center.y : center.y > box.bottom ? center.y - box.bottom : 0.0f;
+              if (dx * dx + dy * dy <= radiusSquared) fn(index);
+          });
+}
@@ -0,0 +1,141 @@
+#include "StatModifiers.h"
+#include "ECSManager.h"
+#include "../GameState.h"
+#include "../Physics.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+float StatModifiers::read(const ECSManager& ecs, Entity entity, Stat stat)
+{
+    switch (stat)
+    {
+        case Stat::BallSpeed:
+            if (auto velocity = ecs.getComponent<VelocityComponent>(entity)) return velocity->speed;
+            break;
+        case Stat::PaddleSpeed:
+            if (auto input = ecs.getComponent<InputComponent>(entity)) return input->moveSpeed;
+            break;
+        case Stat::PaddleWidth:
+            if (auto shape = ecs.getComponent<ShapeComponent>(entity);
+                shape && shape->type == ShapeComponent::Type::Rectangle)
+            {
+                return shape->rectangle.width;
+            }
+            break;
+        case Stat::LaserRate:
+            if (auto laser = ecs.getComponent<LaserComponent>(entity)) return laser->fireRate;
+            break;
+    }
+    return 0.0f;
+}
+
+void StatModifiers::write(ECSManager& ecs, Entity entity, Stat stat, float value)
+{
+    switch (stat)
+    {
+        case Stat::BallSpeed:
+            if (auto velocity = ecs.getComponent<VelocityComponent>(entity))
+            {
+                velocity->speed = value;
+                Scalar vx(velocity->velocity.x);
+                Scalar vy(velocity->velocity.y);
+                Physics::setSpeed(vx, vy, Scalar(value));
+                velocity->velocity = {static_cast<float>(vx), static_cast<float>(vy)};
+            }
+            break;
+        case Stat::PaddleSpeed:
+            if (auto input = ecs.getComponent<InputComponent>(entity)) input->moveSpeed = value;
+            break;
+        case Stat::PaddleWidth:
+        {
+            auto shape = ecs.getComponent<ShapeComponent>(entity);
+            if (!shape || shape->type != ShapeComponent::Type::Rectangle) break;
+            shape->rectangle.width = value;
+            if (auto collider = ecs.getComponent<ColliderComponent>(entity)) collider->size.x = value;
+
+            // Keep the resized paddle inside the window.
+            if (auto position = ecs.getComponent<PositionComponent>(entity))
+            {
+                const float maxX = static_cast<float>(GAME_STATE.WINDOW_WIDTH) - value;
+                position->position.x = std::max(0.0f, std::min(position->position.x, maxX));
+            }
+            break;
+        }
+        case Stat::LaserRate:
+            if (auto laser = ecs.getComponent<LaserComponent>(entity)) laser->fireRate = value;
+            break;
+    }
+}
+
+void StatModifiers::recompute(ECSManager& ecs, Entity entity, StatModifiersComponent& modifiers)
+{
+    for (std::size_t stat = 0; stat < STAT_COUNT; ++stat)
+    {
+        const Stat id = static_cast<Stat>(stat);
+        const float effective = (modifiers.base[stat] + modifiers.offset(id)) * modifiers.factor(id);
+        if (effective != read(ecs, entity, id)) write(ecs, entity, id, effective);
+    }
+}
+
+StatModifier* StatModifiers::add(ECSManager& ecs, Entity entity, const StatModifier& modifier)
+{
+    auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+    if (!modifiers)
+    {
+        modifiers = std::make_shared<StatModifiersComponent>();
+        for (std::size_t stat = 0; stat < STAT_COUNT; ++stat)
+        {
+            modifiers->base[stat] = read(ecs, entity, static_cast<Stat>(stat));
+        }
+        ecs.addComponent<StatModifiersComponent>(entity, modifiers);
+    }
+
+    StatModifier* added = modifiers->set(modifier);
+    if (!added)
+    {
+        std::cerr << "Too many stat modifiers on entity " << entity << std::endl;
+        return nullptr;
+    }
+    recompute(ecs, entity, *modifiers);
+    return added;
+}
+
+bool StatModifiers::remove(ECSManager& ecs, Entity entity, BonusType source)
+{
+    auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+    if (!modifiers || !modifiers->erase(source)) return false;
+    recompute(ecs, entity, *modifiers);
+    return true;
+}
+
+void StatModifiers::setBase(ECSManager& ecs, Entity entity, Stat stat, float value)
+{
+    auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+    if (!modifiers)
+    {
+        write(ecs, entity, stat, value);
+        return;
+    }
+    modifiers->base[static_cast<std::size_t>(stat)] = value;
+    recompute(ecs, entity, *modifiers);
+}
+
+void StatModifiers::restore(ECSManager& ecs, Entity entity)
+{
+    auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+    if (!modifiers) return;
+
+    modifiers->count = std::min<std::uint8_t>(modifiers->count, StatModifiersComponent::MAX_MODIFIERS);
+    for (std::size_t i = 0; i < modifiers->count; ++i)
+    {
+        modifiers->modifiers[i].expiry = TimerHandle{};
+    }
+    for (std::size_t stat = 0; stat < STAT_COUNT; ++stat)
+    {
+        const Stat id = static_cast<Stat>(stat);
+        const float factor = modifiers->factor(id);
+        const float value = factor != 0.0f ? read(ecs, entity, id) / factor : read(ecs, entity, id);
+        modifiers->base[stat] = value - modifiers->offset(id);
+    }
+}
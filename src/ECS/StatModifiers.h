@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Components.h"
+#include "Entity.h"
+
+class ECSManager;
+
+// Reads and writes the stats in Stat through their StatModifiersComponent.
+// Effective values are only recomputed here, when a modifier or base
+// changes; the systems keep reading the cached result from the components
+// that hold each stat.
+class StatModifiers
+{
+public:
+    // Adds or refreshes a modifier, creating the entity's component from its
+    // current stats if needed. Returns nullptr when its list is full.
+    static StatModifier* add(ECSManager& ecs, Entity entity, const StatModifier& modifier);
+    static bool remove(ECSManager& ecs, Entity entity, BonusType source);
+    // Sets the unmodified value of a stat, e.g. after a speed-up.
+    static void setBase(ECSManager& ecs, Entity entity, Stat stat, float value);
+
+    // After a load: derives each base from the saved effective value and
+    // drops the expiry handles, which belong to the session that saved.
+    static void restore(ECSManager& ecs, Entity entity);
+
+    static float read(const ECSManager& ecs, Entity entity, Stat stat);
+
+private:
+    static void write(ECSManager& ecs, Entity entity, Stat stat, float value);
+    static void recompute(ECSManager& ecs, Entity entity, StatModifiersComponent& modifiers);
+};
@@ -1,18 +1,96 @@
 #include "BallSpeedSystem.h"
 #include "../ECSManager.h"
+#include "../StatModifiers.h"
 #include "../../GameState.h"
+#include "../../Physics.h"
+#include <algorithm>
 
 BallSpeedSystem::BallSpeedSystem()
 {
     reset();
 }
 
+void BallSpeedSystem::setTimers(TimerWheel* timerWheel)
+{
+    reset();
+    timers = timerWheel;
+}
+
 void BallSpeedSystem::update(float deltaTime, ECSManager& ecs)
 {
-    
-    gameTime += deltaTime;
+    if (!timers)
+        return;
+
+    if (initialized)
+        return;
+
+    initialized = true;
+    const TimerWheel::Tick interval = timers->toTicks(GAME_STATE.BALL_SPEED_INCREASE_INTERVAL);
+    if (slowed)
+    {
+        heldTicks = interval;
+        held = true;
+    }
+    else
+    {
+        scheduleIncrease(ecs, interval);
+    }
+}
+
+void BallSpeedSystem::updateHold(ECSManager& ecs, Entity entity)
+{
+    auto collider = ecs.getComponent<ColliderComponent>(entity);
+    if (!collider || collider->type != ColliderComponent::Type::Ball)
+        return;
+
+    auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+    const bool slowedNow = modifiers && modifiers->factor(Stat::BallSpeed) < 1.0f;
+    if (slowedNow == slowed)
+        return;
+
+    slowed = slowedNow;
+    // Before the first update the timer starts held or running from `slowed`.
+    if (!timers || !initialized)
+        return;
+    if (slowed)
+        holdTimer();
+    else
+        releaseTimer(ecs);
+}
+
+void BallSpeedSystem::holdTimer()
+{
+    if (held || !timers->isPending(increase))
+        return;
+    heldTicks = timers->remaining(increase);
+    timers->cancel(increase);
+    held = true;
+}
 
+void BallSpeedSystem::releaseTimer(ECSManager& ecs)
+{
+    if (!held)
+        return;
+    held = false;
+    scheduleIncrease(ecs, heldTicks);
+}
+
+void BallSpeedSystem::scheduleIncrease(ECSManager& ecs, TimerWheel::Tick delay)
+{
+    increase = timers->schedule(delay, [this, &ecs] { increaseSpeed(ecs); });
+}
+
+void BallSpeedSystem::increaseSpeed(ECSManager& ecs)
+{
     
+    Scalar multiplier(speedMultiplier);
+    if (!Physics::increaseMultiplier(multiplier, Scalar(GAME_STATE.BALL_SPEED_MULTIPLIER),
+                                     Scalar(GAME_STATE.BALL_MAX_SPEED_MULTIPLIER)))
+        return;
+
+    speedMultiplier = static_cast<float>(multiplier);
+    scheduleIncrease(ecs, timers->toTicks(GAME_STATE.BALL_SPEED_INCREASE_INTERVAL));
+
     auto entities = ecs.getEntitiesWithComponent<ColliderComponent>();
 
     for (Entity entity : entities)
@@ -21,64 +99,34 @@ void BallSpeedSystem::update(float deltaTime, ECSManager& ecs)
         if (!collider || collider->type != ColliderComponent::Type::Ball)
             continue;
 
-        auto velocity = ecs.getComponent<VelocityComponent>(entity);
-        if (!velocity)
-            continue;
-
-        
-        if (!initialized)
-        {
-            initialized = true;
-            
-            speedMultiplier = 1.0f;
-            lastSpeedIncreaseTime = gameTime;
-        }
-
-        
-        auto activeBonus = ecs.getComponent<ActiveBonusComponent>(entity);
-        bool hasSlowBall = (activeBonus && activeBonus->type == BonusType::SlowBall);
-        
         
-        if (hasSlowBall)
-        {
-            lastSpeedIncreaseTime += deltaTime;
-        }
+        const Scalar newSpeed = Physics::length(Scalar(GAME_STATE.BALL_INITIAL_VELOCITY_X),
+                                                Scalar(GAME_STATE.BALL_INITIAL_VELOCITY_Y)) * multiplier;
+        StatModifiers::setBase(ecs, entity, Stat::BallSpeed, static_cast<float>(newSpeed));
+    }
+}
 
-        
-        if (!hasSlowBall && gameTime - lastSpeedIncreaseTime >= GAME_STATE.BALL_SPEED_INCREASE_INTERVAL)
-        {
-            
-            float newMultiplier = speedMultiplier * GAME_STATE.BALL_SPEED_MULTIPLIER;
-
-            
-            if (newMultiplier <= GAME_STATE.BALL_MAX_SPEED_MULTIPLIER)
-            {
-                speedMultiplier = newMultiplier;
-                lastSpeedIncreaseTime = gameTime;
-
-                
-                float currentSpeed = std::sqrt(velocity->velocity.x * velocity->velocity.x +
-                                             velocity->velocity.y * velocity->velocity.y);
-
-                if (currentSpeed > 0)
-                {
-                    
-                    float newSpeed = std::sqrt(GAME_STATE.BALL_INITIAL_VELOCITY_X * GAME_STATE.BALL_INITIAL_VELOCITY_X +
-                                             GAME_STATE.BALL_INITIAL_VELOCITY_Y * GAME_STATE.BALL_INITIAL_VELOCITY_Y) * speedMultiplier;
-
-                    velocity->velocity.x = (velocity->velocity.x / currentSpeed) * newSpeed;
-                    velocity->velocity.y = (velocity->velocity.y / currentSpeed) * newSpeed;
-                    velocity->speed = newSpeed;
-                }
-            }
-        }
+void BallSpeedSystem::restoreMultiplier(const ECSManager& ecs, Entity ball)
+{
+    auto modifiers = ecs.getComponent<StatModifiersComponent>(ball);
+    const float speed = modifiers ? modifiers->base[static_cast<std::size_t>(Stat::BallSpeed)]
+                                  : StatModifiers::read(ecs, ball, Stat::BallSpeed);
+    const Scalar initialSpeed = Physics::length(Scalar(GAME_STATE.BALL_INITIAL_VELOCITY_X),
+                                                Scalar(GAME_STATE.BALL_INITIAL_VELOCITY_Y));
+    if (speed > 0.0f && initialSpeed > Scalar(0.0f))
+    {
+        speedMultiplier = std::clamp(static_cast<float>(Scalar(speed) / initialSpeed), 1.0f,
+                                     GAME_STATE.BALL_MAX_SPEED_MULTIPLIER);
     }
 }
 
 void BallSpeedSystem::reset()
 {
-    gameTime = 0.0f;
-    lastSpeedIncreaseTime = 0.0f;
+    if (timers)
+        timers->cancel(increase);
+    heldTicks = 0;
+    held = false;
+    slowed = false;
     speedMultiplier = 1.0f;
     initialized = false;
 }
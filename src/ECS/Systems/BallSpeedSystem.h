@@ -2,22 +2,40 @@
 
 #include "../System.h"
 #include "../Components.h"
+#include "../../TimerWheel.h"
 
+// Speeds the ball up every BALL_SPEED_INCREASE_INTERVAL seconds of play
+// through a timer; a modifier that slows the ball holds the timer where it
+// is until it expires. CollisionSystem reports those modifiers as they come
+// and go through updateHold().
 class BallSpeedSystem : public System
 {
 public:
     BallSpeedSystem();
     
+    void setTimers(TimerWheel* timerWheel);
     void update(float deltaTime, ECSManager& ecs) override;
     
-    void setGameTime(float time) { gameTime = time; }
-    float getGameTime() const { return gameTime; }
-    
     void reset();
+    // Holds the speed-up timer while the modifiers of `entity`, if it is the
+    // ball, slow it, and releases it once they no longer do.
+    void updateHold(ECSManager& ecs, Entity entity);
+    // After a load: derives the speed-up multiplier from the unmodified speed
+    // of `ball`, so the next speed-up continues from the saved game's.
+    void restoreMultiplier(const ECSManager& ecs, Entity ball);
 
 private:
-    float gameTime = 0.0f;
-    float lastSpeedIncreaseTime = 0.0f;
+    void increaseSpeed(ECSManager& ecs);
+    void holdTimer();
+    void releaseTimer(ECSManager& ecs);
+    void scheduleIncrease(ECSManager& ecs, TimerWheel::Tick delay);
+
+    TimerWheel* timers = nullptr;
+    TimerHandle increase;
+    // Ticks left on the increase timer while it is held.
+    TimerWheel::Tick heldTicks = 0;
+    bool held = false;
+    bool slowed = false;
     float speedMultiplier = 1.0f;
     bool initialized = false;
 };
@@ -2,129 +2,117 @@
 #include "../ECSManager.h"
 #include "../Components.h"
 #include "../Entity.h"
+#include "BallSpeedSystem.h"
+#include "ParticleSystem.h"
+#include "../StatModifiers.h"
+#include "../../BonusTable.h"
+#include "../../SaveJournal.h"
 #include "../../GameState.h"
+#include "../../Physics.h"
+#include <algorithm>
 #include <cstdint>
 #include <cmath>
-#include <cstdio>
+#include <span>
 
-namespace {
-void applyBonus(ECSManager& ecs, Entity targetEntity, BonusType type, float duration) {
-    
-    auto existing = ecs.getComponent<ActiveBonusComponent>(targetEntity);
-    if (existing) {
-        if (existing->type == type) {
-            
-            existing->remainingTime = duration;
-            return;
-        } else {
-            
-            switch (existing->type) {
-                case BonusType::SlowBall: {
-                    auto velocity = ecs.getComponent<VelocityComponent>(targetEntity);
-                    if (velocity) {
-                        velocity->speed = existing->originalValue;
-                        
-                        float currentSpeed = std::sqrt(velocity->velocity.x * velocity->velocity.x + velocity->velocity.y * velocity->velocity.y);
-                        if (currentSpeed > 0.0f) {
-                            velocity->velocity = velocity->velocity * (velocity->speed / currentSpeed);
-                        }
-                    }
-                    break;
-                }
-                case BonusType::FastPlatform: {
-                    auto input = ecs.getComponent<InputComponent>(targetEntity);
-                    if (input) input->moveSpeed = existing->originalValue;
-                    break;
-                }
-                case BonusType::BigPlatform: {
-                    auto shape = ecs.getComponent<ShapeComponent>(targetEntity);
-                    auto position = ecs.getComponent<PositionComponent>(targetEntity);
-                    if (shape && shape->type == ShapeComponent::Type::Rectangle) {
-                        shape->rectangle.width = existing->originalValue;
-                        if (auto collider = ecs.getComponent<ColliderComponent>(targetEntity)) {
-                            collider->size.x = existing->originalValue;
-                        }
-                        
-                        if (position) {
-                            float newWidth = existing->originalValue;
-                            if (position->position.x < 0.0f) {
-                                position->position.x = 0.0f;
-                            }
-                            if (position->position.x + newWidth > static_cast<float>(GAME_STATE.WINDOW_WIDTH)) {
-                                position->position.x = static_cast<float>(GAME_STATE.WINDOW_WIDTH) - newWidth;
-                            }
-                        }
-                    }
-                    break;
-                }
-            }
-            ecs.removeComponent<ActiveBonusComponent>(targetEntity);
-        }
+namespace
+{
+constexpr std::uint32_t BRICK_LAYER = ColliderComponent::layerOf(ColliderComponent::Type::Brick);
+}
+
+void CollisionSystem::setTimers(TimerWheel* timerWheel)
+{
+    timers = timerWheel;
+}
+
+void CollisionSystem::applyBonus(ECSManager& ecs, BonusType type, Entity ballEntity, Entity platformEntity)
+{
+    const BonusDefinition& bonus = BonusTable::get(type);
+    const Entity target = bonus.target == BonusTarget::Ball ? ballEntity : platformEntity;
+    if (target == INVALID_ENTITY) return;
+
+    StatModifier modifier;
+    modifier.source = type;
+    modifier.stat = bonus.stat;
+    modifier.factor = bonus.factor;
+    modifier.offset = bonus.offset;
+    modifier.remainingTime = bonus.duration;
+    if (auto modifiers = ecs.getComponent<StatModifiersComponent>(target))
+    {
+        if (const StatModifier* existing = modifiers->find(type)) modifier.expiry = existing->expiry;
     }
-    
-    
-    float originalValue = 0.0f;
-    switch (type) {
-        case BonusType::SlowBall: {
-            auto velocity = ecs.getComponent<VelocityComponent>(targetEntity);
-            if (velocity) {
-                originalValue = velocity->speed;
-                
-                velocity->speed *= 0.5f;
-                
-                float currentSpeed = std::sqrt(velocity->velocity.x * velocity->velocity.x + velocity->velocity.y * velocity->velocity.y);
-                if (currentSpeed > 0.0f) {
-                    velocity->velocity = velocity->velocity * (velocity->speed / currentSpeed);
-                }
-            }
-            break;
-        }
-        case BonusType::FastPlatform: {
-            auto input = ecs.getComponent<InputComponent>(targetEntity);
-            if (input) {
-                originalValue = input->moveSpeed;
-                
-                input->moveSpeed *= 1.5f;
-            }
-            break;
-        }
-        case BonusType::BigPlatform: {
-            auto shape = ecs.getComponent<ShapeComponent>(targetEntity);
-            auto position = ecs.getComponent<PositionComponent>(targetEntity);
-            if (shape && shape->type == ShapeComponent::Type::Rectangle) {
-                originalValue = shape->rectangle.width;
-                printf("[DEBUG] Applying BigPlatform bonus. Original width: %.1f\n", originalValue);
-                
-                shape->rectangle.width *= 1.5f;
-                printf("[DEBUG] New width: %.1f\n", shape->rectangle.width);
-                if (auto collider = ecs.getComponent<ColliderComponent>(targetEntity)) {
-                    collider->size.x = shape->rectangle.width;
-                }
-                
-                if (position) {
-                    float newWidth = shape->rectangle.width;
-                    if (position->position.x < 0.0f) {
-                        position->position.x = 0.0f;
-                    }
-                    if (position->position.x + newWidth > static_cast<float>(GAME_STATE.WINDOW_WIDTH)) {
-                        position->position.x = static_cast<float>(GAME_STATE.WINDOW_WIDTH) - newWidth;
-                    }
-                }
-            }
-            break;
+
+    StatModifier* added = StatModifiers::add(ecs, target, modifier);
+    if (!added) return;
+    scheduleBonusExpiry(ecs, target, *added);
+    if (journal) journal->recordBonusApplied(target, *added);
+    if (ballSpeed && bonus.stat == Stat::BallSpeed) ballSpeed->updateHold(ecs, target);
+}
+
+void CollisionSystem::scheduleBonusExpiry(ECSManager& ecs, Entity entity, StatModifier& modifier)
+{
+    if (!timers) return;
+
+    const TimerWheel::Tick delay = timers->toTicks(modifier.remainingTime);
+    if (!timers->reschedule(modifier.expiry, delay))
+    {
+        modifier.expiry = timers->schedule(delay, [this, &ecs, entity, source = modifier.source] {
+            expireBonus(ecs, entity, source);
+        });
+    }
+}
+
+void CollisionSystem::restoreBonuses(ECSManager& ecs)
+{
+    for (Entity entity : ecs.getEntitiesWithComponent<StatModifiersComponent>())
+    {
+        StatModifiers::restore(ecs, entity);
+        auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+        for (std::size_t i = 0; i < modifiers->count; ++i)
+        {
+            scheduleBonusExpiry(ecs, entity, modifiers->modifiers[i]);
         }
+        if (ballSpeed) ballSpeed->updateHold(ecs, entity);
     }
-    
-    
-    ecs.addComponent<ActiveBonusComponent>(targetEntity,
-        std::make_shared<ActiveBonusComponent>(type, duration, originalValue));
 }
+
+// A timer left behind by a destroyed entity may fire for an entity id that
+// now belongs to someone else; that entity's own modifier timer is still
+// pending, so it is left alone. Loads cancel the old world's timers instead.
+void CollisionSystem::expireBonus(ECSManager& ecs, Entity entity, BonusType source)
+{
+    auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+    const StatModifier* modifier = modifiers ? modifiers->find(source) : nullptr;
+    if (!modifier || timers->isPending(modifier->expiry)) return;
+
+    const Stat stat = modifier->stat;
+    StatModifiers::remove(ecs, entity, source);
+    if (journal) journal->recordBonusExpired(entity, source);
+    if (ballSpeed && stat == Stat::BallSpeed) ballSpeed->updateHold(ecs, entity);
+}
+
+void CollisionSystem::setParticleSystem(ParticleSystem* particleSystem)
+{
+    particles = particleSystem;
+}
+
+void CollisionSystem::setJournal(SaveJournal* saveJournal)
+{
+    journal = saveJournal;
+}
+
+void CollisionSystem::setBallSpeedSystem(BallSpeedSystem* ballSpeedSystem)
+{
+    ballSpeed = ballSpeedSystem;
 }
 
 void CollisionSystem::update(float deltaTime, ECSManager& ecs)
 {
-    
+    flushDestroyedBricks(ecs);
+
     auto entities = ecs.getEntitiesWithComponent<ColliderComponent>();
+    SpatialGrid& index = ecs.getSpatialIndex();
+    index.setCellSize(GAME_STATE.SPATIAL_INDEX_CELL_SIZE);
+    index.begin();
 
     for (Entity entity : entities)
     {
@@ -134,43 +122,45 @@ void CollisionSystem::update(float deltaTime, ECSManager& ecs)
 
         if (!collider || !position) continue;
 
+        const std::uint32_t layer = ColliderComponent::layerOf(collider->type);
+        if (collider->type == ColliderComponent::Type::Brick)
+        {
+            index.add(entity, position->position, collider->size, layer);
+            continue;
+        }
+
         
         if (collider->type == ColliderComponent::Type::Ball && velocity)
         {
-            float radius = collider->radius;
-
-            
-            if (position->position.x - radius < 0.0f)
-            {
-                position->position.x = radius;
-                velocity->velocity.x = -velocity->velocity.x;
-            }
-
-            
-            if (position->position.x + radius > static_cast<float>(GAME_STATE.WINDOW_WIDTH))
-            {
-                position->position.x = static_cast<float>(GAME_STATE.WINDOW_WIDTH) - radius;
-                velocity->velocity.x = -velocity->velocity.x;
-            }
-
-            
-            if (position->position.y - radius < 0.0f)
-            {
-                position->position.y = radius;
-                velocity->velocity.y = -velocity->velocity.y;
-            }
+            Scalar x(position->position.x);
+            Scalar y(position->position.y);
+            Scalar vx(velocity->velocity.x);
+            Scalar vy(velocity->velocity.y);
+            Physics::bounceOffWalls(x, y, vx, vy, Scalar(collider->radius),
+                                    Scalar(static_cast<float>(GAME_STATE.WINDOW_WIDTH)));
+            position->position = {static_cast<float>(x), static_cast<float>(y)};
+            velocity->velocity = {static_cast<float>(vx), static_cast<float>(vy)};
         }
 
         
         if (collider->type == ColliderComponent::Type::Platform)
         {
-            float platformWidth = collider->size.x;
-            if (position->position.x < 0.0f)
-                position->position.x = 0.0f;
-            if (position->position.x + platformWidth > static_cast<float>(GAME_STATE.WINDOW_WIDTH))
-                position->position.x = static_cast<float>(GAME_STATE.WINDOW_WIDTH) - platformWidth;
+            position->position.x = static_cast<float>(
+                Physics::clampPaddle(Scalar(position->position.x), Scalar(collider->size.x),
+                                     Scalar(static_cast<float>(GAME_STATE.WINDOW_WIDTH))));
+        }
+
+        if (collider->type == ColliderComponent::Type::Ball)
+        {
+            const sf::Vector2f extent{collider->radius, collider->radius};
+            index.add(entity, position->position - extent, extent * 2.0f, layer);
+        }
+        else
+        {
+            index.add(entity, position->position, collider->size, layer);
         }
     }
+    index.build();
 
     
     Entity platformEntity = INVALID_ENTITY;
@@ -198,51 +188,23 @@ void CollisionSystem::update(float deltaTime, ECSManager& ecs)
 
         if (platformPos && platformCollider && ballPos && ballCollider && ballVelocity)
         {
-            float ballRadius = ballCollider->radius;
-            sf::Vector2f platformSize = platformCollider->size;
-
-            
-            bool colliding = (ballPos->position.x + ballRadius > platformPos->position.x &&
-                             ballPos->position.x - ballRadius < platformPos->position.x + platformSize.x &&
-                             ballPos->position.y + ballRadius > platformPos->position.y &&
-                             ballPos->position.y - ballRadius < platformPos->position.y + platformSize.y);
-
-            if (colliding && ballVelocity->velocity.y > 0.0f) 
+            Scalar y(ballPos->position.y);
+            Scalar vx(ballVelocity->velocity.x);
+            Scalar vy(ballVelocity->velocity.y);
+            if (Physics::bounceOffPaddle(Scalar(ballPos->position.x), y, vx, vy, Scalar(ballCollider->radius),
+                                         Scalar(ballVelocity->speed), Scalar(platformPos->position.x),
+                                         Scalar(platformPos->position.y), Scalar(platformCollider->size.x),
+                                         Scalar(platformCollider->size.y)))
             {
-                
-                ballVelocity->velocity.y = -std::abs(ballVelocity->velocity.y);
-
-                
-                
-                if (platformSize.x > 0.0f)
-                {
-                    float platformCenterX = platformPos->position.x + platformSize.x / 2.0f;
-                    float ballCenterX = ballPos->position.x;
-                    float relativeIntersectX = (ballCenterX - platformCenterX) / (platformSize.x / 2.0f);
-
-                    
-                    ballVelocity->velocity.x = relativeIntersectX * ballVelocity->speed * 0.5f;
-                }
-                else
-                {
-                    
-                    ballVelocity->velocity.x = 0.0f;
-                }
-
-                
-                float currentSpeed = std::sqrt(ballVelocity->velocity.x * ballVelocity->velocity.x +
-                                              ballVelocity->velocity.y * ballVelocity->velocity.y);
-                if (currentSpeed > 0.0f)
-                {
-                    ballVelocity->velocity = ballVelocity->velocity * (ballVelocity->speed / currentSpeed);
-                }
-
-                
-                ballPos->position.y = platformPos->position.y - ballRadius;
+                ballPos->position.y = static_cast<float>(y);
+                ballVelocity->velocity = {static_cast<float>(vx), static_cast<float>(vy)};
             }
         }
     }
 
+    lastBall = ballEntity;
+    lastPlatform = platformEntity;
+
     if (ballEntity != INVALID_ENTITY)
     {
         auto ballPos = ecs.getComponent<PositionComponent>(ballEntity);
@@ -252,155 +214,168 @@ void CollisionSystem::update(float deltaTime, ECSManager& ecs)
         if (ballPos && ballCollider && ballVelocity)
         {
             float ballRadius = ballCollider->radius;
-            std::vector<Entity> bricksToDestroy;
-            bool ballCollisionHandled = false;
+            const sf::Vector2f ballMin{ballPos->position.x - ballRadius, ballPos->position.y - ballRadius};
+            const sf::Vector2f ballMax{ballPos->position.x + ballRadius, ballPos->position.y + ballRadius};
+
+            // Sorted, so the bounce comes off the same brick whatever the
+            // layout of the index.
+            ballHits.clear();
+            ecs.queryAABB(ballMin, ballMax, [this](Entity brick) { ballHits.push_back(brick); }, BRICK_LAYER);
+            std::sort(ballHits.begin(), ballHits.end());
 
-            for (Entity entity : entities)
+            bool ballCollisionHandled = false;
+            for (Entity entity : ballHits)
             {
+                auto brickPos = ecs.getComponent<PositionComponent>(entity);
                 auto collider = ecs.getComponent<ColliderComponent>(entity);
-                if (collider && collider->type == ColliderComponent::Type::Brick)
+                if (!brickPos || !collider) continue;
+
+                if (!ballCollisionHandled)
+                {
+                    sf::Vector2f brickSize = collider->size;
+                    Scalar x(ballPos->position.x);
+                    Scalar y(ballPos->position.y);
+                    Scalar vx(ballVelocity->velocity.x);
+                    Scalar vy(ballVelocity->velocity.y);
+                    Physics::bounceOffBrick(x, y, vx, vy, Scalar(ballRadius), Scalar(brickPos->position.x),
+                                            Scalar(brickPos->position.y), Scalar(brickPos->position.x + brickSize.x),
+                                            Scalar(brickPos->position.y + brickSize.y));
+                    ballPos->position = {static_cast<float>(x), static_cast<float>(y)};
+                    ballVelocity->velocity = {static_cast<float>(vx), static_cast<float>(vy)};
+
+                    ballCollisionHandled = true;
+                }
+                else
                 {
-                    auto brickPos = ecs.getComponent<PositionComponent>(entity);
-                    if (brickPos)
+                    // The rest only count if the bounce left the ball
+                    // still overlapping them.
+                    const sf::Vector2f ball = ballPos->position;
+                    const sf::Vector2f brickMax = brickPos->position + collider->size;
+                    if (!(ball.x + ballRadius > brickPos->position.x && ball.x - ballRadius < brickMax.x &&
+                          ball.y + ballRadius > brickPos->position.y && ball.y - ballRadius < brickMax.y))
                     {
-                        sf::Vector2f brickSize = collider->size;
-
-                        bool colliding = (ballPos->position.x + ballRadius > brickPos->position.x &&
-                                         ballPos->position.x - ballRadius < brickPos->position.x + brickSize.x &&
-                                         ballPos->position.y + ballRadius > brickPos->position.y &&
-                                         ballPos->position.y - ballRadius < brickPos->position.y + brickSize.y);
-
-                        if (colliding)
-                        {
-
-                            if (!ballCollisionHandled)
-                            {
-                                float ballCenterX = ballPos->position.x;
-                                float ballCenterY = ballPos->position.y;
-                                float brickLeft = brickPos->position.x;
-                                float brickRight = brickPos->position.x + brickSize.x;
-                                float brickTop = brickPos->position.y;
-                                float brickBottom = brickPos->position.y + brickSize.y;
-
-                                float distLeft = std::abs(ballCenterX - brickLeft);
-                                float distRight = std::abs(ballCenterX - brickRight);
-                                float distTop = std::abs(ballCenterY - brickTop);
-                                float distBottom = std::abs(ballCenterY - brickBottom);
-
-                                float minDist = std::min({distLeft, distRight, distTop, distBottom});
-
-                                if (minDist == distLeft)
-                                {
-                                    ballVelocity->velocity.x = -ballVelocity->velocity.x;
-                                    ballPos->position.x = brickLeft - ballRadius;
-                                }
-                                else if (minDist == distRight)
-                                {
-                                    ballVelocity->velocity.x = -ballVelocity->velocity.x;
-                                    ballPos->position.x = brickRight + ballRadius;
-                                }
-                                else if (minDist == distTop)
-                                {
-                                    ballVelocity->velocity.y = -ballVelocity->velocity.y;
-                                    ballPos->position.y = brickTop - ballRadius;
-                                }
-                                else
-                                {
-                                    ballVelocity->velocity.y = -ballVelocity->velocity.y;
-                                    ballPos->position.y = brickBottom + ballRadius;
-                                }
-
-                                ballCollisionHandled = true;
-                            }
-
-
-                            auto durableBrick = ecs.getComponent<DurableBrick>(entity);
-                            if (durableBrick) {
-                                durableBrick->takeHit();
-
-                                auto shape = ecs.getComponent<ShapeComponent>(entity);
-                                if (shape) {
-                                    float healthPercentage = durableBrick->getHealthPercentage();
-                                    sf::Color originalColor = shape->color;
-
-                                    shape->color = sf::Color(
-                                        static_cast<std::uint8_t>(originalColor.r * healthPercentage),
-                                        static_cast<std::uint8_t>(originalColor.g * healthPercentage),
-                                        static_cast<std::uint8_t>(originalColor.b * healthPercentage)
-                                    );
-                                }
-
-                                if (durableBrick->isDestroyed()) {
-                                    GAME_STATE.addScore(durableBrick->maxHits * 10);
-                                    
-                                    auto bonus = ecs.getComponent<BonusComponent>(entity);
-                                    if (bonus && !bonus->collected) {
-                                        bonus->collected = true;
-                                        
-                                        Entity targetEntity = INVALID_ENTITY;
-                                        float duration = 0.0f;
-                                        switch (bonus->type) {
-                                            case BonusType::SlowBall:
-                                                targetEntity = ballEntity;
-                                                duration = GAME_STATE.SLOW_BALL_DURATION;
-                                                break;
-                                            case BonusType::FastPlatform:
-                                                targetEntity = platformEntity;
-                                                duration = GAME_STATE.FAST_PLATFORM_DURATION;
-                                                break;
-                                            case BonusType::BigPlatform:
-                                                targetEntity = platformEntity;
-                                                duration = GAME_STATE.BIG_PLATFORM_DURATION;
-                                                break;
-                                        }
-                                        if (targetEntity != INVALID_ENTITY) {
-                                            applyBonus(ecs, targetEntity, bonus->type, duration);
-                                        }
-                                    }
-                                    bricksToDestroy.push_back(entity);
-                                }
-                            } else {
-                                GAME_STATE.addScore(10);
-                                
-                                auto bonus = ecs.getComponent<BonusComponent>(entity);
-                                if (bonus && !bonus->collected) {
-                                    bonus->collected = true;
-                                    
-                                    Entity targetEntity = INVALID_ENTITY;
-                                    float duration = 0.0f;
-                                    switch (bonus->type) {
-                                        case BonusType::SlowBall:
-                                            targetEntity = ballEntity;
-                                            duration = GAME_STATE.SLOW_BALL_DURATION;
-                                            break;
-                                        case BonusType::FastPlatform:
-                                            targetEntity = platformEntity;
-                                            duration = GAME_STATE.FAST_PLATFORM_DURATION;
-                                            break;
-                                        case BonusType::BigPlatform:
-                                            targetEntity = platformEntity;
-                                            duration = GAME_STATE.BIG_PLATFORM_DURATION;
-                                            break;
-                                    }
-                                    if (targetEntity != INVALID_ENTITY) {
-                                        applyBonus(ecs, targetEntity, bonus->type, duration);
-                                    }
-                                }
-                                bricksToDestroy.push_back(entity);
-                            }
-                        }
+                        continue;
                     }
                 }
-            }
 
-            for (Entity brick : bricksToDestroy)
-            {
-                ecs.destroyEntity(brick);
+                hitBrick(ecs, entity, ballPos->position);
             }
         }
     }
 }
 
+bool CollisionSystem::hitBrick(ECSManager& ecs, Entity brick, sf::Vector2f impact)
+{
+    const std::size_t chainStart = destroyedBricks.size();
+    const std::uint32_t box = ecs.getSpatialIndex().find(brick);
+    const bool destroyed = box != SpatialGrid::NONE && damageBrick(ecs, box, impact);
+    if (!blasts.empty()) detonate(ecs);
+
+    // Out of the index already; without a position they are not drawn,
+    // moved or scrolled either.
+    const std::span<const Entity> chain(destroyedBricks.begin() + chainStart, destroyedBricks.end());
+    ecs.removeComponents<PositionComponent>(chain);
+    if (journal)
+    {
+        for (Entity entity : chain)
+        {
+            journal->recordBrickDestroyed(entity);
+        }
+    }
+    return destroyed;
+}
+
+void CollisionSystem::flushDestroyedBricks(ECSManager& ecs)
+{
+    if (destroyedBricks.empty()) return;
+    ecs.destroyEntities(destroyedBricks);
+    destroyedBricks.clear();
+}
+
+// Breadth-first over the chain: each blast hits every brick in its radius,
+// and explosive bricks it destroys queue blasts of their own. A destroyed
+// brick leaves the spatial index, which is the visited set: no brick is hit
+// after it is gone or blasts twice.
+void CollisionSystem::detonate(ECSManager& ecs)
+{
+    SpatialGrid& index = ecs.getSpatialIndex();
+    for (std::size_t next = 0; next < blasts.size(); ++next)
+    {
+        const Blast blast = blasts[next];
+        if (particles) particles->spawnBurst(ParticleKind::Spark, blast.center, sf::Color(255, 160, 0), 16);
+
+        blastTargets.clear();
+        index.queryRadius(blast.center, blast.radius, BRICK_LAYER,
+                          [this](std::uint32_t box) { blastTargets.push_back(box); });
+        for (std::uint32_t target : blastTargets)
+        {
+            damageBrick(ecs, target, blast.center);
+        }
+    }
+    blasts.clear();
+}
+
+// Destroyed bricks leave the spatial index at once; the rest of their
+// teardown waits for flushDestroyedBricks().
+bool CollisionSystem::damageBrick(ECSManager& ecs, std::uint32_t box, sf::Vector2f impact)
+{
+    SpatialGrid& index = ecs.getSpatialIndex();
+    if (!index.isAlive(box)) return false;
+    const Entity entity = index.getEntity(box);
+    const sf::Vector2f brickCenter = index.getPosition(box) + index.getSize(box) / 2.0f;
+
+    auto shape = ecs.findComponent<ShapeComponent>(entity);
+    sf::Color debrisColor = shape ? shape->color : sf::Color::White;
+
+    auto durableBrick = ecs.findComponent<DurableBrick>(entity);
+    if (durableBrick) {
+        durableBrick->takeHit();
+
+        if (shape) {
+            float healthPercentage = durableBrick->getHealthPercentage();
+            sf::Color originalColor = shape->color;
+
+            shape->color = sf::Color(
+                static_cast<std::uint8_t>(originalColor.r * healthPercentage),
+                static_cast<std::uint8_t>(originalColor.g * healthPercentage),
+                static_cast<std::uint8_t>(originalColor.b * healthPercentage)
+            );
+        }
+
+        if (journal) {
+            journal->recordBrickHit(entity, durableBrick->currentHits,
+                                    shape ? shape->color : sf::Color::White);
+        }
+
+        if (!durableBrick->isDestroyed()) {
+            if (particles) particles->spawnBurst(ParticleKind::Spark, impact, sf::Color::White, 12);
+            return false;
+        }
+        GAME_STATE.addScore(durableBrick->maxHits * 10);
+        if (journal) journal->recordScoreDelta(durableBrick->maxHits * 10);
+    } else {
+        GAME_STATE.addScore(10);
+        if (journal) journal->recordScoreDelta(10);
+    }
+
+    auto bonus = ecs.findComponent<BonusComponent>(entity);
+    if (bonus && !bonus->collected) {
+        bonus->collected = true;
+        if (particles) particles->spawnBurst(ParticleKind::BonusBurst, brickCenter, BonusTable::get(bonus->type).color, 32);
+
+        applyBonus(ecs, bonus->type, lastBall, lastPlatform);
+    }
+    if (particles) particles->spawnBurst(ParticleKind::Debris, brickCenter, debrisColor, 24);
+
+    if (auto explosive = ecs.findComponent<ExplosiveBrick>(entity)) {
+        blasts.push_back({brickCenter, explosive->radius});
+    }
+
+    index.remove(box);
+    destroyedBricks.push_back(entity);
+    return true;
+}
+
 bool CollisionSystem::isBallOutOfBounds(Entity ballEntity, ECSManager& ecs) const
 {
     auto ballPos = ecs.getComponent<PositionComponent>(ballEntity);
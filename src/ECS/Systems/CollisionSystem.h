@@ -2,14 +2,72 @@
 
 #include "../System.h"
 #include "../Entity.h"
+#include "../Components.h"
+#include "../../TimerWheel.h"
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
 
+class BallSpeedSystem;
 class ECSManager;
+class ParticleSystem;
+class SaveJournal;
 
 class CollisionSystem : public System
 {
 public:
+    void setParticleSystem(ParticleSystem* particleSystem);
+    void setJournal(SaveJournal* saveJournal);
+    // Told when ball speed modifiers are added or removed.
+    void setBallSpeedSystem(BallSpeedSystem* ballSpeedSystem);
+    // Bonus modifiers expire through timers on this wheel.
+    void setTimers(TimerWheel* timerWheel);
+    // After a load: rebuilds modifier bases and re-arms their timers from
+    // remainingTime.
+    void restoreBonuses(ECSManager& ecs);
     void update(float deltaTime, ECSManager& ecs) override;
     bool isBallOutOfBounds(Entity ballEntity, ECSManager& ecs) const;
+
+    // Damages a brick as a ball hit would: score, bonus, particles, journal,
+    // and destruction once it runs out of hits, setting off any chain of
+    // explosive bricks. Returns true if the brick was destroyed.
+    //
+    // Destroyed bricks lose their box in the spatial index and their
+    // position at once, which takes them out of collisions and off screen.
+    // Their entities are destroyed by the next flushDestroyedBricks(), so a
+    // long chain does not also pay for tearing them down in its frame.
+    bool hitBrick(ECSManager& ecs, Entity brick, sf::Vector2f impact);
+    // Destroys the entities of the bricks hitBrick() destroyed. update()
+    // starts with it; call it before saving or replacing the world too.
+    void flushDestroyedBricks(ECSManager& ecs);
+
+private:
+    void applyBonus(ECSManager& ecs, BonusType type, Entity ballEntity, Entity platformEntity);
+    void scheduleBonusExpiry(ECSManager& ecs, Entity entity, StatModifier& modifier);
+    void expireBonus(ECSManager& ecs, Entity entity, BonusType source);
+    // `box` is the brick's box in the spatial index.
+    bool damageBrick(ECSManager& ecs, std::uint32_t box, sf::Vector2f impact);
+    void detonate(ECSManager& ecs);
+
+    struct Blast
+    {
+        sf::Vector2f center;
+        float radius;
+    };
+
+    ParticleSystem* particles = nullptr;
+    SaveJournal* journal = nullptr;
+    BallSpeedSystem* ballSpeed = nullptr;
+    TimerWheel* timers = nullptr;
+
+    std::vector<Entity> ballHits;
+    // Blasts of the chain being resolved, in order; reused between chains.
+    std::vector<Blast> blasts;
+    std::vector<std::uint32_t> blastTargets;
+    // Destroyed since the last flushDestroyedBricks().
+    std::vector<Entity> destroyedBricks;
+    // Bonuses from hitBrick() go to these, found by the last update.
+    Entity lastBall = INVALID_ENTITY;
+    Entity lastPlatform = INVALID_ENTITY;
 };
 
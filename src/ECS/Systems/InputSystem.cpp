@@ -3,21 +3,22 @@
 #include "../Components.h"
 #include <SFML/Window/Keyboard.hpp>
 
-void InputSystem::update(float deltaTime, ECSManager& ecs)
+void KeyboardController::steer(float deltaTime, ECSManager& ecs, Entity paddle, InputComponent& input)
 {
-    
-    auto entities = ecs.getEntitiesWithComponent<InputComponent>();
-
-    for (Entity entity : entities)
-    {
-        auto input = ecs.getComponent<InputComponent>(entity);
-        if (!input) continue;
+    input.leftPressed = (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A) ||
+                         sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left));
+    input.rightPressed = (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D) ||
+                          sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right));
+}
 
-        
-        input->leftPressed = (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A) ||
-                             sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left));
-        input->rightPressed = (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D) ||
-                              sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right));
-    }
+void InputSystem::setController(PaddleController* paddleController)
+{
+    controller = paddleController ? paddleController : &keyboard;
 }
 
+void InputSystem::update(float deltaTime, ECSManager& ecs)
+{
+    ecs.forEachComponent<InputComponent>([&](Entity entity, InputComponent& input) {
+        controller->steer(deltaTime, ecs, entity, input);
+    });
+}
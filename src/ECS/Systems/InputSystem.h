@@ -1,11 +1,34 @@
 #pragma once
 
 #include "../System.h"
+#include "../Entity.h"
 #include <SFML/Window/Keyboard.hpp>
 
+struct InputComponent;
+
+// Steers a paddle by setting the keys held in its InputComponent each frame.
+class PaddleController
+{
+public:
+    virtual ~PaddleController() = default;
+    virtual void steer(float deltaTime, ECSManager& ecs, Entity paddle, InputComponent& input) = 0;
+};
+
+// Arrow keys or A/D.
+class KeyboardController : public PaddleController
+{
+public:
+    void steer(float deltaTime, ECSManager& ecs, Entity paddle, InputComponent& input) override;
+};
+
 class InputSystem : public System
 {
 public:
+    // nullptr goes back to the keyboard.
+    void setController(PaddleController* paddleController);
     void update(float deltaTime, ECSManager& ecs) override;
-};
 
+private:
+    KeyboardController keyboard;
+    PaddleController* controller = &keyboard;
+};
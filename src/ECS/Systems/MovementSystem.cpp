@@ -1,11 +1,12 @@
 #include "MovementSystem.h"
 #include "../ECSManager.h"
 #include "../Components.h"
+#include "../../Physics.h"
 #include <SFML/Graphics.hpp>
 
 void MovementSystem::update(float deltaTime, ECSManager& ecs)
 {
-    
+    const Scalar dt(deltaTime);
     auto entities = ecs.getEntitiesWithComponent<PositionComponent>();
 
     for (Entity entity : entities)
@@ -25,13 +26,16 @@ void MovementSystem::update(float deltaTime, ECSManager& ecs)
             else if (input->rightPressed)
                 moveDirection = 1.0f;
 
-            velocity->velocity.x = moveDirection * input->moveSpeed;
+            velocity->velocity.x = static_cast<float>(Scalar(moveDirection) * Scalar(input->moveSpeed));
         }
 
         
         if (velocity)
         {
-            position->position += velocity->velocity * deltaTime;
+            position->position.x = static_cast<float>(
+                Physics::advance(Scalar(position->position.x), Scalar(velocity->velocity.x), dt));
+            position->position.y = static_cast<float>(
+                Physics::advance(Scalar(position->position.y), Scalar(velocity->velocity.y), dt));
         }
     }
 }
@@ -0,0 +1,136 @@
+#include "ParticleSystem.h"
+#include "../ECSManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_SYSTEM_SSE2 1
+#endif
+
+namespace {
+struct ParticleKindParams
+{
+    float minSpeed;
+    float maxSpeed;
+    float gravity;
+    float minLife;
+    float maxLife;
+};
+
+ParticleKindParams paramsFor(ParticleKind kind)
+{
+    switch (kind)
+    {
+        case ParticleKind::Debris: return {40.0f, 160.0f, 600.0f, 0.6f, 1.2f};
+        case ParticleKind::Spark: return {150.0f, 350.0f, 0.0f, 0.1f, 0.3f};
+        case ParticleKind::BonusBurst: return {120.0f, 140.0f, 0.0f, 0.5f, 0.7f};
+    }
+    return {0.0f, 0.0f, 0.0f, 1.0f, 1.0f};
+}
+
+constexpr float PARTICLE_SIZE = 3.0f;
+}
+
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : capacity(capacity),
+      x(new float[capacity]), y(new float[capacity]),
+      vx(new float[capacity]), vy(new float[capacity]),
+      gravity(new float[capacity]), life(new float[capacity]),
+      inverseMaxLife(new float[capacity]),
+      color(new std::uint32_t[capacity]), fadedColor(new std::uint32_t[capacity])
+{
+}
+
+void ParticleSystem::spawnBurst(ParticleKind kind, sf::Vector2f origin, sf::Color burstColor, int burstCount)
+{
+    const ParticleKindParams params = paramsFor(kind);
+    const std::size_t spawned = std::min(static_cast<std::size_t>(std::max(burstCount, 0)), capacity - count);
+    const std::uint32_t packedColor = burstColor.toInteger();
+
+    for (std::size_t i = 0; i < spawned; ++i)
+    {
+        const std::size_t p = count + i;
+        const float angle = kind == ParticleKind::BonusBurst
+            ? 6.2831853f * static_cast<float>(i) / static_cast<float>(spawned)
+            : 6.2831853f * random.nextFloat();
+        const float speed = params.minSpeed + (params.maxSpeed - params.minSpeed) * random.nextFloat();
+        const float lifetime = params.minLife + (params.maxLife - params.minLife) * random.nextFloat();
+
+        x[p] = origin.x;
+        y[p] = origin.y;
+        vx[p] = std::cos(angle) * speed;
+        vy[p] = std::sin(angle) * speed;
+        gravity[p] = params.gravity;
+        life[p] = lifetime;
+        inverseMaxLife[p] = 1.0f / lifetime;
+        color[p] = packedColor;
+    }
+    count += spawned;
+}
+
+void ParticleSystem::update(float deltaTime, ECSManager& ecs)
+{
+    float* __restrict px = x.get();
+    float* __restrict py = y.get();
+    float* __restrict pvx = vx.get();
+    float* __restrict pvy = vy.get();
+    float* __restrict plife = life.get();
+    const float* __restrict pgravity = gravity.get();
+
+    std::size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE2
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 velocityY = _mm_add_ps(_mm_loadu_ps(pvy + i), _mm_mul_ps(_mm_loadu_ps(pgravity + i), dt));
+        __m128 velocityX = _mm_loadu_ps(pvx + i);
+        _mm_storeu_ps(pvy + i, velocityY);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(velocityX, dt)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(velocityY, dt)));
+        _mm_storeu_ps(plife + i, _mm_sub_ps(_mm_loadu_ps(plife + i), dt));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        pvy[i] += pgravity[i] * deltaTime;
+        px[i] += pvx[i] * deltaTime;
+        py[i] += pvy[i] * deltaTime;
+        plife[i] -= deltaTime;
+    }
+
+    // Swap-remove expired particles; order is irrelevant for rendering.
+    for (std::size_t p = 0; p < count;)
+    {
+        if (plife[p] > 0.0f)
+        {
+            ++p;
+            continue;
+        }
+
+        const std::size_t last = --count;
+        px[p] = px[last];
+        py[p] = py[last];
+        pvx[p] = pvx[last];
+        pvy[p] = pvy[last];
+        gravity[p] = gravity[last];
+        plife[p] = plife[last];
+        inverseMaxLife[p] = inverseMaxLife[last];
+        color[p] = color[last];
+    }
+}
+
+void ParticleSystem::render(RenderBackend& target) const
+{
+    if (count == 0) return;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float fade = std::min(life[i] * inverseMaxLife[i], 1.0f);
+        const std::uint32_t alpha = static_cast<std::uint32_t>((color[i] & 0xFFu) * fade);
+        fadedColor[i] = (color[i] & 0xFFFFFF00u) | alpha;
+    }
+
+    target.drawParticles(x.get(), y.get(), fadedColor.get(), count, PARTICLE_SIZE);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../System.h"
+#include "../../Render/RenderBackend.h"
+#include "../../Random.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+enum class ParticleKind
+{
+    Debris,
+    Spark,
+    BonusBurst
+};
+
+// Fixed-capacity structure-of-arrays particle pool. Particles are not ECS
+// entities: spawning writes to the end of the arrays, expiry swap-removes,
+// and nothing is allocated after construction. Spawns beyond capacity are
+// dropped.
+class ParticleSystem : public System
+{
+public:
+    explicit ParticleSystem(std::size_t capacity);
+
+    void update(float deltaTime, ECSManager& ecs) override;
+    void render(RenderBackend& target) const;
+
+    void spawnBurst(ParticleKind kind, sf::Vector2f origin, sf::Color color, int count);
+    void clear() { count = 0; }
+    void setRandom(const RandomStream& stream) { random = stream; }
+
+    std::size_t getCount() const { return count; }
+    std::size_t getCapacity() const { return capacity; }
+
+private:
+    std::size_t capacity;
+    std::size_t count = 0;
+
+    std::unique_ptr<float[]> x;
+    std::unique_ptr<float[]> y;
+    std::unique_ptr<float[]> vx;
+    std::unique_ptr<float[]> vy;
+    std::unique_ptr<float[]> gravity;
+    std::unique_ptr<float[]> life;
+    std::unique_ptr<float[]> inverseMaxLife;
+    std::unique_ptr<std::uint32_t[]> color;
+    mutable std::unique_ptr<std::uint32_t[]> fadedColor;
+
+    RandomStream random;
+};
@@ -0,0 +1,161 @@
+#include "ProjectileSystem.h"
+#include "CollisionSystem.h"
+#include "../ECSManager.h"
+#include "../Components.h"
+#include "../../GameState.h"
+
+#include <algorithm>
+
+namespace {
+constexpr float BOLT_WIDTH = 4.0f;
+constexpr std::size_t BOLT_SEGMENTS = 3;
+constexpr float BOLT_LENGTH = BOLT_WIDTH * BOLT_SEGMENTS;
+// Bolts leave this far in from either end of the paddle.
+constexpr float MUZZLE_INSET = 6.0f;
+const sf::Color BOLT_COLOR(255, 80, 255);
+}
+
+ProjectileSystem::ProjectileSystem(std::size_t capacity)
+    : capacity(capacity),
+      x(new float[capacity]), y(new float[capacity]), vy(new float[capacity]),
+      freeSlots(new std::uint32_t[capacity]), live(new std::uint32_t[capacity]),
+      batchX(new float[capacity * BOLT_SEGMENTS]), batchY(new float[capacity * BOLT_SEGMENTS]),
+      batchColor(new std::uint32_t[capacity * BOLT_SEGMENTS])
+{
+    std::fill(batchColor.get(), batchColor.get() + capacity * BOLT_SEGMENTS, BOLT_COLOR.toInteger());
+    clear();
+}
+
+void ProjectileSystem::setCollisionSystem(CollisionSystem* collisionSystem)
+{
+    collisions = collisionSystem;
+}
+
+void ProjectileSystem::clear()
+{
+    count = 0;
+    // Lowest slots on top, so a fresh pool fills from slot 0.
+    freeCount = capacity;
+    for (std::size_t i = 0; i < capacity; ++i)
+    {
+        freeSlots[i] = static_cast<std::uint32_t>(capacity - 1 - i);
+    }
+}
+
+bool ProjectileSystem::spawn(sf::Vector2f origin)
+{
+    if (freeCount == 0) return false;
+
+    const std::uint32_t slot = freeSlots[--freeCount];
+    x[slot] = origin.x;
+    y[slot] = origin.y;
+    vy[slot] = -GAME_STATE.PROJECTILE_SPEED;
+    live[count++] = slot;
+    return true;
+}
+
+void ProjectileSystem::release(std::size_t liveIndex)
+{
+    freeSlots[freeCount++] = live[liveIndex];
+    live[liveIndex] = live[--count];
+}
+
+void ProjectileSystem::update(float deltaTime, ECSManager& ecs)
+{
+    fire(deltaTime, ecs);
+    move(deltaTime, ecs);
+}
+
+// The first shot leaves as soon as the laser is picked up; the cooldown
+// carries the remainder over so the rate holds at any frame rate.
+void ProjectileSystem::fire(float deltaTime, ECSManager& ecs)
+{
+    ecs.forEachComponent<LaserComponent>([&](Entity entity, LaserComponent& laser) {
+        if (laser.fireRate <= 0.0f)
+        {
+            laser.cooldown = 0.0f;
+            return;
+        }
+
+        auto position = ecs.getComponent<PositionComponent>(entity);
+        auto collider = ecs.getComponent<ColliderComponent>(entity);
+        if (!position || !collider) return;
+
+        laser.cooldown -= deltaTime;
+        const float interval = 1.0f / laser.fireRate;
+        while (laser.cooldown <= 0.0f)
+        {
+            laser.cooldown += interval;
+            spawn({position->position.x + MUZZLE_INSET, position->position.y - BOLT_LENGTH});
+            spawn({position->position.x + collider->size.x - MUZZLE_INSET, position->position.y - BOLT_LENGTH});
+        }
+    });
+}
+
+void ProjectileSystem::move(float deltaTime, ECSManager& ecs)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t slot = live[i];
+        y[slot] += vy[slot] * deltaTime;
+    }
+
+    const float bottom = static_cast<float>(GAME_STATE.WINDOW_HEIGHT);
+    for (std::size_t i = 0; i < count;)
+    {
+        const std::uint32_t slot = live[i];
+        if (hitBrick(slot, deltaTime, ecs) || y[slot] + BOLT_LENGTH < 0.0f || y[slot] > bottom)
+        {
+            release(i);
+            continue;
+        }
+        ++i;
+    }
+}
+
+// Queries the spatial index over the box the bolt swept this frame and hits
+// the lowest brick in it, the first one the bolt would have reached.
+bool ProjectileSystem::hitBrick(std::uint32_t slot, float deltaTime, ECSManager& ecs)
+{
+    if (!collisions) return false;
+
+    const sf::Vector2f min{x[slot] - BOLT_WIDTH / 2.0f, y[slot]};
+    const sf::Vector2f max{x[slot] + BOLT_WIDTH / 2.0f, y[slot] + BOLT_LENGTH - vy[slot] * deltaTime};
+
+    Entity target = INVALID_ENTITY;
+    float targetBottom = 0.0f;
+    ecs.queryAABB(min, max, [&](Entity brick) {
+        auto position = ecs.getComponent<PositionComponent>(brick);
+        auto collider = ecs.getComponent<ColliderComponent>(brick);
+        if (!position || !collider) return;
+        const float bottom = position->position.y + collider->size.y;
+        if (target == INVALID_ENTITY || bottom > targetBottom)
+        {
+            target = brick;
+            targetBottom = bottom;
+        }
+    }, ColliderComponent::layerOf(ColliderComponent::Type::Brick));
+    if (target == INVALID_ENTITY) return false;
+
+    collisions->hitBrick(ecs, target, {x[slot], targetBottom});
+    return true;
+}
+
+void ProjectileSystem::render(RenderBackend& target) const
+{
+    if (count == 0) return;
+
+    std::size_t segments = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t slot = live[i];
+        for (std::size_t s = 0; s < BOLT_SEGMENTS; ++s)
+        {
+            batchX[segments] = x[slot];
+            batchY[segments] = y[slot] + BOLT_WIDTH * (static_cast<float>(s) + 0.5f);
+            segments++;
+        }
+    }
+
+    target.drawParticles(batchX.get(), batchY.get(), batchColor.get(), segments, BOLT_WIDTH);
+}
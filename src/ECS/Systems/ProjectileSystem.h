@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../System.h"
+#include "../../Render/RenderBackend.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class CollisionSystem;
+
+// Fixed-capacity pool of laser bolts fired by paddles with a LaserComponent.
+// Like particles, bolts are not ECS entities. Slots are handed out from a
+// free list and tracked in a dense list of live slots, so firing and expiry
+// never allocate; shots beyond capacity are dropped. Bolts are tested
+// against the bricks in the ECS spatial index.
+class ProjectileSystem : public System
+{
+public:
+    explicit ProjectileSystem(std::size_t capacity);
+
+    void setCollisionSystem(CollisionSystem* collisionSystem);
+    // Run after CollisionSystem, which rebuilds the spatial index.
+    void update(float deltaTime, ECSManager& ecs) override;
+    void render(RenderBackend& target) const;
+
+    // Fires one bolt upwards from `origin`; false if the pool is full.
+    bool spawn(sf::Vector2f origin);
+    void clear();
+
+    std::size_t getCount() const { return count; }
+    std::size_t getCapacity() const { return capacity; }
+
+private:
+    void fire(float deltaTime, ECSManager& ecs);
+    void move(float deltaTime, ECSManager& ecs);
+    bool hitBrick(std::uint32_t slot, float deltaTime, ECSManager& ecs);
+    void release(std::size_t liveIndex);
+
+    CollisionSystem* collisions = nullptr;
+
+    std::size_t capacity;
+    std::size_t count = 0;
+    std::size_t freeCount = 0;
+
+    // Indexed by slot.
+    std::unique_ptr<float[]> x;
+    std::unique_ptr<float[]> y;
+    std::unique_ptr<float[]> vy;
+    // Free slots, used as a stack.
+    std::unique_ptr<std::uint32_t[]> freeSlots;
+    // Slots in flight, [0, count).
+    std::unique_ptr<std::uint32_t[]> live;
+
+    // Render batch: each bolt is a column of squares.
+    mutable std::unique_ptr<float[]> batchX;
+    mutable std::unique_ptr<float[]> batchY;
+    std::unique_ptr<std::uint32_t[]> batchColor;
+};
@@ -1,15 +1,15 @@
 #pragma once
 
 #include "../System.h"
-#include <SFML/Graphics.hpp>
+#include "../../Render/RenderBackend.h"
 
 class RenderSystem : public System
 {
 public:
-    void setWindow(sf::RenderWindow* window);
+    void setBackend(RenderBackend* backend);
     void update(float deltaTime, ECSManager& ecs) override;
 
 private:
-    sf::RenderWindow* window = nullptr;
+    RenderBackend* backend = nullptr;
 };
 
@@ -0,0 +1,253 @@
+#include "WorldSerializer.h"
+#include "ECSManager.h"
+#include "Components.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace
+{
+template<typename Field>
+using FieldType = std::remove_cvref_t<typename Field::Type>;
+
+template<typename T, typename Field>
+void writeColumn(BinaryWriter& writer, const std::vector<const T*>& components, const Field& field)
+{
+    using Member = FieldType<Field>;
+
+    writer.writeString(field.name);
+    if constexpr (std::is_trivially_copyable_v<Member>)
+    {
+        const std::uint64_t byteSize = components.size() * sizeof(Member);
+        writer.write(static_cast<std::uint32_t>(sizeof(Member)));
+        writer.write(byteSize);
+
+        std::size_t offset = writer.reserve(byteSize);
+        for (const T* component : components)
+        {
+            writer.patch(offset, component->*field.pointer);
+            offset += sizeof(Member);
+        }
+    }
+    else
+    {
+        writer.write(std::uint32_t{0});
+        const std::size_t sizeOffset = writer.reserve(sizeof(std::uint64_t));
+        const std::size_t start = writer.size();
+        for (const T* component : components)
+        {
+            FieldCodec<Member>::write(writer, component->*field.pointer);
+        }
+        writer.patch(sizeOffset, static_cast<std::uint64_t>(writer.size() - start));
+    }
+}
+
+template<typename T>
+void writePool(const ECSManager& ecs, BinaryWriter& writer, const std::unordered_map<Entity, Entity>* renames)
+{
+    std::vector<Entity> entities;
+    std::vector<const T*> components;
+    entities.reserve(ecs.getComponentCount<T>());
+    components.reserve(ecs.getComponentCount<T>());
+    ecs.forEachComponent<T>([&](Entity entity, const T& component)
+    {
+        Entity written = entity;
+        if (renames)
+        {
+            auto it = renames->find(entity);
+            if (it != renames->end()) written = it->second;
+        }
+        entities.push_back(written);
+        components.push_back(&component);
+    });
+
+    constexpr auto& fields = ComponentFields<T>::fields;
+    writer.writeString(ComponentFields<T>::name);
+    writer.write(static_cast<std::uint32_t>(entities.size()));
+    writer.write(static_cast<std::uint32_t>(std::tuple_size_v<std::remove_cvref_t<decltype(fields)>>));
+    writer.writeBytes(entities.data(), entities.size() * sizeof(Entity));
+
+    std::apply([&](const auto&... field) { (writeColumn(writer, components, field), ...); }, fields);
+}
+
+template<typename T, typename Field>
+bool readColumn(const Field& field, std::uint32_t elementSize, std::span<const std::byte> column,
+                std::vector<T>& components)
+{
+    using Member = FieldType<Field>;
+
+    if constexpr (std::is_trivially_copyable_v<Member>)
+    {
+        if (elementSize != sizeof(Member) || column.size() != components.size() * sizeof(Member)) return false;
+
+        const std::byte* source = column.data();
+        for (T& component : components)
+        {
+            std::memcpy(&(component.*field.pointer), source, sizeof(Member));
+            source += sizeof(Member);
+        }
+        return true;
+    }
+    else
+    {
+        if (elementSize != 0) return false;
+
+        BinaryReader reader(column);
+        for (T& component : components)
+        {
+            if (!FieldCodec<Member>::read(reader, component.*field.pointer)) return false;
+        }
+        return true;
+    }
+}
+
+struct FieldHeader
+{
+    std::string name;
+    std::uint32_t elementSize = 0;
+    std::span<const std::byte> column;
+};
+
+bool readFieldHeader(BinaryReader& reader, FieldHeader& header)
+{
+    std::uint64_t byteSize = 0;
+    return reader.readString(header.name) && reader.read(header.elementSize) && reader.read(byteSize) &&
+           byteSize <= reader.remaining() && reader.view(static_cast<std::size_t>(byteSize), header.column);
+}
+
+// Decodes the pool into one block of components and adds it with a single
+// ECSManager::addComponents().
+template<typename T>
+bool readPool(BinaryReader& reader, std::span<const std::byte> entityIds, std::uint32_t fieldCount,
+              ECSManager& ecs, std::unordered_map<Entity, Entity>& remap)
+{
+    const std::size_t count = entityIds.size() / sizeof(Entity);
+    std::vector<T> components(count);
+
+    for (std::uint32_t i = 0; i < fieldCount; ++i)
+    {
+        FieldHeader header;
+        if (!readFieldHeader(reader, header)) return false;
+
+        bool applied = false;
+        std::apply([&](const auto&... field)
+        {
+            ((applied = applied || (field.name == header.name &&
+                                    readColumn(field, header.elementSize, header.column, components))), ...);
+        }, ComponentFields<T>::fields);
+    }
+
+    std::vector<Entity> entities(count);
+    std::memcpy(entities.data(), entityIds.data(), count * sizeof(Entity));
+    remap.reserve(std::max(remap.size(), count));
+    for (Entity& entity : entities)
+    {
+        auto [it, inserted] = remap.try_emplace(entity, INVALID_ENTITY);
+        if (inserted)
+        {
+            it->second = ecs.createEntity();
+        }
+        entity = it->second;
+    }
+
+    ecs.reserveComponents<T>(ecs.getComponentCount<T>() + count);
+    ecs.addComponents(std::span<const Entity>(entities), std::move(components));
+    return true;
+}
+
+bool skipPool(BinaryReader& reader, std::uint32_t fieldCount)
+{
+    for (std::uint32_t i = 0; i < fieldCount; ++i)
+    {
+        FieldHeader header;
+        if (!readFieldHeader(reader, header)) return false;
+    }
+    return true;
+}
+
+template<typename... Ts>
+void writePools(ComponentList<Ts...>, const ECSManager& ecs, BinaryWriter& writer,
+                const std::unordered_map<Entity, Entity>* renames)
+{
+    writer.write(static_cast<std::uint32_t>(sizeof...(Ts)));
+    (writePool<Ts>(ecs, writer, renames), ...);
+}
+
+template<typename... Ts>
+bool readMatchingPool(ComponentList<Ts...>, const std::string& name, BinaryReader& reader,
+                      std::span<const std::byte> entityIds, std::uint32_t fieldCount,
+                      ECSManager& ecs, std::unordered_map<Entity, Entity>& remap)
+{
+    bool matched = false;
+    bool ok = true;
+    ((!matched && name == ComponentFields<Ts>::name
+          ? (matched = true, ok = readPool<Ts>(reader, entityIds, fieldCount, ecs, remap))
+          : false), ...);
+    return matched ? ok : skipPool(reader, fieldCount);
+}
+
+template<typename T>
+bool validatePool(const ECSManager& ecs)
+{
+    if constexpr (ValidatedComponent<T>)
+    {
+        bool valid = true;
+        ecs.forEachComponent<T>([&](Entity, const T& component)
+        {
+            valid = valid && ComponentFields<T>::validate(component);
+        });
+        return valid;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+template<typename... Ts>
+bool validatePools(ComponentList<Ts...>, const ECSManager& ecs)
+{
+    return (validatePool<Ts>(ecs) && ...);
+}
+}
+
+void WorldSerializer::writeWorld(const ECSManager& ecs, std::vector<std::byte>& out,
+                                 const std::unordered_map<Entity, Entity>* renames)
+{
+    BinaryWriter writer(out);
+    writePools(ReflectedComponents{}, ecs, writer, renames);
+}
+
+bool WorldSerializer::readWorld(std::span<const std::byte> data, ECSManager& ecs,
+                                std::unordered_map<Entity, Entity>& remap)
+{
+    BinaryReader reader(data);
+
+    std::uint32_t poolCount = 0;
+    if (!reader.read(poolCount)) return false;
+
+    for (std::uint32_t pool = 0; pool < poolCount; ++pool)
+    {
+        std::string name;
+        std::uint32_t count = 0;
+        std::uint32_t fieldCount = 0;
+        std::span<const std::byte> entityIds;
+        if (!reader.readString(name) || !reader.read(count) || !reader.read(fieldCount) ||
+            !reader.view(static_cast<std::size_t>(count) * sizeof(Entity), entityIds))
+        {
+            return false;
+        }
+
+        if (!readMatchingPool(ReflectedComponents{}, name, reader, entityIds, fieldCount, ecs, remap))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WorldSerializer::validateWorld(const ECSManager& ecs)
+{
+    return validatePools(ReflectedComponents{}, ecs);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Entity.h"
+#include <cstddef>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+class ECSManager;
+
+// Generic ECS snapshot built from the ComponentFields traits in Components.h.
+//
+// Layout (little-endian):
+//   u32 poolCount
+//   per pool:  string name, u32 count, u32 fieldCount, Entity[count]
+//   per field: string name, u32 elementSize, u64 byteSize, column bytes
+//
+// Columns are structure-of-arrays: one contiguous run of `count` values per
+// field. elementSize is 0 for fields written through a FieldCodec. Pools and
+// fields are matched by name on load; unknown ones are skipped and missing
+// ones keep their default-constructed value, so traits can grow without
+// breaking older snapshots.
+class WorldSerializer
+{
+public:
+    // `renames`, if given, maps entities in `ecs` to the ids written out.
+    static void writeWorld(const ECSManager& ecs, std::vector<std::byte>& out,
+                           const std::unordered_map<Entity, Entity>* renames = nullptr);
+
+    // Adds the snapshot's components to `ecs` under freshly created entities.
+    // `remap` receives saved entity id -> new entity id.
+    static bool readWorld(std::span<const std::byte> data, ECSManager& ecs,
+                          std::unordered_map<Entity, Entity>& remap);
+
+    // Runs the ComponentFields validate hooks over every component in `ecs`.
+    // Loads call it before using a restored world.
+    static bool validateWorld(const ECSManager& ecs);
+};
@@ -3,60 +3,75 @@
 
 #include "GameState.h"
 
+Prefab EntityFactory::platformPrefab(float width, float height)
+{
+    ShapeComponent shape(ShapeComponent::Type::Rectangle, sf::Color::White);
+    shape.rectangle.width = width;
+    shape.rectangle.height = height;
+
+    Prefab prefab;
+    prefab.with(PositionComponent())
+          .with(VelocityComponent(0.0f, 0.0f, 0.0f))
+          .with(shape)
+          .with(ColliderComponent(ColliderComponent::Type::Platform, width, height))
+          .with(InputComponent())
+          .with(LaserComponent());
+    return prefab;
+}
+
+Prefab EntityFactory::ballPrefab(float radius)
+{
+    ShapeComponent shape(ShapeComponent::Type::Circle, sf::Color::Green);
+    shape.circle.radius = radius;
+
+    Prefab prefab;
+    prefab.with(PositionComponent())
+          .with(VelocityComponent(GAME_STATE.BALL_INITIAL_VELOCITY_X, GAME_STATE.BALL_INITIAL_VELOCITY_Y, 0.0f))
+          .with(shape)
+          .with(ColliderComponent(ColliderComponent::Type::Ball, radius));
+    return prefab;
+}
+
+Prefab EntityFactory::brickPrefab(float width, float height, sf::Color color, int hitPoints)
+{
+    ShapeComponent shape(ShapeComponent::Type::Rectangle, color);
+    shape.rectangle.width = width;
+    shape.rectangle.height = height;
+
+    Prefab prefab;
+    prefab.with(PositionComponent())
+          .with(VelocityComponent(0.0f, 0.0f, 0.0f))
+          .with(shape)
+          .with(ColliderComponent(ColliderComponent::Type::Brick, width, height))
+          .with(DurableBrick(hitPoints));
+    return prefab;
+}
+
 Entity EntityFactory::createPlatform(ECSManager& ecs, float x, float y, float width, float height)
 {
-    Entity entity = ecs.createEntity();
-
-    
-    ecs.addComponent<PositionComponent>(entity, std::make_shared<PositionComponent>(x, y));
-    ecs.addComponent<VelocityComponent>(entity, std::make_shared<VelocityComponent>(0.0f, 0.0f, 0.0f));
-    ecs.addComponent<ShapeComponent>(entity, std::make_shared<ShapeComponent>(
-        ShapeComponent::Type::Rectangle, sf::Color::White));
-    ecs.getComponent<ShapeComponent>(entity)->rectangle.width = width;
-    ecs.getComponent<ShapeComponent>(entity)->rectangle.height = height;
-    ecs.addComponent<ColliderComponent>(entity, std::make_shared<ColliderComponent>(
-        ColliderComponent::Type::Platform, width, height));
-    ecs.addComponent<InputComponent>(entity, std::make_shared<InputComponent>());
-
-    return entity;
+    return platformPrefab(width, height).instantiate(ecs, 1, [&](PrefabInstance& platform)
+    {
+        platform.get<PositionComponent>().position = {x, y};
+    });
 }
 
 Entity EntityFactory::createBall(ECSManager& ecs, float x, float y, float radius)
 {
-    Entity entity = ecs.createEntity();
-
-    
-    ecs.addComponent<PositionComponent>(entity, std::make_shared<PositionComponent>(x, y));
-    ecs.addComponent<VelocityComponent>(entity, std::make_shared<VelocityComponent>(GAME_STATE.BALL_INITIAL_VELOCITY_X, GAME_STATE.BALL_INITIAL_VELOCITY_Y, 0.0f));
-    ecs.addComponent<ShapeComponent>(entity, std::make_shared<ShapeComponent>(
-        ShapeComponent::Type::Circle, sf::Color::Green));
-    ecs.getComponent<ShapeComponent>(entity)->circle.radius = radius;
-    ecs.addComponent<ColliderComponent>(entity, std::make_shared<ColliderComponent>(
-        ColliderComponent::Type::Ball, radius));
-
-    return entity;
+    return ballPrefab(radius).instantiate(ecs, 1, [&](PrefabInstance& ball)
+    {
+        ball.get<PositionComponent>().position = {x, y};
+    });
 }
 
 Entity EntityFactory::createBrick(ECSManager& ecs, float x, float y, float width, float height, sf::Color color, int hitPoints, bool hasBonus, BonusType bonusType)
 {
-    Entity entity = ecs.createEntity();
-
-    
-    ecs.addComponent<PositionComponent>(entity, std::make_shared<PositionComponent>(x, y));
-    ecs.addComponent<VelocityComponent>(entity, std::make_shared<VelocityComponent>(0.0f, 0.0f, 0.0f));
-    ecs.addComponent<ShapeComponent>(entity, std::make_shared<ShapeComponent>(
-        ShapeComponent::Type::Rectangle, color));
-    ecs.getComponent<ShapeComponent>(entity)->rectangle.width = width;
-    ecs.getComponent<ShapeComponent>(entity)->rectangle.height = height;
-    ecs.addComponent<ColliderComponent>(entity, std::make_shared<ColliderComponent>(
-        ColliderComponent::Type::Brick, width, height));
-    ecs.addComponent<DurableBrick>(entity, std::make_shared<DurableBrick>(hitPoints));
-
-    
+    Prefab prefab = brickPrefab(width, height, color, hitPoints);
     if (hasBonus)
     {
-        ecs.addComponent<BonusComponent>(entity, std::make_shared<BonusComponent>(bonusType));
+        prefab.with(BonusComponent(bonusType));
     }
-
-    return entity;
+    return prefab.instantiate(ecs, 1, [&](PrefabInstance& brick)
+    {
+        brick.get<PositionComponent>().position = {x, y};
+    });
 }
@@ -3,6 +3,7 @@
 #include "ECS/Entity.h"
 #include "ECS/ECSManager.h"
 #include "ECS/Components.h"
+#include "ECS/Prefab.h"
 #include <SFML/Graphics.hpp>
 
 class EntityFactory
@@ -11,5 +12,10 @@ public:
     static Entity createPlatform(ECSManager& ecs, float x, float y, float width, float height);
     static Entity createBall(ECSManager& ecs, float x, float y, float radius);
     static Entity createBrick(ECSManager& ecs, float x, float y, float width, float height, sf::Color color = sf::Color::Red, int hitPoints = 1, bool hasBonus = false, BonusType bonusType = BonusType::SlowBall);
-};
 
+    // Prototypes the functions above clone. Positions are left at the
+    // origin for the caller to set per instance.
+    static Prefab platformPrefab(float width, float height);
+    static Prefab ballPrefab(float radius);
+    static Prefab brickPrefab(float width, float height, sf::Color color = sf::Color::Red, int hitPoints = 1);
+};
@@ -0,0 +1,233 @@
+#include "FileIO.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        std::swap(bytes, other.bytes);
+        std::swap(length, other.length);
+#ifdef _WIN32
+        std::swap(fileHandle, other.fileHandle);
+        std::swap(mappingHandle, other.mappingHandle);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = static_cast<const std::byte*>(view);
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    bytes = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+}
+
+static bool writeAll(HANDLE file, const void* data, std::size_t size)
+{
+    const auto* cursor = static_cast<const char*>(data);
+    bool ok = true;
+    while (ok && size > 0)
+    {
+        DWORD chunk = size > 0x40000000u ? 0x40000000u : static_cast<DWORD>(size);
+        DWORD written = 0;
+        ok = WriteFile(file, cursor, chunk, &written, nullptr) && written > 0;
+        cursor += written;
+        size -= written;
+    }
+    return ok;
+}
+
+bool writeWholeFile(const std::string& filename, const void* data, std::size_t size)
+{
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    bool ok = writeAll(file, data, size);
+    CloseHandle(file);
+    return ok;
+}
+
+bool appendToFile(const std::string& filename, const void* data, std::size_t size)
+{
+    HANDLE file = CreateFileA(filename.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    bool ok = writeAll(file, data, size) && FlushFileBuffers(file);
+    CloseHandle(file);
+    return ok;
+}
+
+bool replaceFileAtomically(const std::string& filename, const void* data, std::size_t size)
+{
+    const std::string tempName = filename + ".tmp";
+    HANDLE file = CreateFileA(tempName.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    bool ok = writeAll(file, data, size) && FlushFileBuffers(file);
+    CloseHandle(file);
+
+    ok = ok && MoveFileExA(tempName.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (!ok) DeleteFileA(tempName.c_str());
+    return ok;
+}
+#else
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    bytes = static_cast<const std::byte*>(view);
+    length = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (bytes) munmap(const_cast<std::byte*>(bytes), length);
+    bytes = nullptr;
+    length = 0;
+}
+
+// One write() in practice; the loop only covers short writes.
+static bool writeAll(int fd, const void* data, std::size_t size)
+{
+    const auto* cursor = static_cast<const char*>(data);
+    bool ok = true;
+    while (ok && size > 0)
+    {
+        ssize_t written = ::write(fd, cursor, size);
+        ok = written > 0;
+        if (ok)
+        {
+            cursor += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+    return ok;
+}
+
+bool writeWholeFile(const std::string& filename, const void* data, std::size_t size)
+{
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    bool ok = writeAll(fd, data, size);
+    return ::close(fd) == 0 && ok;
+}
+
+bool appendToFile(const std::string& filename, const void* data, std::size_t size)
+{
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return false;
+
+    bool ok = writeAll(fd, data, size) && ::fsync(fd) == 0;
+    return ::close(fd) == 0 && ok;
+}
+
+bool replaceFileAtomically(const std::string& filename, const void* data, std::size_t size)
+{
+    const std::string tempName = filename + ".tmp";
+    int fd = ::open(tempName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    bool ok = writeAll(fd, data, size) && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    ok = ok && ::rename(tempName.c_str(), filename.c_str()) == 0;
+    if (!ok)
+    {
+        ::unlink(tempName.c_str());
+        return false;
+    }
+
+    // Persist the rename itself.
+    const std::size_t slash = filename.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : filename.substr(0, slash + 1);
+    int dirFd = ::open(directory.c_str(), O_RDONLY);
+    if (dirFd >= 0)
+    {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+}
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& filename);
+    void close();
+
+    const std::byte* data() const { return bytes; }
+    std::size_t size() const { return length; }
+    bool isOpen() const { return bytes != nullptr; }
+
+private:
+    const std::byte* bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// Replaces the file contents with a single write call.
+bool writeWholeFile(const std::string& filename, const void* data, std::size_t size);
+
+// Appends and flushes to disk, creating the file if needed.
+bool appendToFile(const std::string& filename, const void* data, std::size_t size);
+
+// Writes `filename`.tmp, flushes it to disk and renames it over `filename`.
+// A crash at any point leaves either the old or the new file, never a mix.
+bool replaceFileAtomically(const std::string& filename, const void* data, std::size_t size);
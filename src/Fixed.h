@@ -0,0 +1,88 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+
+// Signed fixed-point number with FractionBits fraction bits, computed in
+// integers only, so every operation gives the same bits on every compiler,
+// platform and optimization level. The value is held in 64 bits: at 16
+// fraction bits that leaves room for the squared speeds of a speed
+// normalization and the shifted dividends of a division without a wider
+// intermediate type.
+//
+// Products round to nearest and quotients towards zero. Conversions to and
+// from float scale by a power of two in double, which is exact, so they
+// are deterministic too.
+template<int FractionBits>
+class Fixed
+{
+    static_assert(FractionBits > 0 && FractionBits <= 24, "Fixed needs 1 to 24 fraction bits");
+
+public:
+    static constexpr std::int64_t ONE = std::int64_t(1) << FractionBits;
+
+    constexpr Fixed() = default;
+    // Rounds half away from zero. Scaling a float by a power of two and
+    // adding a half are both exact in double, so only the truncation rounds.
+    explicit constexpr Fixed(float value)
+        : raw(static_cast<std::int64_t>(static_cast<double>(value) * SCALE + (value < 0.0f ? -0.5 : 0.5))) {}
+
+    static constexpr Fixed fromRaw(std::int64_t raw)
+    {
+        Fixed value;
+        value.raw = raw;
+        return value;
+    }
+
+    explicit constexpr operator float() const
+    {
+        return static_cast<float>(static_cast<double>(raw) / SCALE);
+    }
+
+    constexpr std::int64_t getRaw() const { return raw; }
+
+    constexpr Fixed operator-() const { return fromRaw(-raw); }
+    constexpr Fixed operator+(Fixed other) const { return fromRaw(raw + other.raw); }
+    constexpr Fixed operator-(Fixed other) const { return fromRaw(raw - other.raw); }
+    constexpr Fixed operator*(Fixed other) const
+    {
+        return fromRaw((raw * other.raw + (ONE >> 1)) >> FractionBits);
+    }
+    constexpr Fixed operator/(Fixed other) const { return fromRaw((raw << FractionBits) / other.raw); }
+    constexpr Fixed& operator+=(Fixed other) { return *this = *this + other; }
+    constexpr Fixed& operator-=(Fixed other) { return *this = *this - other; }
+    constexpr Fixed& operator*=(Fixed other) { return *this = *this * other; }
+
+    constexpr auto operator<=>(const Fixed&) const = default;
+
+    friend constexpr Fixed abs(Fixed value) { return value.raw < 0 ? -value : value; }
+
+    // Rounded down; negative values give 0.
+    friend constexpr Fixed sqrt(Fixed value)
+    {
+        if (value.raw <= 0) return Fixed();
+        std::uint64_t remainder = static_cast<std::uint64_t>(value.raw) << FractionBits;
+        std::uint64_t root = 0;
+        std::uint64_t bit = std::uint64_t(1) << 62;
+        while (bit > remainder) bit >>= 2;
+        while (bit != 0)
+        {
+            if (remainder >= root + bit)
+            {
+                remainder -= root + bit;
+                root = (root >> 1) + bit;
+            }
+            else
+            {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        return fromRaw(static_cast<std::int64_t>(root));
+    }
+
+private:
+    static constexpr double SCALE = static_cast<double>(ONE);
+
+    std::int64_t raw = 0;
+};
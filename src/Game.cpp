@@ -1,14 +1,20 @@
 #include <cmath>
-#include <random>
+#include <cstdlib>
 #include <stdexcept>
 #include <iostream>
 
 #include "GameState.h"
 #include "ECS/Components.h"
+#include "ECS/StatModifiers.h"
 #include "ECS/Systems/BallSpeedSystem.h"
+#include "BakedAssets.h"
+#include "BonusTable.h"
 #include "EntityFactory.h"
+#include "LevelLoader.h"
+#include "Physics.h"
 #include "Game.h"
 #include "SaveSystem.h"
+#include "FileIO.h"
 #include "SFML/Graphics/RectangleShape.hpp"
 #include "SFML/System/Vector2.hpp"
 
@@ -24,9 +30,11 @@ EventType getEventType(const sf::Event &event) {
   return EventType::Unknown;
 }
 
-Game::Game()
+Game::Game(const GameOptions &options)
     : window(sf::VideoMode({GAME_STATE.WINDOW_WIDTH, GAME_STATE.WINDOW_HEIGHT}),
-             GAME_STATE.WINDOW_TITLE) {
+             GAME_STATE.WINDOW_TITLE),
+      timers(GAME_STATE.TIMER_TICKS_PER_SECOND),
+      saveSlots(GAME_STATE.SAVE_INDEX_FILENAME) {
   if (!window.isOpen()) {
     throw std::runtime_error("Failed to create window");
   }
@@ -48,8 +56,28 @@ Game::Game()
   renderSystem = std::make_shared<RenderSystem>();
   resizeSystem = std::make_shared<ResizeSystem>();
   ballSpeedSystem = std::make_shared<BallSpeedSystem>();
-
-  renderSystem->setWindow(&window);
+  particleSystem = std::make_shared<ParticleSystem>(GAME_STATE.PARTICLE_CAPACITY);
+  projectileSystem = std::make_shared<ProjectileSystem>(GAME_STATE.PROJECTILE_CAPACITY);
+
+  renderBackend = std::make_unique<SfmlRenderBackend>(window);
+  renderThread = std::make_unique<RenderThread>(*renderBackend, &window);
+  collisionSystem->setParticleSystem(particleSystem.get());
+  collisionSystem->setTimers(&timers);
+  collisionSystem->setBallSpeedSystem(ballSpeedSystem.get());
+  projectileSystem->setCollisionSystem(collisionSystem.get());
+  ballSpeedSystem->setTimers(&timers);
+  restoreRandom(options.seed ? *options.seed : RandomService::randomSeed(), 0);
+  std::cout << "Seed: " << random.getSeed() << std::endl;
+  if (options.autoplay) {
+    autoplay = std::make_unique<AutoplayController>(
+        options.autoplaySkill.value_or(GAME_STATE.AUTOPLAY_SKILL),
+        options.autoplayReactionDelay.value_or(GAME_STATE.AUTOPLAY_REACTION_DELAY),
+        random.stream("autoplay"));
+    inputSystem->setController(autoplay.get());
+  }
+  if (GAME_STATE.JOURNALED_SAVES) {
+    collisionSystem->setJournal(&journal);
+  }
   resizeSystem->setWindow(&window);
 
   
@@ -59,34 +87,74 @@ Game::Game()
   ecs.addSystem(resizeSystem);
   ecs.addSystem(renderSystem);
   ecs.addSystem(ballSpeedSystem);
+  ecs.addSystem(particleSystem);
+  ecs.addSystem(projectileSystem);
 
   
   initializeGameObjects();
 
    
-   if (!font.openFromFile("C:/Windows/Fonts/arial.ttf")) {
-     
-     if (!font.openFromFile("C:/Windows/Fonts/calibri.ttf")) {
-       
+   if (const char* user = std::getenv("USER")) {
+     GAME_STATE.playerName = user;
+   } else if (const char* user = std::getenv("USERNAME")) {
+     GAME_STATE.playerName = user;
+   }
+
+   // The menu shows up right away; bricks, text and scores appear as their
+   // resources finish loading (see updateResources).
+   resources.start();
+   font = resources.loadFont(GAME_STATE.FONT_NAME);
+   if (!options.marathonLevel.empty()) {
+     if (!marathon.open(options.marathonLevel, random.stream("marathon"),
+                        GAME_STATE.SCROLL_FLOOR_Y, GAME_STATE.SCROLL_SPEED)) {
+       throw std::runtime_error("Failed to open level " + options.marathonLevel);
      }
+     recreateBricks();
    }
+   level = requestLevel(GAME_STATE.currentLevel);
+   scores = resources.loadScores(GAME_STATE.HIGH_SCORES_FILENAME,
+                                 GAME_STATE.LEGACY_HIGH_SCORES_FILENAME,
+                                 GAME_STATE.playerName);
 
-   
-   GAME_STATE.loadHighScores("highscores.txt");
+   renderThread->start();
+   autosaveWorker.start();
+
+   saveSlots.open(GAME_STATE.SAVE_SLOT_COUNT);
+   selectSaveSlot(0);
 }
 
 void Game::run() {
   while (window.isOpen()) {
+    if (gameMode != meteredMode) {
+      reportCpuUsage();
+    }
+
+    if (autoplay) {
+      autoplayMenus();
+    }
+
+    if (GAME_STATE.IDLE_STATIC_SCREENS && isStaticScreen()) {
+      runIdleFrame();
+      continue;
+    }
+
     
     float deltaTime = clock.restart().asSeconds();
 
+    updateResources();
     handleEvents();
 
     
-    if (gameMode == GameMode::Playing && countRemainingBricks() == 0) {
+    if (gameMode == GameMode::Playing && countRemainingBricks() == 0 &&
+        (!marathon.isOpen() || marathon.isFinished())) {
+      if (!GAME_STATE.getLeaderboard()) {
+        resources.wait(scores);
+        GAME_STATE.setLeaderboard(scores.get());
+      }
       GAME_STATE.submitCurrentScore();
       gameMode = GameMode::Victory;
       victoryChoiceYes = true;
+      nextLevel = requestLevel(nextLevelNumber());
     }
 
     
@@ -94,50 +162,37 @@ void Game::run() {
         ball != INVALID_ENTITY &&
         (collisionSystem->isBallOutOfBounds(ball, ecs))) {
       isRestarting = true;
-      restartTimer.restart();
+      restartTimer = timers.schedule(
+          timers.toTicks(GAME_STATE.RESTART_PAUSE_TIME_SECONDS),
+          [this] { finishRestart(); });
     }
 
     
     if (isRestarting) {
-      if (restartTimer.getElapsedTime().asSeconds() >=
-          GAME_STATE.RESTART_PAUSE_TIME_SECONDS) {
-        
-        auto platformPos = ecs.getComponent<PositionComponent>(platform);
-        auto ballPos = ecs.getComponent<PositionComponent>(ball);
-        auto ballVelocity = ecs.getComponent<VelocityComponent>(ball);
-
-        if (platformPos) {
-          platformPos->position.x = GAME_STATE.PLATFORM_START_X;
-          platformPos->position.y = GAME_STATE.PLATFORM_START_Y;
-        }
-
-        if (ballPos && ballVelocity) {
-          ballPos->position.x = GAME_STATE.BALL_START_X;
-          ballPos->position.y = GAME_STATE.BALL_START_Y;
-          ballVelocity->velocity = {GAME_STATE.BALL_INITIAL_VELOCITY_X,
-                                    GAME_STATE.BALL_INITIAL_VELOCITY_Y};
-          
-          ballVelocity->speed =
-              std::sqrt(ballVelocity->velocity.x * ballVelocity->velocity.x +
-                        ballVelocity->velocity.y * ballVelocity->velocity.y);
-
-          
-          ballSpeedSystem->reset();
-        }
-
-        recreateBricks();
-
-        isRestarting = false;
-      } else {
-
-        deltaTime = 0.0f;
-      }
+      advanceTimers(deltaTime);
+      deltaTime = 0.0f;
     }
 
     
     
     if (gameMode == GameMode::Playing && !isRestarting) {
       update(deltaTime);
+
+      if (GAME_STATE.JOURNALED_SAVES &&
+          journalFlushTimer.getElapsedTime().asSeconds() >=
+              GAME_STATE.JOURNAL_FLUSH_INTERVAL_SECONDS) {
+        flushJournal();
+      }
+
+      if (autosaveTimer.getElapsedTime().asSeconds() >=
+              GAME_STATE.AUTOSAVE_INTERVAL_SECONDS &&
+          autosaveWorker.isIdle() && !marathon.isOpen()) {
+        if (GAME_STATE.JOURNALED_SAVES && journalValid) {
+          compactJournal();
+        } else {
+          requestSave();
+        }
+      }
     }
 
     render();
@@ -150,116 +205,393 @@ void Game::run() {
   }
 }
 
+// Autoplay starts the game as soon as the level is in and plays on after
+// every victory.
+void Game::autoplayMenus() {
+  if (gameMode == GameMode::MainMenu && (marathon.isOpen() || !bricks.empty())) {
+    resetGame();
+  } else if (gameMode == GameMode::Victory &&
+             (nextLevel.isReady() || nextLevel.hasFailed())) {
+    advanceLevel();
+    resetGame();
+  }
+}
+
+bool Game::isStaticScreen() const {
+  return gameMode == GameMode::MainMenu || gameMode == GameMode::Victory;
+}
+
+void Game::runIdleFrame() {
+  const bool animating =
+      particleSystem->getCount() > 0 || resources.isLoading();
+  const float timeout = animating ? GAME_STATE.FRAME_TIME
+                                  : GAME_STATE.IDLE_WAIT_TIMEOUT_SECONDS;
+
+  if (const auto event = window.waitEvent(sf::seconds(timeout))) {
+    handleEvent(*event);
+    handleEvents();
+  }
+
+  float deltaTime = clock.restart().asSeconds();
+  if (animating) {
+    particleSystem->update(deltaTime, ecs);
+    redrawRequested = true;
+  }
+  updateResources();
+
+  if (window.isOpen() && (redrawRequested || gameMode != renderedMode)) {
+    render();
+  }
+}
+
+void Game::reportCpuUsage() {
+  static const char *modeNames[] = {"Playing", "Victory", "MainMenu"};
+  std::cout << "[PERF] " << modeNames[static_cast<int>(meteredMode)] << ": "
+            << cpuMeter.getCpuPercent() << "% CPU over "
+            << cpuMeter.getElapsedSeconds() << " s, " << meteredFrames
+            << " frames drawn" << std::endl;
+  meteredMode = gameMode;
+  meteredFrames = 0;
+  cpuMeter.restart();
+}
+
+// Hooks up resources that finished loading since the last frame.
+void Game::updateResources() {
+  if (!resources.update()) {
+    return;
+  }
+  redrawRequested = true;
+
+  if (font.isReady()) {
+    renderBackend->setFont(&font->font);
+  }
+  if (scores.isReady()) {
+    GAME_STATE.setLeaderboard(scores.get());
+  }
+  if (gameMode == GameMode::MainMenu && bricks.empty() && level.isReady() &&
+      !marathon.isOpen()) {
+    recreateBricks();
+  }
+}
+
+// Moves on to the level prefetched during the victory screen.
+void Game::advanceLevel() {
+  if (!nextLevel.isValid() || nextLevel.hasFailed()) {
+    return;
+  }
+  GAME_STATE.currentLevel = nextLevelNumber();
+  level = std::move(nextLevel);
+  resources.collectUnused();
+}
+
+int Game::nextLevelNumber() const {
+  if (GAME_STATE.ENDLESS_LEVELS) {
+    return GAME_STATE.currentLevel + 1;
+  }
+  return GAME_STATE.currentLevel % BakedAssets::getLevelCount() + 1;
+}
+
+// Baked levels first; past them each level is generated from its own
+// substream of "levels", so a seed always produces the same sequence.
+ResourceHandle<LevelData> Game::requestLevel(int number) {
+  if (number <= BakedAssets::getLevelCount()) {
+    return resources.loadLevel(number);
+  }
+  const float margin = GAME_STATE.LEVEL_MARGIN;
+  const auto params = LevelGenerator::paramsForLevel(
+      number, GAME_STATE.WINDOW_WIDTH - 2.0f * margin, margin, margin);
+  return resources.generateLevel(
+      number, params,
+      random.stream("levels").substream(static_cast<std::uint64_t>(number)));
+}
+
+// Later saves, loads and journal segments go to `slot`. The journal resumes
+// after the slot's last segment; the first save there is a full checkpoint.
+void Game::selectSaveSlot(int slot) {
+  flushJournal();
+  saveSlot = slot;
+  journalValid = false;
+
+  const std::string filename = saveFilename();
+  checkpointSequence = SaveSystem::readJournalSequence(filename);
+  std::uint32_t freeSequence = checkpointSequence;
+  while (SaveJournal::segmentExists(filename, freeSequence)) {
+    ++freeSequence;
+  }
+  journal.setSequence(freeSequence);
+
+  std::cout << "Save slot " << slot << ": ";
+  if (const auto info = saveSlots.getInfo(slot)) {
+    std::cout << "score " << info->score << ", " << info->bricksRemaining
+              << " bricks left" << std::endl;
+  } else {
+    std::cout << "empty" << std::endl;
+  }
+}
+
+std::string Game::saveFilename() const {
+  return SaveSlotManager::slotFilename(saveSlot);
+}
+
+void Game::requestSave() {
+  flushDestroyedBricks();
+  syncBonusTimers();
+  SaveSnapshot snapshot = SaveSystem::captureSave(*this);
+  const SaveSlotInfo info = SaveSlotManager::describe(ecs, snapshot.state.currentScore);
+  const std::uint32_t obsolete = checkpointSequence;
+  if (GAME_STATE.JOURNALED_SAVES) {
+    checkpointSequence = rotateJournal();
+    snapshot.state.journalSequence = checkpointSequence;
+    journalValid = true;
+  }
+
+  const std::string filename = saveFilename();
+  const std::uint32_t sequence = checkpointSequence;
+  autosaveWorker.post([snapshot = std::move(snapshot), info, filename, slot = saveSlot,
+                       slots = &saveSlots, obsolete, sequence] {
+    if (SaveSystem::writeSave(snapshot, filename)) {
+      slots->commit(slot, info);
+      SaveJournal::removeSegments(filename, obsolete, sequence);
+      std::cout << "Game saved!" << std::endl;
+    }
+  });
+  autosaveTimer.restart();
+}
+
+// Starts a new journal segment and returns its sequence. The segment file is
+// created right away so that segments on disk never have gaps.
+std::uint32_t Game::rotateJournal() {
+  flushJournal();
+  journal.setSequence(journal.getSequence() + 1);
+
+  const std::string path = SaveJournal::segmentName(saveFilename(),
+                                                    journal.getSequence());
+  autosaveWorker.post([path] { appendToFile(path, nullptr, 0); });
+  return journal.getSequence();
+}
+
+void Game::flushJournal() {
+  journalFlushTimer.restart();
+  if (!journalValid) {
+    journal.clear();
+  }
+  if (journal.empty()) {
+    return;
+  }
+
+  journal.recordBody(ecs, platform);
+  journal.recordBody(ecs, ball);
+  const std::string path = SaveJournal::segmentName(saveFilename(),
+                                                    journal.getSequence());
+  autosaveWorker.post([frame = journal.takeFrame(), path] {
+    if (!appendToFile(path, frame.data(), frame.size())) {
+      std::cerr << "Failed to append to save journal: " << path << std::endl;
+    }
+  });
+}
+
+void Game::compactJournal() {
+  const std::uint32_t compacted = journal.getSequence();
+  rotateJournal();
+
+  const std::string filename = saveFilename();
+  const std::uint32_t obsolete = checkpointSequence;
+  checkpointSequence = compacted + 1;
+  autosaveWorker.post([filename, slot = saveSlot, slots = &saveSlots, obsolete, compacted] {
+    SaveSlotInfo info{};
+    if (SaveSystem::compactJournal(filename, compacted, &info)) {
+      if (info.used) {
+        slots->commit(slot, info);
+      }
+      SaveJournal::removeSegments(filename, obsolete, compacted + 1);
+    }
+  });
+  autosaveTimer.restart();
+}
+
 void Game::handleEvents() {
   while (const auto event = window.pollEvent()) {
-    switch (getEventType(*event)) {
-    case EventType::Closed:
-      window.close();
-      break;
-    case EventType::Resized:
-      break;
-    case EventType::KeyPressed:
-      switch (gameMode) {
-      case GameMode::Victory: {
-        const auto *keyPressed = event->getIf<sf::Event::KeyPressed>();
-
-        if (keyPressed->code == sf::Keyboard::Key::Left ||
-            keyPressed->code == sf::Keyboard::Key::Right) {
-          victoryChoiceYes = !victoryChoiceYes;
-        } else if (keyPressed->code == sf::Keyboard::Key::Enter ||
-                   keyPressed->code == sf::Keyboard::Key::Space) {
-          if (victoryChoiceYes) {
-            resetGame();
-          } else {
-            exitToMenu();
-          }
-        }
-        break;
-      }
-      case GameMode::MainMenu: {
-        const auto *menuKeyPressed = event->getIf<sf::Event::KeyPressed>();
+    handleEvent(*event);
+  }
+}
 
-        if (menuKeyPressed->code == sf::Keyboard::Key::Enter ||
-            menuKeyPressed->code == sf::Keyboard::Key::Space) {
+void Game::handleEvent(const sf::Event &event) {
+  if (!event.is<sf::Event::MouseMoved>()) {
+    redrawRequested = true;
+  }
+
+  switch (getEventType(event)) {
+  case EventType::Closed:
+    renderThread->stop();
+    window.close();
+    break;
+  case EventType::Resized:
+    break;
+  case EventType::KeyPressed:
+    switch (gameMode) {
+    case GameMode::Victory: {
+      const auto *keyPressed = event.getIf<sf::Event::KeyPressed>();
+
+      if (keyPressed->code == sf::Keyboard::Key::Left ||
+          keyPressed->code == sf::Keyboard::Key::Right) {
+        victoryChoiceYes = !victoryChoiceYes;
+      } else if (keyPressed->code == sf::Keyboard::Key::Enter ||
+                 keyPressed->code == sf::Keyboard::Key::Space) {
+        advanceLevel();
+        if (victoryChoiceYes) {
           resetGame();
+        } else {
+          exitToMenu();
         }
-        break;
       }
-      case GameMode::Playing: {
-        const auto *keyPressed = event->getIf<sf::Event::KeyPressed>();
-        if (keyPressed) {
-          if (keyPressed->code == sf::Keyboard::Key::F5) {
-            
-            if (SaveSystem::saveGame(*this, "savegame.dat")) {
-              
-              std::cout << "Game saved!" << std::endl;
-            } else {
-              std::cerr << "Failed to save game!" << std::endl;
-            }
-          } else if (keyPressed->code == sf::Keyboard::Key::F9) {
-            
-            if (SaveSystem::saveExists("savegame.dat")) {
-              if (SaveSystem::loadGame(*this, "savegame.dat")) {
-                std::cout << "Game loaded!" << std::endl;
-              } else {
-                std::cerr << "Failed to load game!" << std::endl;
+      break;
+    }
+    case GameMode::MainMenu: {
+      const auto *menuKeyPressed = event.getIf<sf::Event::KeyPressed>();
+
+      if (menuKeyPressed->code == sf::Keyboard::Key::Enter ||
+          menuKeyPressed->code == sf::Keyboard::Key::Space) {
+        resetGame();
+      }
+      break;
+    }
+    case GameMode::Playing: {
+      const auto *keyPressed = event.getIf<sf::Event::KeyPressed>();
+      if (keyPressed) {
+        if (marathon.isOpen() &&
+            (keyPressed->code == sf::Keyboard::Key::F5 ||
+             keyPressed->code == sf::Keyboard::Key::F9)) {
+          std::cerr << "Marathon levels cannot be saved" << std::endl;
+        } else if (keyPressed->code == sf::Keyboard::Key::F5) {
+          
+          requestSave();
+        } else if (keyPressed->code == sf::Keyboard::Key::F6) {
+          selectSaveSlot((saveSlot + GAME_STATE.SAVE_SLOT_COUNT - 1) %
+                         GAME_STATE.SAVE_SLOT_COUNT);
+        } else if (keyPressed->code == sf::Keyboard::Key::F7) {
+          selectSaveSlot((saveSlot + 1) % GAME_STATE.SAVE_SLOT_COUNT);
+        } else if (keyPressed->code == sf::Keyboard::Key::F9) {
+          
+          if (saveSlots.hasSave(saveSlot)) {
+            if (SaveSystem::loadGame(*this, saveFilename())) {
+              std::cout << "Game loaded!" << std::endl;
+              if (GAME_STATE.JOURNALED_SAVES) {
+                requestSave();
               }
             } else {
-              std::cerr << "No save file found!" << std::endl;
+              std::cerr << "Failed to load game!" << std::endl;
             }
+          } else {
+            std::cerr << "No save file found!" << std::endl;
           }
         }
-        break;
-      }
       }
       break;
-    case EventType::Unknown:
-    default:
-      break;
     }
+    }
+    break;
+  case EventType::Unknown:
+  default:
+    break;
   }
 }
 
 void Game::update(float deltaTime) {
+  if (autoplay) {
+    autoplay->setBall(ball);
+  }
   inputSystem->update(deltaTime, ecs);
   movementSystem->update(deltaTime, ecs);
   resizeSystem->update(deltaTime, ecs);
   collisionSystem->update(deltaTime, ecs);
+  projectileSystem->update(deltaTime, ecs);
   ballSpeedSystem->update(deltaTime, ecs);
-  updateBonuses(deltaTime);
+  particleSystem->update(deltaTime, ecs);
+  marathon.update(deltaTime, ecs, bricks);
+  advanceTimers(deltaTime);
+}
+
+// Game time runs during play and the restart pause. Ticks are journaled so
+// that replaying a save counts bonuses down by the same amount.
+void Game::advanceTimers(float deltaTime) {
+  if (GAME_STATE.JOURNALED_SAVES) {
+    journal.recordTick(deltaTime);
+  }
+  timers.advanceSeconds(deltaTime);
+}
+
+void Game::finishRestart() {
+  auto platformPos = ecs.getComponent<PositionComponent>(platform);
+  auto ballPos = ecs.getComponent<PositionComponent>(ball);
+  auto ballVelocity = ecs.getComponent<VelocityComponent>(ball);
+
+  if (platformPos) {
+    platformPos->position.x = GAME_STATE.PLATFORM_START_X;
+    platformPos->position.y = GAME_STATE.PLATFORM_START_Y;
+  }
+
+  if (ballPos && ballVelocity) {
+    ballPos->position.x = GAME_STATE.BALL_START_X;
+    ballPos->position.y = GAME_STATE.BALL_START_Y;
+    ballVelocity->velocity = {GAME_STATE.BALL_INITIAL_VELOCITY_X,
+                              GAME_STATE.BALL_INITIAL_VELOCITY_Y};
+    
+    ballVelocity->speed = static_cast<float>(
+        Physics::length(Scalar(ballVelocity->velocity.x), Scalar(ballVelocity->velocity.y)));
+    // A slowed ball comes back slowed.
+    StatModifiers::setBase(ecs, ball, Stat::BallSpeed, ballVelocity->speed);
+
+    
+    ballSpeedSystem->reset();
+    ballSpeedSystem->updateHold(ecs, ball);
+  }
+
+  projectileSystem->clear();
+  recreateBricks();
+
+  isRestarting = false;
 }
 
 void Game::render() {
-  window.clear(sf::Color::Black);
+  RenderSnapshot &snapshot = renderThread->beginFrame();
+  renderSystem->setBackend(&snapshot);
+
+  snapshot.clear(sf::Color::Black);
 
   if (gameMode == GameMode::Playing) {
     renderSystem->update(0.0f, ecs);
-    
-    if (font.getInfo().family != "") {
-        sf::Text scoreText(font);
-        scoreText.setString("Score: " + std::to_string(GAME_STATE.getCurrentScore()));
-        scoreText.setCharacterSize(20);
-        scoreText.setFillColor(sf::Color::White);
-        scoreText.setPosition({GAME_STATE.WINDOW_WIDTH - 150.0f, 10.0f});
-        window.draw(scoreText);
-    }
-    renderBonusTimers();
+    particleSystem->render(snapshot);
+    projectileSystem->render(snapshot);
+    renderScore(snapshot);
+    renderBonusTimers(snapshot);
   } else if (gameMode == GameMode::Victory) {
     renderSystem->update(0.0f, ecs);
-    renderVictoryScreen();
+    renderVictoryScreen(snapshot);
   } else if (gameMode == GameMode::MainMenu) {
     renderSystem->update(0.0f, ecs);
-    renderMainMenuScreen();
+    renderMainMenuScreen(snapshot);
   }
 
-  window.display();
+  renderThread->publish();
+  meteredFrames++;
+  renderedMode = gameMode;
+  redrawRequested = false;
+}
+
+void Game::renderScore(RenderBackend &target) {
+  target.drawText("Score: " + std::to_string(GAME_STATE.getCurrentScore()),
+                  {GAME_STATE.WINDOW_WIDTH - 150.0f, 10.0f}, 20,
+                  sf::Color::White);
 }
 
 int Game::countRemainingBricks() {
   int count = 0;
   for (Entity brick : bricks) {
+    // A brick hit this frame keeps its collider until the next collision
+    // update, but loses its position at once.
     auto collider = ecs.getComponent<ColliderComponent>(brick);
-    if (collider && collider->type == ColliderComponent::Type::Brick) {
+    if (collider && collider->type == ColliderComponent::Type::Brick &&
+        ecs.hasComponent<PositionComponent>(brick)) {
       count++;
     }
   }
@@ -267,6 +599,8 @@ int Game::countRemainingBricks() {
 }
 
 void Game::resetGame() {
+  resources.wait(level);
+  autosaveTimer.restart();
   
   for (Entity brick : bricks) {
     ecs.destroyEntity(brick);
@@ -282,11 +616,14 @@ void Game::resetGame() {
 
   
   ballSpeedSystem->reset();
+  particleSystem->clear();
+  projectileSystem->clear();
 
   
   GAME_STATE.resetCurrentScore();
 
   gameMode = GameMode::Playing;
+  timers.cancel(restartTimer);
   isRestarting = false;
 }
 
@@ -309,48 +646,23 @@ void Game::recreateBricks() {
     ecs.destroyEntity(brick);
   }
   bricks.clear();
-
-  const float brickWidth = 80.0f;
-  const float brickHeight = 30.0f;
-  const float brickSpacing = 5.0f;
-  const float startX = 50.0f;
-  const float startY = 50.0f;
-  const int rows = 5;
-  const int cols = 8;
-
-  sf::Color brickColors[] = {sf::Color::Red, sf::Color(255, 165, 0), 
-                             sf::Color::Yellow, sf::Color::Green,
-                             sf::Color::Cyan};
-
-  int bonusesAdded = 0;
-  for (int row = 0; row < rows; ++row) {
-    for (int col = 0; col < cols; ++col) {
-      float x = startX + col * (brickWidth + brickSpacing);
-      float y = startY + row * (brickHeight + brickSpacing);
-
-      static std::random_device rd;
-      static std::mt19937 gen(rd());
-      static std::uniform_int_distribution<int> hitPointsDis(1, 3);
-      static std::uniform_real_distribution<float> bonusChanceDis(0.0f, 1.0f);
-      static std::uniform_int_distribution<int> bonusTypeDis(0, 2);
-      
-      int hitPoints = hitPointsDis(gen);
-      bool hasBonus = false;
-      BonusType bonusType = BonusType::SlowBall;
-      
-      if (bonusesAdded < GAME_STATE.MAX_VISIBLE_BONUSES && bonusChanceDis(gen) < GAME_STATE.BONUS_CHANCE) {
-        hasBonus = true;
-        bonusType = static_cast<BonusType>(bonusTypeDis(gen));
-        bonusesAdded++;
-      }
-      
-      Entity brick = EntityFactory::createBrick(
-          ecs, x, y, brickWidth, brickHeight, brickColors[row % 5], hitPoints, hasBonus, bonusType);
-      bricks.push_back(brick);
-    }
+  journalValid = false;
+
+  if (marathon.isOpen()) {
+    marathon.restart(ecs, bricks);
+  } else if (const LevelData* data = level.get()) {
+    LevelLoader::instantiate(*data, ecs, bricks, random.stream("bricks").substream(layoutCount++));
+  } else if (level.hasFailed()) {
+    std::cerr << "Failed to load level " << GAME_STATE.currentLevel << std::endl;
   }
 }
 
+void Game::restoreRandom(std::uint64_t seed, std::uint32_t layouts) {
+  random.setSeed(seed);
+  layoutCount = layouts;
+  particleSystem->setRandom(random.stream("particles"));
+}
+
 void Game::exitToMenu() {
   
   for (Entity brick : bricks) {
@@ -367,268 +679,144 @@ void Game::exitToMenu() {
 
   
   ballSpeedSystem->reset();
+  particleSystem->clear();
+  projectileSystem->clear();
 
-  renderMainMenuScreen();
+  timers.cancel(restartTimer);
+  isRestarting = false;
   gameMode = GameMode::MainMenu;
 }
 
-void Game::renderVictoryScreen() {
-  sf::RectangleShape overlay;
-  overlay.setSize(
-      sf::Vector2f(GAME_STATE.WINDOW_WIDTH, GAME_STATE.WINDOW_HEIGHT));
-  overlay.setFillColor(sf::Color(0, 0, 0, 200));
-  window.draw(overlay);
+void Game::renderVictoryScreen(RenderBackend &target) {
+  const float centerX = GAME_STATE.WINDOW_WIDTH / 2.0f;
 
-  
-  try {
-    (void)font.getInfo();
-
-    {
-      
-      sf::Text congratsText(font);
-      congratsText.setString(L"Поздравляем! Вы выиграли!");
-      congratsText.setCharacterSize(48);
-      congratsText.setFillColor(sf::Color::Yellow);
-      congratsText.setStyle(sf::Text::Bold);
-      sf::FloatRect congratsBounds = congratsText.getLocalBounds();
-      congratsText.setPosition(
-          {(GAME_STATE.WINDOW_WIDTH - congratsBounds.position.x -
-            congratsBounds.size.x) /
-               2.0f,
-           150.0f});
-      window.draw(congratsText);
-    }
-    
-    {
-        sf::Text highScoreTitle(font);
-        highScoreTitle.setString(L"High Scores:");
-        highScoreTitle.setCharacterSize(24);
-        highScoreTitle.setFillColor(sf::Color::Cyan);
-        sf::FloatRect titleBounds = highScoreTitle.getLocalBounds();
-        highScoreTitle.setPosition(
-            {(GAME_STATE.WINDOW_WIDTH - titleBounds.position.x - titleBounds.size.x) / 2.0f,
-             200.0f});
-        window.draw(highScoreTitle);
-
-        const auto& scores = GAME_STATE.getHighScores();
-        float y = 230.0f;
-        for (size_t i = 0; i < scores.size() && i < 5; ++i) {
-            sf::Text scoreText(font);
-            scoreText.setString(std::to_string(i + 1) + ". " + std::to_string(scores[i]));
-            scoreText.setCharacterSize(20);
-            scoreText.setFillColor(sf::Color::White);
-            sf::FloatRect scoreBounds = scoreText.getLocalBounds();
-            scoreText.setPosition(
-                {(GAME_STATE.WINDOW_WIDTH - scoreBounds.position.x - scoreBounds.size.x) / 2.0f,
-                 y});
-            window.draw(scoreText);
-            y += 25.0f;
-        }
-    }
-    {
-      
-      sf::Text questionText(font);
-      questionText.setString(L"Хотите сыграть еще раз?");
-      questionText.setCharacterSize(32);
-      questionText.setFillColor(sf::Color::White);
-      sf::FloatRect questionBounds = questionText.getLocalBounds();
-      questionText.setPosition(
-          {(GAME_STATE.WINDOW_WIDTH - questionBounds.position.x -
-            questionBounds.size.x) /
-               2.0f,
-            350.0f});
-      window.draw(questionText);
-
-      sf::Text yesText(font);
-      yesText.setString(L"Да");
-      yesText.setCharacterSize(36);
-      yesText.setFillColor(victoryChoiceYes ? sf::Color::Green
-                                            : sf::Color::White);
-      yesText.setStyle(victoryChoiceYes ? sf::Text::Bold : sf::Text::Regular);
-      sf::FloatRect yesBounds = yesText.getLocalBounds();
-      yesText.setPosition(
-          {(GAME_STATE.WINDOW_WIDTH - yesBounds.position.x - yesBounds.size.x) /
-                   2.0f -
-               80.0f,
-           350.0f});
-      window.draw(yesText);
-
-      sf::Text noText(font);
-      noText.setString(L"Нет");
-      noText.setCharacterSize(36);
-      noText.setFillColor(!victoryChoiceYes ? sf::Color::Red
-                                            : sf::Color::White);
-      noText.setStyle(!victoryChoiceYes ? sf::Text::Bold : sf::Text::Regular);
-      sf::FloatRect noBounds = noText.getLocalBounds();
-      noText.setPosition(
-          {(GAME_STATE.WINDOW_WIDTH - noBounds.position.x - noBounds.size.x) /
-                   2.0f +
-               80.0f,
-           350.0f});
-      window.draw(noText);
-
-      sf::Text instructionsText(font);
-      instructionsText.setString(
-          L"Стрелки влево/вправо - выбор, Enter - подтвердить");
-      instructionsText.setCharacterSize(20);
-      instructionsText.setFillColor(sf::Color(200, 200, 200));
-      sf::FloatRect instBounds = instructionsText.getLocalBounds();
-      instructionsText.setPosition(
-          {(GAME_STATE.WINDOW_WIDTH - instBounds.position.x -
-            instBounds.size.x) /
-               2.0f,
-           450.0f});
-   window.draw(instructionsText);
-}
-
-
-
-
-
-  } catch (...) {
-    
+  target.fillRect({0.0f, 0.0f},
+                  sf::Vector2f(GAME_STATE.WINDOW_WIDTH, GAME_STATE.WINDOW_HEIGHT),
+                  sf::Color(0, 0, 0, 200));
+
+  target.drawText(L"Поздравляем! Вы выиграли!", {centerX, 150.0f}, 48,
+                  sf::Color::Yellow, TextAlign::Center, true);
+
+  target.drawText(L"High Scores:", {centerX, 200.0f}, 24, sf::Color::Cyan,
+                  TextAlign::Center);
+
+  const Leaderboard* leaderboard = GAME_STATE.getLeaderboard();
+  const auto scores = leaderboard ? leaderboard->top(GAME_STATE.currentLevel, 5)
+                                  : std::vector<LeaderboardEntry>();
+  float y = 230.0f;
+  for (size_t i = 0; i < scores.size(); ++i) {
+    target.drawText(std::to_string(i + 1) + ". " + scores[i].name + "  " +
+                        std::to_string(scores[i].score),
+                    {centerX, y}, 20, sf::Color::White, TextAlign::Center);
+    y += 20.0f;
   }
+
+  const std::size_t boardSize =
+      leaderboard ? leaderboard->size(GAME_STATE.currentLevel) : 0;
+  if (GAME_STATE.getLastRank() > 0 && boardSize > 0) {
+    const int betterThan = static_cast<int>(
+        100.0f * (boardSize - GAME_STATE.getLastRank()) / boardSize);
+    target.drawText(std::to_string(GAME_STATE.getLastRank()) + " / " +
+                        std::to_string(boardSize) + "  (" +
+                        std::to_string(betterThan) + "%)",
+                    {centerX, y + 5.0f}, 18, sf::Color::Yellow,
+                    TextAlign::Center);
+  }
+
+  target.drawText(L"Хотите сыграть еще раз?", {centerX, 350.0f}, 32,
+                  sf::Color::White, TextAlign::Center);
+
+  target.drawText(L"Да", {centerX - 80.0f, 350.0f}, 36,
+                  victoryChoiceYes ? sf::Color::Green : sf::Color::White,
+                  TextAlign::Center, victoryChoiceYes);
+
+  target.drawText(L"Нет", {centerX + 80.0f, 350.0f}, 36,
+                  !victoryChoiceYes ? sf::Color::Red : sf::Color::White,
+                  TextAlign::Center, !victoryChoiceYes);
+
+  target.drawText(L"Стрелки влево/вправо - выбор, Enter - подтвердить",
+                  {centerX, 450.0f}, 20, sf::Color(200, 200, 200),
+                  TextAlign::Center);
+}
+
+void Game::renderMainMenuScreen(RenderBackend &target) {
+  const float centerX = GAME_STATE.WINDOW_WIDTH / 2.0f;
+
+  target.fillRect({0.0f, 0.0f},
+                  sf::Vector2f(GAME_STATE.WINDOW_WIDTH, GAME_STATE.WINDOW_HEIGHT),
+                  sf::Color(0, 0, 0, 200));
+
+  target.drawText(L"Игра \"Арканоид\"", {centerX, 200.0f}, 64,
+                  sf::Color(255, 255, 255), TextAlign::Center);
+
+  target.drawText(L"Нажмите Enter для начала игры", {centerX, 450.0f}, 20,
+                  sf::Color(200, 200, 200), TextAlign::Center);
 }
 
-void Game::renderMainMenuScreen() {
-  sf::RectangleShape overlay;
-
-  overlay.setSize(
-      sf::Vector2f(GAME_STATE.WINDOW_WIDTH, GAME_STATE.WINDOW_HEIGHT));
-  overlay.setFillColor(sf::Color(0, 0, 0, 200));
-  window.draw(overlay);
-
-  sf::Text gameTitleText(font);
-  gameTitleText.setString(L"Игра \"Арканоид\"");
-  gameTitleText.setCharacterSize(64);
-  gameTitleText.setFillColor(sf::Color(255, 255, 255));
-  sf::FloatRect titleBounds = gameTitleText.getLocalBounds();
-  gameTitleText.setPosition(
-      {(GAME_STATE.WINDOW_WIDTH - titleBounds.position.x - titleBounds.size.x) /
-           2.0f,
-       200.0f});
-  window.draw(gameTitleText);
-
-  sf::Text instructionsText(font);
-  instructionsText.setString(L"Нажмите Enter для начала игры");
-  instructionsText.setCharacterSize(20);
-  instructionsText.setFillColor(sf::Color(200, 200, 200));
-  sf::FloatRect instBounds = instructionsText.getLocalBounds();
-  instructionsText.setPosition(
-      {(GAME_STATE.WINDOW_WIDTH - instBounds.position.x - instBounds.size.x) /
-           2.0f,
-       450.0f});
-  window.draw(instructionsText);
-}
-
-void Game::updateBonuses(float deltaTime) {
-    auto entities = ecs.getEntitiesWithComponent<ActiveBonusComponent>();
-    static size_t lastCount = 0;
-    if (entities.size() != lastCount) {
-        std::cout << "[DEBUG] updateBonuses: " << entities.size() << " active bonuses" << std::endl;
-        lastCount = entities.size();
+// Saves store the time left on each bonus rather than its timer.
+void Game::syncBonusTimers() {
+    for (Entity entity : ecs.getEntitiesWithComponent<StatModifiersComponent>()) {
+        auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+        for (std::size_t i = 0; i < modifiers->count; ++i) {
+            StatModifier& modifier = modifiers->modifiers[i];
+            modifier.remainingTime = timers.toSeconds(timers.remaining(modifier.expiry));
+        }
     }
-    for (Entity entity : entities) {
-        auto bonus = ecs.getComponent<ActiveBonusComponent>(entity);
-        if (!bonus) continue;
-        
-        bonus->remainingTime -= deltaTime;
-        if (bonus->remainingTime <= 0.0f) {
-            std::cout << "[DEBUG] Bonus expired: type=" << static_cast<int>(bonus->type) 
-                      << ", remainingTime=" << bonus->remainingTime << std::endl;
-            
-            switch (bonus->type) {
-                case BonusType::SlowBall: {
-                    auto velocity = ecs.getComponent<VelocityComponent>(entity);
-                    if (velocity) {
-                        velocity->speed = bonus->originalValue;
-                        
-                        float currentSpeed = std::sqrt(velocity->velocity.x * velocity->velocity.x + velocity->velocity.y * velocity->velocity.y);
-                        if (currentSpeed > 0.0f) {
-                            velocity->velocity = velocity->velocity * (velocity->speed / currentSpeed);
-                        }
-                    }
-                    break;
-                }
-                case BonusType::FastPlatform: {
-                    auto input = ecs.getComponent<InputComponent>(entity);
-                    if (input) {
-                        input->moveSpeed = bonus->originalValue;
-                    }
-                    break;
-                }
-                case BonusType::BigPlatform: {
-                    auto shape = ecs.getComponent<ShapeComponent>(entity);
-                    auto collider = ecs.getComponent<ColliderComponent>(entity);
-                    auto position = ecs.getComponent<PositionComponent>(entity);
-                    if (shape && shape->type == ShapeComponent::Type::Rectangle) {
-                        std::cout << "[DEBUG] BigPlatform bonus expired. Restoring width from " 
-                                  << shape->rectangle.width << " to " << bonus->originalValue << std::endl;
-                        shape->rectangle.width = bonus->originalValue;
-                        if (collider) {
-                            collider->size.x = bonus->originalValue;
-                        }
-                        
-                        if (position) {
-                            float newWidth = bonus->originalValue;
-                            if (position->position.x < 0.0f) {
-                                position->position.x = 0.0f;
-                            }
-                            if (position->position.x + newWidth > static_cast<float>(GAME_STATE.WINDOW_WIDTH)) {
-                                position->position.x = static_cast<float>(GAME_STATE.WINDOW_WIDTH) - newWidth;
-                            }
-                        }
-                    }
-                    break;
-                }
-            }
-            ecs.removeComponent<ActiveBonusComponent>(entity);
+}
+
+void Game::flushDestroyedBricks() {
+    collisionSystem->flushDestroyedBricks(ecs);
+}
+
+void Game::cancelBonusTimers() {
+    for (Entity entity : ecs.getEntitiesWithComponent<StatModifiersComponent>()) {
+        auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+        for (std::size_t i = 0; i < modifiers->count; ++i) {
+            timers.cancel(modifiers->modifiers[i].expiry);
         }
     }
+    ballSpeedSystem->reset();
+}
+
+void Game::restoreBonusTimers() {
+    collisionSystem->restoreBonuses(ecs);
+    ballSpeedSystem->restoreMultiplier(ecs, ball);
 }
 
-void Game::renderBonusTimers() {
-    auto entities = ecs.getEntitiesWithComponent<ActiveBonusComponent>();
+void Game::renderBonusTimers(RenderBackend &target) {
     float startX = 30.0f;
     float startY = 30.0f;
     float spacing = 40.0f;
     int index = 0;
-    for (Entity entity : entities) {
-        auto bonus = ecs.getComponent<ActiveBonusComponent>(entity);
-        if (!bonus) continue;
-        
-        float radius = 15.0f;
-        float thickness = 5.0f;
-        
-        sf::Color color;
-        switch (bonus->type) {
-            case BonusType::SlowBall: color = sf::Color::Red; break;
-            case BonusType::FastPlatform: color = sf::Color::Green; break;
-            case BonusType::BigPlatform: color = sf::Color::Blue; break;
-        }
-        
-        
-        sf::CircleShape outerCircle(radius);
-        outerCircle.setPosition({startX + index * spacing - radius, startY - radius});
-        outerCircle.setFillColor(sf::Color::Transparent);
-        outerCircle.setOutlineColor(color);
-        outerCircle.setOutlineThickness(thickness);
-        window.draw(outerCircle);
-        
-        
-        if (font.getInfo().family != "") {
-            sf::Text timeText(font);
-            timeText.setString(std::to_string(static_cast<int>(bonus->remainingTime) + 1));
-            timeText.setCharacterSize(12);
-            timeText.setFillColor(sf::Color::White);
-            timeText.setPosition({startX + index * spacing - 5, startY - 6});
-            window.draw(timeText);
+    for (Entity entity : ecs.getEntitiesWithComponent<StatModifiersComponent>()) {
+        auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+        for (std::size_t i = 0; i < modifiers->count; ++i) {
+            const StatModifier& modifier = modifiers->modifiers[i];
+            
+            float radius = 15.0f;
+            float thickness = 5.0f;
+            
+            sf::Vector2f center{startX + index * spacing, startY};
+            target.outlineCircle(center, radius, thickness, BonusTable::get(modifier.source).color);
+            
+            
+            const float remaining = timers.toSeconds(timers.remaining(modifier.expiry));
+            target.drawText(std::to_string(static_cast<int>(remaining) + 1),
+                            {center.x - 5, startY - 6}, 12, sf::Color::White);
+            
+            index++;
         }
-        
-        index++;
     }
 }
 
 Game::~Game() {
-    GAME_STATE.saveHighScores("highscores.txt");
+    reportCpuUsage();
+    renderThread->stop();
+    autosaveWorker.stop();
+    resources.stop();
+    resources.update();
+    if (Leaderboard* leaderboard = scores.get()) {
+      leaderboard->save(GAME_STATE.HIGH_SCORES_FILENAME);
+    }
+    GAME_STATE.setLeaderboard(nullptr);
 }
@@ -8,7 +8,21 @@
 #include "ECS/Systems/RenderSystem.h"
 #include "ECS/Systems/ResizeSystem.h"
 #include "ECS/Systems/BallSpeedSystem.h"
+#include "ECS/Systems/ParticleSystem.h"
+#include "ECS/Systems/ProjectileSystem.h"
+#include "Render/SfmlRenderBackend.h"
+#include "AutoplayController.h"
+#include "Render/RenderThread.h"
+#include "CpuUsageMeter.h"
+#include "Random.h"
+#include "LevelStreamer.h"
+#include "ResourceManager.h"
+#include "TaskWorker.h"
+#include "TimerWheel.h"
+#include "SaveJournal.h"
+#include "SaveSlotManager.h"
 #include <memory>
+#include <optional>
 
 enum class GameMode
 {
@@ -17,10 +31,24 @@ enum class GameMode
     MainMenu,
 };
 
+struct GameOptions
+{
+    // A random seed is chosen when empty.
+    std::optional<std::uint64_t> seed;
+    // Level file played as one scrolling marathon level instead of the
+    // regular levels.
+    std::string marathonLevel;
+    // A bot plays the paddle and starts each level by itself. Skill and
+    // reaction delay default to AUTOPLAY_SKILL and AUTOPLAY_REACTION_DELAY.
+    bool autoplay = false;
+    std::optional<float> autoplaySkill;
+    std::optional<float> autoplayReactionDelay;
+};
+
 class Game
 {
 public:
-    Game();
+    explicit Game(const GameOptions& options = {});
     ~Game();
 
     void run();
@@ -28,28 +56,63 @@ public:
     
     Entity getPlatform() const { return platform; }
     Entity getBall() const { return ball; }
+    void setPlatform(Entity entity) { platform = entity; }
+    void setBall(Entity entity) { ball = entity; }
     const std::vector<Entity>& getBricks() const { return bricks; }
     std::vector<Entity>& getBricks() { return bricks; }
     ECSManager& getECS() { return ecs; }
     const ECSManager& getECS() const { return ecs; }
+    std::uint64_t getRandomSeed() const { return random.getSeed(); }
+    std::uint32_t getLayoutCount() const { return layoutCount; }
+    void restoreRandom(std::uint64_t seed, std::uint32_t layouts);
+    // Before a save or a load: destroys the bricks hit this frame, which
+    // otherwise linger until the next collision update.
+    void flushDestroyedBricks();
+    // Before a load replaces the world: stops its bonus expiry timers and the
+    // ball speed-ups, so none of them fire into the loaded game.
+    void cancelBonusTimers();
+    // Rebuilds the bonus modifiers of a world just loaded, starts their
+    // expiry timers and picks the ball speed-ups up where the save left them.
+    void restoreBonusTimers();
 
 private:
     void handleEvents();
+    void handleEvent(const sf::Event& event);
+    bool isStaticScreen() const;
+    void runIdleFrame();
+    void reportCpuUsage();
+    void autoplayMenus();
+    void updateResources();
+    void advanceLevel();
+    int nextLevelNumber() const;
+    ResourceHandle<LevelData> requestLevel(int number);
+    void selectSaveSlot(int slot);
+    std::string saveFilename() const;
+    void requestSave();
+    std::uint32_t rotateJournal();
+    void flushJournal();
+    void compactJournal();
     void update(float deltaTime);
     void render();
-    void renderVictoryScreen();
-    void renderMainMenuScreen();
-    void renderScore();
+    void renderVictoryScreen(RenderBackend& target);
+    void renderMainMenuScreen(RenderBackend& target);
+    void renderScore(RenderBackend& target);
     int countRemainingBricks();
     void resetGame();
     void exitToMenu();
     void initializeGameObjects();
     void recreateBricks();
-    void updateBonuses(float deltaTime);
-    void renderBonusTimers();
+    void advanceTimers(float deltaTime);
+    void finishRestart();
+    void syncBonusTimers();
+    void renderBonusTimers(RenderBackend& target);
 
     sf::RenderWindow window;
+    std::unique_ptr<SfmlRenderBackend> renderBackend;
+    std::unique_ptr<RenderThread> renderThread;
     ECSManager ecs;
+    // Game time: advanced by update() and during the restart pause.
+    TimerWheel timers;
 
     std::shared_ptr<InputSystem> inputSystem;
     std::shared_ptr<MovementSystem> movementSystem;
@@ -57,15 +120,44 @@ private:
     std::shared_ptr<RenderSystem> renderSystem;
     std::shared_ptr<ResizeSystem> resizeSystem;
     std::shared_ptr<BallSpeedSystem> ballSpeedSystem;
+    std::shared_ptr<ParticleSystem> particleSystem;
+    std::shared_ptr<ProjectileSystem> projectileSystem;
+    std::unique_ptr<AutoplayController> autoplay;
 
     Entity platform;
     Entity ball;
     std::vector<Entity> bricks;
 
+    RandomService random;
+    // Brick layouts generated so far; layout n uses substream n of "bricks".
+    std::uint32_t layoutCount = 0;
+    LevelStreamer marathon;
+
     sf::Clock clock;
-    sf::Clock restartTimer;
+    TimerHandle restartTimer;
     bool isRestarting = false;
     GameMode gameMode = GameMode::MainMenu;
     bool victoryChoiceYes = true; 
-    sf::Font font;
+    bool redrawRequested = true;
+    GameMode renderedMode = GameMode::MainMenu;
+    GameMode meteredMode = GameMode::MainMenu;
+    CpuUsageMeter cpuMeter;
+    // Frames rendered since cpuMeter was restarted.
+    std::uint64_t meteredFrames = 0;
+    TaskWorker autosaveWorker;
+    sf::Clock autosaveTimer;
+    SaveJournal journal;
+    sf::Clock journalFlushTimer;
+    SaveSlotManager saveSlots;
+    int saveSlot = 0;
+    std::uint32_t checkpointSequence = 0;
+    // False after entities were created outside the journal (new board);
+    // the next save must then be a full checkpoint.
+    bool journalValid = false;
+    ResourceManager resources;
+    ResourceHandle<FontResource> font;
+    ResourceHandle<LevelData> level;
+    // Next level, requested while the victory screen is up.
+    ResourceHandle<LevelData> nextLevel;
+    ResourceHandle<Leaderboard> scores;
 };
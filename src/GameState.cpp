@@ -1,23 +1,12 @@
 #include "GameState.h"
-#include <fstream>
-#include <sstream>
+#include "Leaderboard.h"
+#include <chrono>
 
-void GameState::loadHighScores(const std::string& filename) {
-    highScores.clear();
-    std::ifstream file(filename);
-    if (!file.is_open()) return;
-    int score;
-    while (file >> score) {
-        highScores.push_back(score);
-    }
-    std::sort(highScores.rbegin(), highScores.rend());
-    if (highScores.size() > 10) highScores.resize(10);
-}
-
-void GameState::saveHighScores(const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) return;
-    for (int score : highScores) {
-        file << score << "\n";
+void GameState::submitCurrentScore() {
+    if (leaderboard) {
+        const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        lastRank = leaderboard->insert(Leaderboard::makeEntry(playerName, currentScore, currentLevel, now));
     }
+    resetCurrentScore();
 }
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <string>
 
+class Leaderboard;
+
 class GameState
 {
 private:
@@ -20,13 +22,35 @@ public:
     const unsigned int WINDOW_WIDTH = 800;
     const unsigned int WINDOW_HEIGHT = 600;
     const char* WINDOW_TITLE = "Arcanoid Game";
+    // Baked into the executable from resources/fonts.
+    const char* FONT_NAME = "JetBrainsMono-Regular.ttf";
 
 
     const unsigned int TARGET_FPS = 60;
     const float FRAME_TIME = 1.0f / TARGET_FPS;
 
 
+    // Menu and victory screens block on input instead of redrawing every frame.
+    const bool IDLE_STATIC_SCREENS = true;
+    const float IDLE_WAIT_TIMEOUT_SECONDS = 0.5f;
+
+
     const float RESTART_PAUSE_TIME_SECONDS = 1.0f;
+    // Resolution of the game-time timers: bonus expiry, speed-ups, restarts.
+    const unsigned int TIMER_TICKS_PER_SECOND = 1000;
+
+
+    // Saves are written on a background thread; F5 forces one immediately and
+    // F6/F7 switch between slots.
+    // With journaling, changes are appended to a log every flush interval and
+    // folded into a new checkpoint every autosave interval.
+    const float AUTOSAVE_INTERVAL_SECONDS = 30.0f;
+    const int SAVE_SLOT_COUNT = 10;
+    const char* SAVE_INDEX_FILENAME = "saves.idx";
+    const char* HIGH_SCORES_FILENAME = "highscores.dat";
+    const char* LEGACY_HIGH_SCORES_FILENAME = "highscores.txt";
+    const bool JOURNALED_SAVES = true;
+    const float JOURNAL_FLUSH_INTERVAL_SECONDS = 1.0f;
 
     const float PLATFORM_START_X = 350.0f;
     const float PLATFORM_START_Y = 550.0f;
@@ -48,32 +72,57 @@ public:
     const float BALL_MAX_SPEED_MULTIPLIER = 3.0f;
 
 
-    const float BONUS_CHANCE = 0.8f;
-    const int MAX_VISIBLE_BONUSES = 20;
     const float SLOW_BALL_DURATION = 5.0f;
     const float FAST_PLATFORM_DURATION = 10.0f;
     const float BIG_PLATFORM_DURATION = 5.0f;
+    const float LASER_DURATION = 6.0f;
+    // Shots per second; each shot is one bolt from either end of the paddle.
+    const float LASER_FIRE_RATE = 5.0f;
+    const float PROJECTILE_SPEED = 700.0f;
+    // Bolts in flight at once; shots beyond it are dropped.
+    const std::size_t PROJECTILE_CAPACITY = 4096;
+    // Cell size of the ECS spatial index that colliders are bucketed into.
+    const float SPATIAL_INDEX_CELL_SIZE = 64.0f;
+    // Reach of an explosive brick's blast from its center.
+    const float EXPLOSION_RADIUS = 50.0f;
+
+
+    const std::size_t PARTICLE_CAPACITY = 200000;
+
+
+    // After the baked levels, play continues on generated ones instead of
+    // starting over at level 1.
+    const bool ENDLESS_LEVELS = true;
+    const float LEVEL_MARGIN = 50.0f;
+
+
+    // Marathon levels scroll until their lowest brick is this far down.
+    const float SCROLL_FLOOR_Y = 350.0f;
+    const float SCROLL_SPEED = 150.0f;
+
+
+    // Autoplay (--autoplay) defaults. Skill 1 always reaches the ball; the
+    // bot re-aims once per reaction delay.
+    const float AUTOPLAY_SKILL = 0.9f;
+    const float AUTOPLAY_REACTION_DELAY = 0.12f;
 
     int currentScore = 0;
-    std::vector<int> highScores;
+    int currentLevel = 1;
+    std::string playerName = "Player";
+    // Owned by the resource manager; null until the score file has loaded.
+    Leaderboard* leaderboard = nullptr;
+    // 1-based rank of the last submitted score, 0 if none yet.
+    std::size_t lastRank = 0;
 
     void resetCurrentScore() { currentScore = 0; }
     void addScore(int points) { currentScore += points; }
     int getCurrentScore() const { return currentScore; }
 
 
-    void addHighScore(int score) {
-        highScores.push_back(score);
-        std::sort(highScores.rbegin(), highScores.rend());
-        if (highScores.size() > 10) highScores.resize(10);
-    }
-    const std::vector<int>& getHighScores() const { return highScores; }
-    void submitCurrentScore() {
-        addHighScore(currentScore);
-        resetCurrentScore();
-    }
-    void loadHighScores(const std::string& filename);
-    void saveHighScores(const std::string& filename);
+    void setLeaderboard(Leaderboard* board) { leaderboard = board; }
+    const Leaderboard* getLeaderboard() const { return leaderboard; }
+    std::size_t getLastRank() const { return lastRank; }
+    void submitCurrentScore();
 };
 
 #define GAME_STATE GameState::Instance()
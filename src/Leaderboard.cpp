@@ -0,0 +1,361 @@
+#include "Leaderboard.h"
+#include "Checksum.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+constexpr char LEADERBOARD_MAGIC[8] = {'A', 'R', 'C', 'L', 'D', 'R', 'B', 'D'};
+constexpr std::uint32_t LEADERBOARD_VERSION = 1;
+
+// Entries that rank above `key` in a sorted array.
+std::size_t countAbove(std::span<const LeaderboardEntry> sorted, const LeaderboardEntry& key)
+{
+    return std::partition_point(sorted.begin(), sorted.end(),
+                                [&](const LeaderboardEntry& entry) { return ranksAbove(entry, key); }) - sorted.begin();
+}
+
+// Entries that rank above `key` or tie with it.
+std::size_t countAboveOrEqual(std::span<const LeaderboardEntry> sorted, const LeaderboardEntry& key)
+{
+    return std::partition_point(sorted.begin(), sorted.end(),
+                                [&](const LeaderboardEntry& entry) { return !ranksAbove(key, entry); }) - sorted.begin();
+}
+
+// Keys that compare against every entry with the same score as if they came
+// before (lowest) or after (highest) all of them.
+LeaderboardEntry scoreKey(int score, bool afterTies)
+{
+    LeaderboardEntry key{};
+    key.score = score;
+    key.timestamp = afterTies ? INT64_MAX : INT64_MIN;
+    return key;
+}
+}
+
+ScoreSkipList::ScoreSkipList()
+{
+    entries.emplace_back();
+    linkOffset.push_back(0);
+    links.assign(MAX_LEVEL, Link{END, 1});
+}
+
+int ScoreSkipList::randomHeight()
+{
+    int height = 1;
+    while (height < MAX_LEVEL)
+    {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        if ((rngState & 3) != 0) break;
+        height++;
+    }
+    return height;
+}
+
+std::size_t ScoreSkipList::insert(const LeaderboardEntry& entry)
+{
+    std::uint32_t update[MAX_LEVEL];
+    std::size_t rankAt[MAX_LEVEL];
+
+    std::uint32_t node = 0;
+    std::size_t position = 0;
+    for (int level = MAX_LEVEL - 1; level >= 0; --level)
+    {
+        for (std::uint32_t next = link(node, level).next;
+             next != END && !ranksAbove(entry, entries[next]);
+             next = link(node, level).next)
+        {
+            position += link(node, level).width;
+            node = next;
+        }
+        update[level] = node;
+        rankAt[level] = position;
+    }
+
+    const std::uint32_t inserted = static_cast<std::uint32_t>(entries.size());
+    const int height = randomHeight();
+    entries.push_back(entry);
+    linkOffset.push_back(static_cast<std::uint32_t>(links.size()));
+    links.resize(links.size() + height);
+
+    for (int level = 0; level < MAX_LEVEL; ++level)
+    {
+        Link& previous = link(update[level], level);
+        if (level < height)
+        {
+            const std::size_t skipped = rankAt[0] - rankAt[level];
+            link(inserted, level) = {previous.next, static_cast<std::uint32_t>(previous.width - skipped)};
+            previous = {inserted, static_cast<std::uint32_t>(skipped + 1)};
+        }
+        else
+        {
+            previous.width++;
+        }
+    }
+    return rankAt[0];
+}
+
+template<typename Before>
+std::size_t ScoreSkipList::countWhile(Before&& before) const
+{
+    std::uint32_t node = 0;
+    std::size_t position = 0;
+    for (int level = MAX_LEVEL - 1; level >= 0; --level)
+    {
+        for (std::uint32_t next = link(node, level).next; next != END && before(entries[next]);
+             next = link(node, level).next)
+        {
+            position += link(node, level).width;
+            node = next;
+        }
+    }
+    return position;
+}
+
+std::size_t ScoreSkipList::countAbove(const LeaderboardEntry& key) const
+{
+    return countWhile([&](const LeaderboardEntry& entry) { return ranksAbove(entry, key); });
+}
+
+const LeaderboardEntry& ScoreSkipList::select(std::size_t index) const
+{
+    const std::size_t target = index + 1;
+    std::uint32_t node = 0;
+    std::size_t position = 0;
+    for (int level = MAX_LEVEL - 1; level >= 0; --level)
+    {
+        while (link(node, level).next != END && position + link(node, level).width <= target)
+        {
+            position += link(node, level).width;
+            node = link(node, level).next;
+        }
+    }
+    return entries[node];
+}
+
+std::size_t Leaderboard::Board::countAbove(const LeaderboardEntry& key) const
+{
+    return ::countAbove(base, key) + added.countAbove(key);
+}
+
+// Merged order puts file entries before added ones when they tie, so the
+// merged position of base[i] is i plus the added entries strictly above it.
+LeaderboardEntry Leaderboard::Board::select(std::size_t index) const
+{
+    auto mergedIndex = [&](std::size_t i) { return i + added.countAbove(base[i]); };
+
+    std::size_t low = 0;
+    std::size_t high = base.size();
+    while (low < high)
+    {
+        const std::size_t middle = low + (high - low) / 2;
+        if (mergedIndex(middle) <= index) low = middle + 1;
+        else high = middle;
+    }
+
+    if (low > 0 && mergedIndex(low - 1) == index) return base[low - 1];
+    return added.select(index - low);
+}
+
+bool Leaderboard::open(const std::string& filename)
+{
+    boards.clear();
+    ownedImage.clear();
+    if (!file.open(filename)) return false;
+    if (attach({file.data(), file.size()})) return true;
+
+    std::cerr << "Invalid leaderboard file: " << filename << std::endl;
+    boards.clear();
+    file.close();
+    return false;
+}
+
+bool Leaderboard::attach(std::span<const std::byte> image)
+{
+    if (image.size() < sizeof(LeaderboardFileHeader)) return false;
+
+    LeaderboardFileHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    const std::size_t tableSize = static_cast<std::size_t>(header.boardCount) * sizeof(LeaderboardBoardRecord);
+    if (std::memcmp(header.magic, LEADERBOARD_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != LEADERBOARD_VERSION || header.entrySize != sizeof(LeaderboardEntry) ||
+        header.fileSize != image.size() || tableSize > image.size() - sizeof(header) ||
+        crc32(image.data() + sizeof(header), tableSize) != header.tableCrc)
+    {
+        return false;
+    }
+
+    // Only the header and board table are checksummed so that opening stays
+    // independent of the number of entries.
+    for (std::uint32_t i = 0; i < header.boardCount; ++i)
+    {
+        LeaderboardBoardRecord record;
+        std::memcpy(&record, image.data() + sizeof(header) + i * sizeof(record), sizeof(record));
+        if (record.offset % alignof(LeaderboardEntry) != 0 || record.offset > image.size() ||
+            record.count > (image.size() - record.offset) / sizeof(LeaderboardEntry))
+        {
+            return false;
+        }
+        boards[record.level].base = {reinterpret_cast<const LeaderboardEntry*>(image.data() + record.offset),
+                                     static_cast<std::size_t>(record.count)};
+    }
+    return true;
+}
+
+bool Leaderboard::save(const std::string& filename)
+{
+    const std::size_t tableSize = boards.size() * sizeof(LeaderboardBoardRecord);
+    std::size_t entryCount = 0;
+    for (const auto& [level, board] : boards)
+    {
+        entryCount += board.size();
+    }
+
+    std::vector<std::byte> image(sizeof(LeaderboardFileHeader) + tableSize + entryCount * sizeof(LeaderboardEntry));
+    std::size_t tableOffset = sizeof(LeaderboardFileHeader);
+    std::size_t entryOffset = tableOffset + tableSize;
+    for (const auto& [level, board] : boards)
+    {
+        const LeaderboardBoardRecord record{level, 0, entryOffset, board.size()};
+        std::memcpy(image.data() + tableOffset, &record, sizeof(record));
+        tableOffset += sizeof(record);
+
+        // Merge the sorted file entries with the skip list.
+        auto* out = reinterpret_cast<LeaderboardEntry*>(image.data() + entryOffset);
+        std::size_t next = 0;
+        board.added.forEach([&](const LeaderboardEntry& entry)
+        {
+            while (next < board.base.size() && !ranksAbove(entry, board.base[next])) *out++ = board.base[next++];
+            *out++ = entry;
+            return true;
+        });
+        out = std::copy(board.base.begin() + next, board.base.end(), out);
+        entryOffset += board.size() * sizeof(LeaderboardEntry);
+    }
+
+    LeaderboardFileHeader header{};
+    std::memcpy(header.magic, LEADERBOARD_MAGIC, sizeof(header.magic));
+    header.version = LEADERBOARD_VERSION;
+    header.entrySize = sizeof(LeaderboardEntry);
+    header.boardCount = static_cast<std::uint32_t>(boards.size());
+    header.tableCrc = crc32(image.data() + sizeof(header), tableSize);
+    header.fileSize = image.size();
+    std::memcpy(image.data(), &header, sizeof(header));
+
+    // The old mapping must be released before the file can be replaced on
+    // Windows; the merged image keeps the boards alive meanwhile.
+    boards.clear();
+    file.close();
+    ownedImage = std::move(image);
+    attach(ownedImage);
+
+    if (!replaceFileAtomically(filename, ownedImage.data(), ownedImage.size()))
+    {
+        std::cerr << "Failed to write leaderboard: " << filename << std::endl;
+        return false;
+    }
+    return open(filename);
+}
+
+bool Leaderboard::importLegacy(const std::string& filename, std::string_view playerName)
+{
+    std::ifstream legacy(filename);
+    if (!legacy.is_open()) return false;
+
+    int score;
+    while (legacy >> score)
+    {
+        insert(makeEntry(playerName, score, 1, 0));
+    }
+    return true;
+}
+
+std::size_t Leaderboard::insert(const LeaderboardEntry& entry)
+{
+    Board& board = boards[entry.level];
+    const std::size_t position = board.added.insert(entry);
+    return countAboveOrEqual(board.base, entry) + position + 1;
+}
+
+const Leaderboard::Board* Leaderboard::findBoard(int level) const
+{
+    auto it = boards.find(level);
+    return it != boards.end() ? &it->second : nullptr;
+}
+
+std::size_t Leaderboard::size(int level) const
+{
+    const Board* board = findBoard(level);
+    return board ? board->size() : 0;
+}
+
+std::size_t Leaderboard::rankOf(int level, int score) const
+{
+    const Board* board = findBoard(level);
+    return board ? board->countAbove(scoreKey(score, false)) + 1 : 1;
+}
+
+std::optional<LeaderboardEntry> Leaderboard::at(int level, std::size_t index) const
+{
+    const Board* board = findBoard(level);
+    if (!board || index >= board->size()) return std::nullopt;
+    return board->select(index);
+}
+
+std::vector<LeaderboardEntry> Leaderboard::top(int level, std::size_t count) const
+{
+    std::vector<LeaderboardEntry> result;
+    const Board* board = findBoard(level);
+    if (!board) return result;
+
+    count = std::min(count, board->size());
+    result.reserve(count);
+    std::size_t next = 0;
+    board->added.forEach([&](const LeaderboardEntry& entry)
+    {
+        while (result.size() < count && next < board->base.size() && !ranksAbove(entry, board->base[next]))
+        {
+            result.push_back(board->base[next++]);
+        }
+        if (result.size() < count) result.push_back(entry);
+        return result.size() < count;
+    });
+    while (result.size() < count)
+    {
+        result.push_back(board->base[next++]);
+    }
+    return result;
+}
+
+float Leaderboard::percentileOf(int level, int score) const
+{
+    const Board* board = findBoard(level);
+    if (!board || board->size() == 0) return 1.0f;
+
+    const std::size_t atOrAbove = board->countAbove(scoreKey(score, true));
+    return static_cast<float>(board->size() - atOrAbove) / static_cast<float>(board->size());
+}
+
+std::optional<int> Leaderboard::scoreAtPercentile(int level, float percentile) const
+{
+    const Board* board = findBoard(level);
+    if (!board || board->size() == 0) return std::nullopt;
+
+    const float clamped = std::clamp(percentile, 0.0f, 1.0f);
+    const auto index = static_cast<std::size_t>((1.0f - clamped) * static_cast<float>(board->size() - 1));
+    return board->select(index).score;
+}
+
+LeaderboardEntry Leaderboard::makeEntry(std::string_view name, int score, int level, std::int64_t timestamp)
+{
+    LeaderboardEntry entry{};
+    entry.score = score;
+    entry.level = level;
+    entry.timestamp = timestamp;
+    std::memcpy(entry.name, name.data(), std::min(name.size(), sizeof(entry.name) - 1));
+    return entry;
+}
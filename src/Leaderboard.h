@@ -0,0 +1,151 @@
+#pragma once
+
+#include "FileIO.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+struct LeaderboardEntry
+{
+    std::int32_t score;
+    std::int32_t level;
+    std::int64_t timestamp;
+    char name[24];
+};
+
+struct LeaderboardFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t entrySize;
+    std::uint32_t boardCount;
+    std::uint32_t tableCrc;
+    std::uint64_t fileSize;
+};
+
+struct LeaderboardBoardRecord
+{
+    std::int32_t level;
+    std::uint32_t reserved;
+    std::uint64_t offset;
+    std::uint64_t count;
+};
+
+static_assert(sizeof(LeaderboardEntry) == 40 && std::is_trivially_copyable_v<LeaderboardEntry>);
+static_assert(sizeof(LeaderboardFileHeader) == 32 && std::is_trivially_copyable_v<LeaderboardFileHeader>);
+static_assert(sizeof(LeaderboardBoardRecord) == 24 && std::is_trivially_copyable_v<LeaderboardBoardRecord>);
+
+// Higher score first; equal scores are ordered by who got there first.
+inline bool ranksAbove(const LeaderboardEntry& a, const LeaderboardEntry& b)
+{
+    return a.score != b.score ? a.score > b.score : a.timestamp < b.timestamp;
+}
+
+// Indexable skip list: every link stores how many entries it skips, so
+// insert, rank and select by position are all O(log n). Nodes live in flat
+// arrays (links are allocated per node height, 1.33 on average) to keep
+// millions of entries cheap.
+class ScoreSkipList
+{
+public:
+    ScoreSkipList();
+
+    // Returns the 0-based position of the new entry. Equal entries keep
+    // insertion order.
+    std::size_t insert(const LeaderboardEntry& entry);
+
+    // Number of entries that rank above `key`.
+    std::size_t countAbove(const LeaderboardEntry& key) const;
+    const LeaderboardEntry& select(std::size_t index) const;
+    std::size_t size() const { return entries.size() - 1; }
+
+    template<typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        for (std::uint32_t node = links[0].next; node != END; node = links[linkOffset[node]].next)
+        {
+            if (!fn(entries[node])) return;
+        }
+    }
+
+private:
+    struct Link
+    {
+        std::uint32_t next;
+        std::uint32_t width;
+    };
+
+    static constexpr int MAX_LEVEL = 20;
+    static constexpr std::uint32_t END = 0xFFFFFFFFu;
+
+    Link& link(std::uint32_t node, int level) { return links[linkOffset[node] + level]; }
+    const Link& link(std::uint32_t node, int level) const { return links[linkOffset[node] + level]; }
+    template<typename Before>
+    std::size_t countWhile(Before&& before) const;
+    int randomHeight();
+
+    // Node 0 is the head; its entry is unused.
+    std::vector<LeaderboardEntry> entries;
+    std::vector<std::uint32_t> linkOffset;
+    std::vector<Link> links;
+    std::uint32_t rngState = 0x9E3779B9u;
+};
+
+// Per-level high score tables. Entries loaded from disk stay in the
+// memory-mapped file (sorted, so rank queries binary-search it) and new
+// entries go into a ScoreSkipList; queries combine the two. Opening a file is
+// therefore O(1) in the number of entries; save() merges both into a new
+// sorted file.
+//
+// File layout (little-endian):
+//   LeaderboardFileHeader
+//   LeaderboardBoardRecord[boardCount]
+//   LeaderboardEntry arrays, one per board, sorted by ranksAbove
+class Leaderboard
+{
+public:
+    bool open(const std::string& filename);
+    bool save(const std::string& filename);
+    // Imports the old one-score-per-line highscores.txt.
+    bool importLegacy(const std::string& filename, std::string_view playerName);
+
+    // Returns the 1-based rank of the new entry.
+    std::size_t insert(const LeaderboardEntry& entry);
+
+    std::size_t size(int level) const;
+    // 1-based rank a score would get if submitted now.
+    std::size_t rankOf(int level, int score) const;
+    std::optional<LeaderboardEntry> at(int level, std::size_t index) const;
+    std::vector<LeaderboardEntry> top(int level, std::size_t count) const;
+    // Share of entries on the board with a lower score, in [0, 1].
+    float percentileOf(int level, int score) const;
+    // Score needed to be in the top (1 - percentile) of the board.
+    std::optional<int> scoreAtPercentile(int level, float percentile) const;
+
+    static LeaderboardEntry makeEntry(std::string_view name, int score, int level, std::int64_t timestamp);
+
+private:
+    struct Board
+    {
+        std::span<const LeaderboardEntry> base;
+        ScoreSkipList added;
+
+        std::size_t size() const { return base.size() + added.size(); }
+        std::size_t countAbove(const LeaderboardEntry& key) const;
+        LeaderboardEntry select(std::size_t index) const;
+    };
+
+    const Board* findBoard(int level) const;
+    bool attach(std::span<const std::byte> image);
+
+    MappedFile file;
+    // Backs the boards instead of `file` when the last save() failed.
+    std::vector<std::byte> ownedImage;
+    std::map<int, Board> boards;
+};
@@ -0,0 +1,334 @@
+#include "LevelFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+
+namespace
+{
+constexpr char LEVEL_MAGIC[8] = {'A', 'R', 'C', 'L', 'E', 'V', 'E', 'L'};
+constexpr std::uint32_t LEVEL_VERSION = 2;
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool parseColor(const std::string& text, std::uint32_t& color)
+{
+    if (text.size() != 6 && text.size() != 8) return false;
+
+    color = 0;
+    for (char c : text)
+    {
+        const int digit = hexDigit(c);
+        if (digit < 0) return false;
+        color = (color << 4) | static_cast<std::uint32_t>(digit);
+    }
+    if (text.size() == 6) color = (color << 8) | 0xFF;
+    return true;
+}
+
+// Shared by the text and binary readers, so both accept the same levels.
+bool validBrickSize(float width, float height)
+{
+    return width > 0.0f && height > 0.0f;
+}
+
+// Zero puts bricks edge to edge.
+bool validSpacing(float spacing)
+{
+    return spacing >= 0.0f;
+}
+
+bool validHitPointRange(std::int32_t minHitPoints, std::int32_t maxHitPoints)
+{
+    return minHitPoints >= 1 && maxHitPoints >= minHitPoints;
+}
+
+bool parseCell(std::string_view token, LevelCell& cell)
+{
+    cell.flags = 0;
+    if (token.size() > 2 && token.back() == '*')
+    {
+        cell.flags |= LEVEL_CELL_EXPLOSIVE;
+        token.remove_suffix(1);
+    }
+    if (token.size() < 2 || token.size() > 3) return false;
+
+    const int color = hexDigit(token[0]);
+    if (color < 0) return false;
+    cell.color = static_cast<std::uint8_t>(color);
+
+    if (token[1] == '?') cell.hitPoints = LEVEL_HIT_POINTS_RANDOM;
+    else if (token[1] >= '1' && token[1] <= '9') cell.hitPoints = static_cast<std::uint8_t>(token[1] - '0');
+    else return false;
+
+    cell.bonus = LEVEL_BONUS_NONE;
+    if (token.size() == 3)
+    {
+        switch (token[2])
+        {
+            case 's': cell.bonus = 1; break;
+            case 'f': cell.bonus = 2; break;
+            case 'b': cell.bonus = 3; break;
+            case 'l': cell.bonus = 4; break;
+            case '?': cell.bonus = LEVEL_BONUS_RANDOM; break;
+            default: return false;
+        }
+    }
+    return true;
+}
+}
+
+LevelSettings defaultLevelSettings()
+{
+    LevelSettings settings{};
+    settings.brickWidth = 80.0f;
+    settings.brickHeight = 30.0f;
+    settings.spacing = 5.0f;
+    settings.originX = 50.0f;
+    settings.originY = 50.0f;
+    settings.bonusChance = 0.8f;
+    settings.minHitPoints = 1;
+    settings.maxHitPoints = 3;
+    settings.maxBonuses = 20;
+    settings.paletteSize = 1;
+    settings.palette[0] = 0xFF0000FF;
+    return settings;
+}
+
+bool LevelReader::open(const std::string& filename)
+{
+    name = filename;
+    error = false;
+    auto file = std::make_unique<std::ifstream>(filename, std::ios::binary);
+    if (!file->is_open()) return fail("cannot open file");
+    return openStream(std::move(file));
+}
+
+bool LevelReader::openMemory(std::string image, const std::string& imageName)
+{
+    name = imageName;
+    error = false;
+    return openStream(std::make_unique<std::istringstream>(std::move(image), std::ios::binary));
+}
+
+bool LevelReader::openStream(std::unique_ptr<std::istream> stream)
+{
+    input = std::move(stream);
+    lineNumber = 0;
+
+    char magic[sizeof(LEVEL_MAGIC)] = {};
+    input->read(magic, sizeof(magic));
+    binary = input->gcount() == sizeof(magic) && std::memcmp(magic, LEVEL_MAGIC, sizeof(magic)) == 0;
+
+    if (!binary)
+    {
+        input->clear();
+        input->seekg(0);
+        return readTextSettings();
+    }
+
+    LevelFileHeader header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    input->read(reinterpret_cast<char*>(&header) + sizeof(magic), sizeof(header) - sizeof(magic));
+    if (!*input || header.version != LEVEL_VERSION || header.cellSize != sizeof(LevelCell) ||
+        header.settings.paletteSize > LEVEL_PALETTE_SIZE)
+    {
+        return fail("unsupported header");
+    }
+    const LevelSettings& stored = header.settings;
+    if (!validBrickSize(stored.brickWidth, stored.brickHeight) || !validSpacing(stored.spacing) ||
+        !validHitPointRange(stored.minHitPoints, stored.maxHitPoints) || stored.paletteSize == 0)
+    {
+        return fail("bad settings");
+    }
+    settings = header.settings;
+    cellsLeft = header.cellCount;
+    return true;
+}
+
+bool LevelReader::fail(const std::string& message)
+{
+    std::cerr << "Level " << name;
+    if (!binary && lineNumber > 0) std::cerr << ":" << lineNumber;
+    std::cerr << ": " << message << std::endl;
+    error = true;
+    return false;
+}
+
+bool LevelReader::readTextSettings()
+{
+    settings = defaultLevelSettings();
+    line.clear();
+    linePosition = 0;
+    row = 0;
+    column = 0;
+    inLayout = false;
+    lineNumber = 0;
+
+    while (std::getline(*input, line))
+    {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key)) continue;
+        if (key == "layout")
+        {
+            line.clear();
+            return true;
+        }
+
+        bool ok = true;
+        if (key == "brick") ok = static_cast<bool>(fields >> settings.brickWidth >> settings.brickHeight) &&
+                                 validBrickSize(settings.brickWidth, settings.brickHeight);
+        else if (key == "spacing") ok = static_cast<bool>(fields >> settings.spacing) && validSpacing(settings.spacing);
+        else if (key == "origin") ok = static_cast<bool>(fields >> settings.originX >> settings.originY);
+        else if (key == "hitpoints") ok = static_cast<bool>(fields >> settings.minHitPoints >> settings.maxHitPoints) &&
+                                          validHitPointRange(settings.minHitPoints, settings.maxHitPoints);
+        else if (key == "bonus") ok = static_cast<bool>(fields >> settings.bonusChance >> settings.maxBonuses);
+        else if (key == "palette")
+        {
+            settings.paletteSize = 0;
+            std::string color;
+            while (ok && fields >> color)
+            {
+                ok = settings.paletteSize < LEVEL_PALETTE_SIZE &&
+                     parseColor(color, settings.palette[settings.paletteSize++]);
+            }
+            ok = ok && settings.paletteSize > 0;
+        }
+        else return fail("unknown key '" + key + "'");
+
+        if (!ok) return fail("bad value for '" + key + "'");
+    }
+    return fail("missing layout");
+}
+
+std::size_t LevelReader::read(std::span<LevelCell> out)
+{
+    if (error || !input) return 0;
+    return binary ? readBinary(out) : readText(out);
+}
+
+std::size_t LevelReader::readBinary(std::span<LevelCell> out)
+{
+    const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(out.size(), cellsLeft));
+    input->read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(count * sizeof(LevelCell)));
+    if (static_cast<std::size_t>(input->gcount()) != count * sizeof(LevelCell))
+    {
+        fail("truncated");
+        return 0;
+    }
+    cellsLeft -= count;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (out[i].color >= settings.paletteSize || out[i].hitPoints > LEVEL_MAX_HIT_POINTS ||
+            (out[i].bonus > LEVEL_BONUS_TYPE_COUNT && out[i].bonus != LEVEL_BONUS_RANDOM))
+        {
+            fail("bad cell");
+            return 0;
+        }
+    }
+    return count;
+}
+
+// A row may be longer than the space left in `out`, so the current line and
+// position are kept between calls. Every line after `layout` is one row.
+std::size_t LevelReader::readText(std::span<LevelCell> out)
+{
+    std::size_t count = 0;
+    while (count < out.size())
+    {
+        while (linePosition < line.size() && isSpace(line[linePosition])) linePosition++;
+        if (linePosition >= line.size() || line[linePosition] == '#')
+        {
+            if (!std::getline(*input, line)) break;
+            if (inLayout) row++;
+            inLayout = true;
+            lineNumber++;
+            linePosition = 0;
+            column = 0;
+            continue;
+        }
+
+        std::size_t end = linePosition;
+        while (end < line.size() && !isSpace(line[end])) end++;
+        const std::string_view token(line.data() + linePosition, end - linePosition);
+        linePosition = end;
+
+        if (column > UINT16_MAX)
+        {
+            fail("too many columns");
+            return 0;
+        }
+        if (token != ".")
+        {
+            LevelCell cell{};
+            if (!parseCell(token, cell) || cell.color >= settings.paletteSize)
+            {
+                fail("bad cell '" + std::string(token) + "'");
+                return 0;
+            }
+            cell.row = row;
+            cell.column = static_cast<std::uint16_t>(column);
+            out[count++] = cell;
+        }
+        column++;
+    }
+    return count;
+}
+
+bool LevelWriter::open(const std::string& filename, const LevelSettings& settings)
+{
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    return open(file, settings);
+}
+
+bool LevelWriter::open(std::ostream& stream, const LevelSettings& settings)
+{
+    output = &stream;
+    start = static_cast<std::uint64_t>(stream.tellp());
+
+    LevelFileHeader header{};
+    std::memcpy(header.magic, LEVEL_MAGIC, sizeof(header.magic));
+    header.version = LEVEL_VERSION;
+    header.cellSize = sizeof(LevelCell);
+    header.settings = settings;
+    cellCount = 0;
+    return static_cast<bool>(output->write(reinterpret_cast<const char*>(&header), sizeof(header)));
+}
+
+bool LevelWriter::write(std::span<const LevelCell> cells)
+{
+    cellCount += cells.size();
+    return static_cast<bool>(output->write(reinterpret_cast<const char*>(cells.data()),
+                                           static_cast<std::streamsize>(cells.size_bytes())));
+}
+
+bool LevelWriter::close()
+{
+    const auto end = output->tellp();
+    output->seekp(static_cast<std::streamoff>(start + offsetof(LevelFileHeader, cellCount)));
+    output->write(reinterpret_cast<const char*>(&cellCount), sizeof(cellCount));
+    output->seekp(end);
+    const bool ok = !output->fail();
+    if (file.is_open()) file.close();
+    output = nullptr;
+    return ok && !file.fail();
+}
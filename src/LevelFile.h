@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+
+constexpr std::size_t LEVEL_PALETTE_SIZE = 16;
+constexpr std::uint8_t LEVEL_BONUS_NONE = 0;
+constexpr std::uint8_t LEVEL_BONUS_RANDOM = 0xFF;
+// Number of BonusType values.
+constexpr std::uint8_t LEVEL_BONUS_TYPE_COUNT = 4;
+constexpr std::uint8_t LEVEL_HIT_POINTS_RANDOM = 0;
+// Highest hit point count a text level can spell.
+constexpr std::uint8_t LEVEL_MAX_HIT_POINTS = 9;
+// LevelCell::flags bits.
+constexpr std::uint8_t LEVEL_CELL_EXPLOSIVE = 1;
+
+// Per-level tuning. Colors are RGBA packed as 0xRRGGBBAA.
+struct LevelSettings
+{
+    float brickWidth;
+    float brickHeight;
+    float spacing;
+    float originX;
+    float originY;
+    float bonusChance;
+    std::int32_t minHitPoints;
+    std::int32_t maxHitPoints;
+    std::int32_t maxBonuses;
+    std::uint32_t paletteSize;
+    std::uint32_t palette[LEVEL_PALETTE_SIZE];
+};
+
+// One brick. `bonus` is LEVEL_BONUS_NONE, LEVEL_BONUS_RANDOM or
+// 1 + BonusType; `hitPoints` is LEVEL_HIT_POINTS_RANDOM or the exact count.
+struct LevelCell
+{
+    std::uint32_t row;
+    std::uint16_t column;
+    std::uint8_t color;
+    std::uint8_t hitPoints;
+    std::uint8_t bonus;
+    std::uint8_t flags;
+    std::uint8_t reserved[2];
+};
+
+struct LevelFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t cellSize;
+    std::uint64_t cellCount;
+    LevelSettings settings;
+};
+
+static_assert(sizeof(LevelSettings) == 104 && std::is_trivially_copyable_v<LevelSettings>);
+static_assert(sizeof(LevelCell) == 12 && std::is_trivially_copyable_v<LevelCell>);
+static_assert(sizeof(LevelFileHeader) == 128 && std::is_trivially_copyable_v<LevelFileHeader>);
+
+// Level layouts come in two forms that read the same way:
+//
+// Binary (.lvl, little-endian): LevelFileHeader followed by cellCount
+// LevelCells. Only present bricks are stored.
+//
+// Text (.txt): `key values...` lines for the settings, then `layout`
+// followed by one line per row of whitespace-separated cells:
+//
+//   brick 80 30          brick width and height
+//   spacing 5
+//   origin 50 50         top-left corner of column 0, row 0
+//   hitpoints 1 3        range used for random hit points
+//   bonus 0.8 20         chance of a random bonus, bonus limit per level
+//   palette FF0000 ...   up to 16 RGB or RGBA hex colors
+//   layout
+//   0?? 1?? . 23s
+//
+// A cell is `.` for no brick, otherwise a palette index (hex digit), hit
+// points (1-9, or ? for random) and an optional bonus: s(low ball),
+// f(ast platform), b(ig platform), l(aser) or ? for random. A trailing `*`
+// makes the brick explosive. `#` starts a comment.
+//
+// Both forms are read in chunks, so memory does not grow with the level.
+class LevelReader
+{
+public:
+    bool open(const std::string& filename);
+    // Reads a level (either form) held in memory; `name` is used in errors.
+    bool openMemory(std::string image, const std::string& name);
+
+    const LevelSettings& getSettings() const { return settings; }
+
+    // Fills `out` with the next cells in file order; returns how many were
+    // read, 0 at the end. Check failed() afterwards to tell the end of the
+    // level from a parse error.
+    std::size_t read(std::span<LevelCell> out);
+    bool failed() const { return error; }
+
+private:
+    bool openStream(std::unique_ptr<std::istream> stream);
+    bool readTextSettings();
+    std::size_t readText(std::span<LevelCell> out);
+    std::size_t readBinary(std::span<LevelCell> out);
+    bool fail(const std::string& message);
+
+    std::string name;
+    std::unique_ptr<std::istream> input;
+    LevelSettings settings{};
+    bool binary = false;
+    bool error = false;
+
+    std::uint64_t cellsLeft = 0;
+
+    std::string line;
+    std::size_t linePosition = 0;
+    std::uint32_t row = 0;
+    std::uint32_t column = 0;
+    bool inLayout = false;
+    std::uint32_t lineNumber = 0;
+};
+
+// Writes the binary form; cells may be appended in any number of chunks.
+class LevelWriter
+{
+public:
+    bool open(const std::string& filename, const LevelSettings& settings);
+    // `stream` must be seekable and outlive the writer.
+    bool open(std::ostream& stream, const LevelSettings& settings);
+    bool write(std::span<const LevelCell> cells);
+    // Patches the cell count into the header.
+    bool close();
+
+private:
+    std::ofstream file;
+    std::ostream* output = nullptr;
+    std::uint64_t start = 0;
+    std::uint64_t cellCount = 0;
+};
+
+LevelSettings defaultLevelSettings();
@@ -0,0 +1,218 @@
+#include "LevelGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace
+{
+// What a cell's substream decides, before neighbours are taken into account.
+struct CellRoll
+{
+    bool brick;
+    bool bonusCandidate;
+    std::uint32_t priority;
+    float hitPointRoll;
+    // Positioned after the draws above; only read for bricks that keep a
+    // bonus, so neighbour checks stay within the first Philox block.
+    RandomStream rest;
+};
+
+class CellGenerator
+{
+public:
+    CellGenerator(const LevelGeneratorParams& params, const RandomStream& layout)
+        : params(params), layout(layout),
+          mirror(params.symmetry == LevelSymmetry::Mirror || params.symmetry == LevelSymmetry::Both),
+          flip(params.symmetry == LevelSymmetry::Flip || params.symmetry == LevelSymmetry::Both),
+          lastCanonicalRow(flip ? (params.rows - 1) / 2 : params.rows - 1)
+    {
+    }
+
+    void generateRows(std::uint32_t firstRow, std::uint32_t lastRow, std::vector<LevelCell>& out) const;
+
+private:
+    std::uint32_t canonicalRow(std::uint32_t row) const { return flip ? std::min(row, params.rows - 1 - row) : row; }
+    std::uint32_t canonicalColumn(std::uint32_t column) const
+    {
+        return mirror ? std::min(column, params.columns - 1 - column) : column;
+    }
+    // Cells that are images of each other under the symmetry share an index.
+    std::uint64_t canonicalIndex(std::uint32_t row, std::uint32_t column) const
+    {
+        return static_cast<std::uint64_t>(canonicalRow(row)) * params.columns + canonicalColumn(column);
+    }
+
+    CellRoll roll(std::uint64_t index) const;
+    bool keepsBonus(std::uint32_t row, std::uint32_t column, std::uint64_t index, const CellRoll& cell) const;
+    std::uint8_t hitPoints(std::uint32_t row, float roll) const;
+
+    const LevelGeneratorParams& params;
+    const RandomStream& layout;
+    bool mirror;
+    bool flip;
+    std::uint32_t lastCanonicalRow;
+};
+
+CellRoll CellGenerator::roll(std::uint64_t index) const
+{
+    CellRoll cell;
+    cell.rest = layout.substream(index);
+    cell.brick = cell.rest.nextFloat() < params.density;
+    cell.bonusCandidate = cell.rest.nextFloat() < params.bonusChance && cell.brick;
+    cell.priority = cell.rest();
+    cell.hitPointRoll = cell.rest.nextFloat();
+    return cell;
+}
+
+// A candidate keeps its bonus when it outranks every other candidate within
+// bonusSpacing, which needs no state shared between cells. Ties fall to the
+// lower canonical index; a candidate whose own mirror image is in range drops
+// out, so both copies of a symmetric pair behave the same way.
+bool CellGenerator::keepsBonus(std::uint32_t row, std::uint32_t column, std::uint64_t index, const CellRoll& cell) const
+{
+    const std::uint32_t spacing = params.bonusSpacing;
+    const std::uint32_t firstRow = row > spacing ? row - spacing : 0;
+    const std::uint32_t lastRow = std::min(row + spacing, params.rows - 1);
+    const std::uint32_t firstColumn = column > spacing ? column - spacing : 0;
+    const std::uint32_t lastColumn = std::min(column + spacing, params.columns - 1);
+
+    for (std::uint32_t otherRow = firstRow; otherRow <= lastRow; ++otherRow)
+    {
+        for (std::uint32_t otherColumn = firstColumn; otherColumn <= lastColumn; ++otherColumn)
+        {
+            if (otherRow == row && otherColumn == column) continue;
+
+            const std::uint64_t otherIndex = canonicalIndex(otherRow, otherColumn);
+            if (otherIndex == index) return false;
+
+            const CellRoll other = roll(otherIndex);
+            if (other.bonusCandidate &&
+                (other.priority > cell.priority || (other.priority == cell.priority && otherIndex < index)))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::uint8_t CellGenerator::hitPoints(std::uint32_t row, float roll) const
+{
+    const float t = lastCanonicalRow > 0 ? static_cast<float>(canonicalRow(row)) / lastCanonicalRow : 0.0f;
+    const float value = params.topHitPoints + (params.bottomHitPoints - params.topHitPoints) * t;
+    const float whole = std::floor(value);
+    const int rounded = static_cast<int>(whole) + (roll < value - whole ? 1 : 0);
+    return static_cast<std::uint8_t>(std::clamp(rounded, 1, static_cast<int>(LEVEL_MAX_HIT_POINTS)));
+}
+
+void CellGenerator::generateRows(std::uint32_t firstRow, std::uint32_t lastRow, std::vector<LevelCell>& out) const
+{
+    const std::uint32_t lastColor = params.settings.paletteSize - 1;
+    for (std::uint32_t row = firstRow; row < lastRow; ++row)
+    {
+        for (std::uint32_t column = 0; column < params.columns; ++column)
+        {
+            const std::uint64_t index = canonicalIndex(row, column);
+            CellRoll cell = roll(index);
+            if (!cell.brick) continue;
+
+            LevelCell& brick = out.emplace_back();
+            brick.row = row;
+            brick.column = static_cast<std::uint16_t>(column);
+            brick.hitPoints = hitPoints(row, cell.hitPointRoll);
+            brick.color = static_cast<std::uint8_t>(std::min<std::uint32_t>(brick.hitPoints - 1u, lastColor));
+            brick.bonus = cell.bonusCandidate && keepsBonus(row, column, index, cell)
+                              ? static_cast<std::uint8_t>(1 + cell.rest.nextInt(0, LEVEL_BONUS_TYPE_COUNT - 1))
+                              : LEVEL_BONUS_NONE;
+        }
+    }
+}
+}
+
+bool LevelGenerator::generate(const LevelGeneratorParams& params, const RandomStream& layout, LevelData& level,
+                              unsigned int threads)
+{
+    if (params.rows == 0 || params.columns == 0 || params.columns > UINT16_MAX + 1u ||
+        params.settings.paletteSize == 0 || params.settings.paletteSize > LEVEL_PALETTE_SIZE)
+    {
+        std::cerr << "Cannot generate a " << params.rows << "x" << params.columns << " level" << std::endl;
+        return false;
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::uint32_t bandCount = std::min<std::uint32_t>(threads, params.rows);
+    const std::uint32_t bandRows = (params.rows + bandCount - 1) / bandCount;
+    const std::size_t expectedBricks = static_cast<std::size_t>(
+        static_cast<double>(bandRows) * params.columns * std::clamp(params.density, 0.0f, 1.0f) * 1.05) + 16;
+
+    const CellGenerator generator(params, layout);
+    std::vector<std::vector<LevelCell>> bands(bandCount);
+    auto generateBand = [&](std::uint32_t band)
+    {
+        bands[band].reserve(expectedBricks);
+        generator.generateRows(std::min(band * bandRows, params.rows), std::min((band + 1) * bandRows, params.rows),
+                               bands[band]);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(bandCount - 1);
+    for (std::uint32_t band = 1; band < bandCount; ++band)
+    {
+        workers.emplace_back(generateBand, band);
+    }
+    generateBand(0);
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    level.settings = params.settings;
+    level.cells.clear();
+    std::size_t total = 0;
+    for (const auto& band : bands) total += band.size();
+    level.cells.reserve(total);
+    for (const auto& band : bands)
+    {
+        level.cells.insert(level.cells.end(), band.begin(), band.end());
+    }
+
+    // A level without bricks would be won before it starts.
+    if (level.cells.empty())
+    {
+        LevelCell brick{};
+        brick.column = static_cast<std::uint16_t>(params.columns / 2);
+        brick.hitPoints = 1;
+        level.cells.push_back(brick);
+    }
+    return true;
+}
+
+LevelGeneratorParams LevelGenerator::paramsForLevel(int number, float fieldWidth, float originX, float originY)
+{
+    const int step = std::max(number - 1, 0);
+
+    LevelGeneratorParams params;
+    params.rows = static_cast<std::uint32_t>(std::min(5 + step / 2, 12));
+    params.columns = static_cast<std::uint32_t>(std::min(8 + step / 3, 14));
+    params.symmetry = static_cast<LevelSymmetry>(number % 4);
+    params.density = std::min(0.6f + 0.03f * step, 0.95f);
+    params.topHitPoints = std::min(2.0f + 0.3f * step, static_cast<float>(LEVEL_MAX_HIT_POINTS));
+    params.bottomHitPoints = 1.0f;
+    params.bonusChance = 0.15f;
+    params.bonusSpacing = 2;
+
+    LevelSettings& settings = params.settings;
+    settings.originX = originX;
+    settings.originY = originY;
+    settings.brickHeight = 24.0f;
+    settings.brickWidth = (fieldWidth - settings.spacing * (params.columns - 1)) / params.columns;
+
+    // Weakest first.
+    constexpr std::uint32_t palette[] = {0x00FFFFFF, 0x00FF00FF, 0xFFFF00FF, 0xFFA500FF, 0xFF0000FF,
+                                         0xFF00FFFF, 0x8000FFFF, 0x4040FFFF, 0xC0C0C0FF};
+    settings.paletteSize = static_cast<std::uint32_t>(std::size(palette));
+    std::copy(std::begin(palette), std::end(palette), settings.palette);
+    return params;
+}
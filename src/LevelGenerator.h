@@ -0,0 +1,53 @@
+#pragma once
+
+#include "LevelLoader.h"
+#include "Random.h"
+#include <cstdint>
+
+enum class LevelSymmetry : std::uint8_t
+{
+    None,
+    // Left half mirrored onto the right.
+    Mirror,
+    // Top half mirrored onto the bottom.
+    Flip,
+    Both,
+};
+
+struct LevelGeneratorParams
+{
+    std::uint32_t rows = 5;
+    std::uint32_t columns = 8;
+    LevelSymmetry symmetry = LevelSymmetry::Mirror;
+    // Share of cells that hold a brick.
+    float density = 0.8f;
+    // Hit points are interpolated from the top row to the bottom row (to the
+    // middle row when flipped) and rounded up or down at random, so 1.5
+    // gives an even mix of 1 and 2.
+    float topHitPoints = 3.0f;
+    float bottomHitPoints = 1.0f;
+    // Chance that a brick is considered for a bonus.
+    float bonusChance = 0.1f;
+    // No two bonuses are closer than this many cells (Chebyshev distance).
+    std::uint32_t bonusSpacing = 2;
+    // Brick size, origin and palette; palette[i] colors bricks with i + 1
+    // hit points, the last entry everything stronger.
+    LevelSettings settings = defaultLevelSettings();
+};
+
+// Generates brick layouts from constraints. Every cell is decided from its
+// own substream of the layout stream, so rows are generated in parallel
+// bands and the result depends only on the params and the stream, never on
+// the number of threads.
+class LevelGenerator
+{
+public:
+    // `threads` = 0 uses every hardware thread. Fails on an empty grid or a
+    // grid wider than LevelCell can address.
+    static bool generate(const LevelGeneratorParams& params, const RandomStream& layout, LevelData& level,
+                         unsigned int threads = 0);
+
+    // Difficulty curve for endless play: level `number` fills `fieldWidth`
+    // pixels with bricks starting at (originX, originY).
+    static LevelGeneratorParams paramsForLevel(int number, float fieldWidth, float originX, float originY);
+};
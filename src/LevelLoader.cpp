@@ -0,0 +1,156 @@
+#include "LevelLoader.h"
+#include "BakedAssets.h"
+#include "ECS/ECSManager.h"
+#include "ECS/Components.h"
+#include "EntityFactory.h"
+#include "GameState.h"
+#include <algorithm>
+
+namespace
+{
+class BrickBuilder
+{
+public:
+    BrickBuilder(const LevelSettings& settings, ECSManager& ecs, std::vector<Entity>& bricks, const RandomStream& layout)
+        : settings(settings), ecs(ecs), bricks(bricks), layout(layout),
+          prefab(EntityFactory::brickPrefab(settings.brickWidth, settings.brickHeight))
+    {
+        for (std::uint32_t i = 0; i < settings.paletteSize; ++i)
+        {
+            palette[i] = sf::Color(settings.palette[i]);
+        }
+        bonusEntities.reserve(LevelLoader::CHUNK_SIZE);
+        explosiveEntities.reserve(LevelLoader::CHUNK_SIZE);
+    }
+
+    void add(std::span<const LevelCell> cells);
+
+private:
+    const LevelSettings& settings;
+    ECSManager& ecs;
+    std::vector<Entity>& bricks;
+    const RandomStream& layout;
+    Prefab prefab;
+
+    sf::Color palette[LEVEL_PALETTE_SIZE];
+    std::uint64_t cellIndex = 0;
+    int bonusesAdded = 0;
+
+    std::vector<Entity> bonusEntities;
+    std::vector<Entity> explosiveEntities;
+};
+
+void BrickBuilder::add(std::span<const LevelCell> cells)
+{
+    const float stepX = settings.brickWidth + settings.spacing;
+    const float stepY = settings.brickHeight + settings.spacing;
+
+    std::vector<BonusComponent> bonuses;
+    bonusEntities.clear();
+    explosiveEntities.clear();
+
+    // Bonus and explosive entities are offsets from `first` until instantiate returns it.
+    const Entity first = prefab.instantiate(ecs, cells.size(), [&](PrefabInstance& brick)
+    {
+        const LevelCell& cell = cells[brick.getIndex()];
+        // Always three draws per brick, in the same order; skipped for fully
+        // specified cells such as generated ones.
+        int randomHitPoints = 0;
+        float bonusRoll = 1.0f;
+        int bonusType = 0;
+        if (cell.hitPoints == LEVEL_HIT_POINTS_RANDOM || cell.bonus == LEVEL_BONUS_RANDOM)
+        {
+            RandomStream random = layout.substream(cellIndex);
+            randomHitPoints = random.nextInt(settings.minHitPoints, settings.maxHitPoints);
+            bonusRoll = random.nextFloat();
+            bonusType = random.nextInt(0, LEVEL_BONUS_TYPE_COUNT - 1);
+        }
+        cellIndex++;
+
+        brick.get<PositionComponent>().position = {settings.originX + cell.column * stepX,
+                                                   settings.originY + cell.row * stepY};
+        brick.get<ShapeComponent>().color = palette[cell.color];
+        brick.get<DurableBrick>() = DurableBrick(cell.hitPoints == LEVEL_HIT_POINTS_RANDOM ? randomHitPoints
+                                                                                            : cell.hitPoints);
+        if (cell.flags & LEVEL_CELL_EXPLOSIVE)
+        {
+            explosiveEntities.push_back(static_cast<Entity>(brick.getIndex()));
+        }
+
+        if (cell.bonus == LEVEL_BONUS_NONE) return;
+        if (cell.bonus == LEVEL_BONUS_RANDOM)
+        {
+            if (bonusesAdded >= settings.maxBonuses || bonusRoll >= settings.bonusChance) return;
+            bonuses.emplace_back(static_cast<BonusType>(bonusType));
+        }
+        else
+        {
+            bonuses.emplace_back(static_cast<BonusType>(cell.bonus - 1));
+        }
+        bonusEntities.push_back(static_cast<Entity>(brick.getIndex()));
+        bonusesAdded++;
+    });
+
+    for (Entity& entity : bonusEntities)
+    {
+        entity += first;
+    }
+    ecs.addComponents(std::span<const Entity>(bonusEntities), std::move(bonuses));
+
+    for (Entity& entity : explosiveEntities)
+    {
+        entity += first;
+    }
+    ecs.addComponents(std::span<const Entity>(explosiveEntities),
+                      std::vector<ExplosiveBrick>(explosiveEntities.size(), ExplosiveBrick(GAME_STATE.EXPLOSION_RADIUS)));
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+        bricks.push_back(first + static_cast<Entity>(i));
+    }
+}
+}
+
+bool LevelLoader::load(LevelReader& reader, ECSManager& ecs, std::vector<Entity>& bricks, const RandomStream& layout)
+{
+    BrickBuilder builder(reader.getSettings(), ecs, bricks, layout);
+    std::vector<LevelCell> cells(CHUNK_SIZE);
+    while (std::size_t count = reader.read(cells))
+    {
+        builder.add(std::span<const LevelCell>(cells.data(), count));
+    }
+    return !reader.failed();
+}
+
+void LevelLoader::instantiate(const LevelData& level, ECSManager& ecs, std::vector<Entity>& bricks,
+                              const RandomStream& layout)
+{
+    BrickBuilder builder(level.settings, ecs, bricks, layout);
+    bricks.reserve(bricks.size() + level.cells.size());
+    for (std::size_t offset = 0; offset < level.cells.size(); offset += CHUNK_SIZE)
+    {
+        const std::size_t count = std::min(CHUNK_SIZE, level.cells.size() - offset);
+        builder.add(std::span<const LevelCell>(level.cells.data() + offset, count));
+    }
+}
+
+bool LevelLoader::decodeBaked(int number, LevelData& level)
+{
+    const BakedLevel* baked = BakedAssets::findLevel(number);
+    std::string image;
+    if (!baked || !BakedAssets::unpack(baked->asset, image)) return false;
+
+    LevelReader reader;
+    if (!reader.openMemory(std::move(image), std::string(baked->asset.name))) return false;
+
+    level.settings = reader.getSettings();
+    level.cells.resize(baked->brickCount);
+    std::size_t count = 0;
+    while (count < level.cells.size())
+    {
+        const std::size_t read = reader.read(std::span<LevelCell>(level.cells.data() + count, level.cells.size() - count));
+        if (read == 0) break;
+        count += read;
+    }
+    level.cells.resize(count);
+    return !reader.failed();
+}
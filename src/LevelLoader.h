@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ECS/Entity.h"
+#include "LevelFile.h"
+#include "Random.h"
+#include <span>
+#include <vector>
+
+class ECSManager;
+
+// A level decoded into memory so that it can be instantiated repeatedly.
+struct LevelData
+{
+    LevelSettings settings{};
+    std::vector<LevelCell> cells;
+};
+
+// Turns level cells into bricks a chunk at a time: each chunk becomes a run
+// of consecutive entities whose components are added in bulk, one allocation
+// per component type per chunk.
+class LevelLoader
+{
+public:
+    static constexpr std::size_t CHUNK_SIZE = 4096;
+
+    // Streams the level into `ecs`, appending the bricks to `bricks`. Random
+    // hit points and bonuses for the i-th brick come from
+    // `layout.substream(i)`, so a brick's outcome does not depend on the
+    // bricks before it.
+    static bool load(LevelReader& reader, ECSManager& ecs, std::vector<Entity>& bricks, const RandomStream& layout);
+    static void instantiate(const LevelData& level, ECSManager& ecs, std::vector<Entity>& bricks,
+                            const RandomStream& layout);
+
+    // Decodes level `number` from the copy baked into the executable.
+    static bool decodeBaked(int number, LevelData& level);
+};
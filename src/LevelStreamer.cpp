@@ -0,0 +1,286 @@
+#include "LevelStreamer.h"
+#include "ECS/Components.h"
+#include "ECS/ECSManager.h"
+#include "LevelLoader.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+constexpr std::size_t READ_BATCH = 1024;
+}
+
+LevelStreamer::~LevelStreamer()
+{
+    close();
+}
+
+bool LevelStreamer::open(const std::string& levelFilename, const RandomStream& levelLayout, float floor, float speed)
+{
+    close();
+    filename = levelFilename;
+    layout = levelLayout;
+    floorY = floor;
+    scrollSpeed = speed;
+    if (!openReader()) return false;
+    settings = reader.getSettings();
+    opened = true;
+    return true;
+}
+
+void LevelStreamer::close()
+{
+    loader.stop();
+    chunks.clear();
+    ready.clear();
+    opened = false;
+}
+
+bool LevelStreamer::openReader()
+{
+    pending.clear();
+    pendingPosition = 0;
+    nextChunk = 0;
+    lastRow = 0;
+    readerDone = false;
+    requested = 0;
+    delivered = 0;
+    exhausted = false;
+    allRead = false;
+    return reader.open(filename);
+}
+
+void LevelStreamer::restart(ECSManager& ecs, std::vector<Entity>& bricks)
+{
+    if (!opened) return;
+
+    loader.stop();
+    for (const Chunk& chunk : chunks)
+    {
+        for (Entity entity : chunk.entities)
+        {
+            ecs.destroyEntity(entity);
+        }
+    }
+    chunks.clear();
+    ready.clear();
+    bricks.clear();
+    scrollOffset = 0.0;
+    if (!openReader())
+    {
+        opened = false;
+        return;
+    }
+    loader.start();
+
+    // Block until the chunks on screen are in; later ones stream in play.
+    while (true)
+    {
+        requestChunks();
+        receiveChunks(!allRead);
+        for (Chunk& chunk : chunks)
+        {
+            if (!chunk.active && nearScreen(chunk)) activate(chunk, ecs, bricks);
+        }
+        if (allRead || (!chunks.empty() && !chunks.back().active)) break;
+    }
+}
+
+void LevelStreamer::update(float deltaTime, ECSManager& ecs, std::vector<Entity>& bricks)
+{
+    if (!opened) return;
+
+    receiveChunks(false);
+    requestChunks();
+
+    // Lowest bottom edge among the remaining bricks; cleared chunks at the
+    // front are dropped on the way.
+    float lowest = -std::numeric_limits<float>::infinity();
+    while (!chunks.empty() && chunks.front().active)
+    {
+        Chunk& chunk = chunks.front();
+        bool live = false;
+        for (Entity entity : chunk.entities)
+        {
+            if (auto position = ecs.getComponent<PositionComponent>(entity))
+            {
+                lowest = std::max(lowest, position->position.y + settings.brickHeight);
+                live = true;
+            }
+        }
+        if (live) break;
+
+        bricks.erase(bricks.begin(), bricks.begin() + static_cast<std::ptrdiff_t>(chunk.entities.size()));
+        chunks.pop_front();
+    }
+    for (std::size_t i = 1; i < chunks.size() && chunks[i].active; ++i)
+    {
+        for (Entity entity : chunks[i].entities)
+        {
+            if (auto position = ecs.getComponent<PositionComponent>(entity))
+            {
+                lowest = std::max(lowest, position->position.y + settings.brickHeight);
+            }
+        }
+    }
+
+    // With nothing left on screen, head for the next chunk instead.
+    if (lowest == -std::numeric_limits<float>::infinity())
+    {
+        for (const Chunk& chunk : chunks)
+        {
+            if (chunk.active) continue;
+            lowest = rowY(chunk.index * CHUNK_ROWS) + settings.brickHeight;
+            break;
+        }
+    }
+    if (lowest < floorY)
+    {
+        scroll(std::min(floorY - lowest, scrollSpeed * deltaTime), ecs);
+    }
+
+    for (Chunk& chunk : chunks)
+    {
+        if (chunk.active) continue;
+        if (!nearScreen(chunk)) break;
+        activate(chunk, ecs, bricks);
+    }
+}
+
+bool LevelStreamer::isFinished()
+{
+    receiveChunks(false);
+    return opened && allRead && requested == 0 && chunks.empty();
+}
+
+void LevelStreamer::requestChunks()
+{
+    if (allRead) return;
+
+    std::size_t loaded = 0;
+    for (const Chunk& chunk : chunks)
+    {
+        if (!chunk.active) loaded++;
+    }
+    for (; loaded + requested < CHUNKS_AHEAD; ++requested)
+    {
+        loader.post([this] { readChunk(); });
+    }
+}
+
+void LevelStreamer::receiveChunks(bool wait)
+{
+    std::unique_lock<std::mutex> lock(readyMutex);
+    if (wait)
+    {
+        chunkReady.wait(lock, [this] { return !ready.empty() || exhausted; });
+    }
+    while (!ready.empty())
+    {
+        chunks.push_back(std::move(ready.front()));
+        ready.pop_front();
+    }
+    requested -= delivered;
+    delivered = 0;
+    allRead = exhausted;
+}
+
+// Loader thread. Reads cells up to the end of the next chunk; cells past it
+// stay in `pending` for the following call.
+void LevelStreamer::readChunk()
+{
+    Chunk chunk;
+    bool produced = false;
+    if (!readerDone || pendingPosition < pending.size())
+    {
+        chunk.index = nextChunk++;
+        const std::uint64_t endRow = static_cast<std::uint64_t>(chunk.index + 1) * CHUNK_ROWS;
+        while (true)
+        {
+            while (pendingPosition < pending.size() && pending[pendingPosition].row < endRow)
+            {
+                chunk.cells.push_back(pending[pendingPosition++]);
+            }
+            if (pendingPosition < pending.size() || readerDone) break;
+
+            pending.resize(READ_BATCH);
+            pending.resize(reader.read(pending));
+            pendingPosition = 0;
+            if (pending.empty())
+            {
+                readerDone = true;
+                continue;
+            }
+            for (const LevelCell& cell : pending)
+            {
+                if (cell.row < lastRow)
+                {
+                    std::cerr << "Level " << filename << ": rows out of order" << std::endl;
+                    pending.clear();
+                    readerDone = true;
+                    break;
+                }
+                lastRow = cell.row;
+            }
+        }
+        produced = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        if (produced) ready.push_back(std::move(chunk));
+        exhausted = readerDone && pendingPosition >= pending.size();
+        delivered++;
+    }
+    chunkReady.notify_all();
+}
+
+float LevelStreamer::rowY(std::uint32_t row) const
+{
+    const double stepY = settings.brickHeight + settings.spacing;
+    return static_cast<float>(floorY - settings.brickHeight - row * stepY + scrollOffset);
+}
+
+// Within one chunk height above the top of the screen.
+bool LevelStreamer::nearScreen(const Chunk& chunk) const
+{
+    const float chunkHeight = CHUNK_ROWS * (settings.brickHeight + settings.spacing);
+    return rowY(chunk.index * CHUNK_ROWS) + settings.brickHeight > -chunkHeight;
+}
+
+// Row r of the level is row (top - r) of a chunk-sized level whose origin is
+// the chunk's top row, so LevelLoader lays it out bottom-up.
+void LevelStreamer::activate(Chunk& chunk, ECSManager& ecs, std::vector<Entity>& bricks)
+{
+    const std::uint32_t top = chunk.index * CHUNK_ROWS + CHUNK_ROWS - 1;
+    LevelData data;
+    data.settings = settings;
+    data.settings.originY = rowY(top);
+    data.cells = std::move(chunk.cells);
+    for (LevelCell& cell : data.cells)
+    {
+        cell.row = top - cell.row;
+    }
+
+    LevelLoader::instantiate(data, ecs, chunk.entities, layout.substream(chunk.index));
+    bricks.insert(bricks.end(), chunk.entities.begin(), chunk.entities.end());
+    chunk.cells = std::vector<LevelCell>();
+    chunk.active = true;
+}
+
+void LevelStreamer::scroll(float distance, ECSManager& ecs)
+{
+    scrollOffset += distance;
+    for (const Chunk& chunk : chunks)
+    {
+        if (!chunk.active) break;
+        for (Entity entity : chunk.entities)
+        {
+            if (auto position = ecs.getComponent<PositionComponent>(entity))
+            {
+                position->position.y += distance;
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "ECS/Entity.h"
+#include "LevelFile.h"
+#include "Random.h"
+#include "TaskWorker.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ECSManager;
+
+// Plays a level taller than the screen. Row 0 is the bottom row; the level
+// is read in chunks of CHUNK_ROWS rows on a background thread, a few chunks
+// ahead of play. A chunk becomes bricks (is activated) as it nears the top
+// of the screen and is dropped once all of its bricks are gone, so only a
+// window of chunks is ever resident however long the level is.
+//
+// The camera follows progress by moving the active bricks down until the
+// lowest remaining one reaches `floorY`; everything else keeps working in
+// screen coordinates and only sees the active chunks.
+//
+// Cells must be sorted by row, as LevelReader returns text levels and as
+// LevelWriter stores generated ones.
+class LevelStreamer
+{
+public:
+    static constexpr std::uint32_t CHUNK_ROWS = 8;
+    // Chunks read ahead of the last active one.
+    static constexpr std::size_t CHUNKS_AHEAD = 3;
+
+    LevelStreamer() = default;
+    ~LevelStreamer();
+
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+    // Random hit points and bonuses of chunk n come from
+    // `layout.substream(n)`.
+    bool open(const std::string& filename, const RandomStream& layout, float floorY, float scrollSpeed);
+    void close();
+    bool isOpen() const { return opened; }
+
+    // Destroys the active bricks, rewinds to row 0 and activates the chunks
+    // on screen, replacing the contents of `bricks`.
+    void restart(ECSManager& ecs, std::vector<Entity>& bricks);
+    // Scrolls, activates and drops chunks. `bricks` holds the active bricks
+    // in activation order; dropped chunks are erased from its front.
+    void update(float deltaTime, ECSManager& ecs, std::vector<Entity>& bricks);
+    // True once every chunk has been read, activated and cleared.
+    bool isFinished();
+
+    std::size_t getResidentChunks() const { return chunks.size(); }
+
+private:
+    struct Chunk
+    {
+        std::uint32_t index = 0;
+        std::vector<LevelCell> cells;
+        std::vector<Entity> entities;
+        bool active = false;
+    };
+
+    bool openReader();
+    void requestChunks();
+    void receiveChunks(bool wait);
+    void readChunk();
+    float rowY(std::uint32_t row) const;
+    bool nearScreen(const Chunk& chunk) const;
+    void activate(Chunk& chunk, ECSManager& ecs, std::vector<Entity>& bricks);
+    void scroll(float distance, ECSManager& ecs);
+
+    std::string filename;
+    RandomStream layout;
+    float floorY = 0.0f;
+    float scrollSpeed = 0.0f;
+    bool opened = false;
+    LevelSettings settings{};
+
+    // Main thread.
+    std::deque<Chunk> chunks;
+    std::size_t requested = 0;
+    bool allRead = false;
+    // Double: marathon levels scroll further than a float can place a brick.
+    double scrollOffset = 0.0;
+
+    // Loader thread, except while it is stopped.
+    TaskWorker loader;
+    LevelReader reader;
+    std::vector<LevelCell> pending;
+    std::size_t pendingPosition = 0;
+    std::uint32_t nextChunk = 0;
+    std::uint32_t lastRow = 0;
+    bool readerDone = false;
+
+    std::mutex readyMutex;
+    std::condition_variable chunkReady;
+    std::deque<Chunk> ready;
+    std::size_t delivered = 0;
+    bool exhausted = false;
+};
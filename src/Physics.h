@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Fixed.h"
+#include <algorithm>
+#include <cmath>
+
+// Number type of the ball and paddle physics. Float math can round
+// differently between compilers, fused multiply-adds, -ffast-math and
+// vector and scalar code; building with ARCANOID_FIXED_POINT computes
+// positions, velocities, collisions and speed normalization in 16.16 fixed
+// point instead, which gives the same bits everywhere, so replays, lockstep
+// games and parallel evaluations reproduce from their inputs alone.
+#ifdef ARCANOID_FIXED_POINT
+using Scalar = Fixed<16>;
+#else
+using Scalar = float;
+#endif
+
+// Ball and paddle physics of MovementSystem, CollisionSystem and
+// BallSpeedSystem, shared with VectorEnv so both step a game the same way.
+// Components keep floats: callers convert to S, call these and convert the
+// results back. The conversions round the same way on every platform, and
+// with S = float they are no-ops.
+namespace Physics
+{
+
+template<typename S>
+S advance(S position, S velocity, S deltaTime)
+{
+    return position + velocity * deltaTime;
+}
+
+template<typename S>
+S length(S x, S y)
+{
+    using std::sqrt;
+    return sqrt(x * x + y * y);
+}
+
+// Scales the velocity to `speed`, keeping its direction.
+template<typename S>
+void setSpeed(S& vx, S& vy, S speed)
+{
+    const S currentSpeed = length(vx, vy);
+    if (currentSpeed > S(0.0f))
+    {
+        vx = vx * (speed / currentSpeed);
+        vy = vy * (speed / currentSpeed);
+    }
+}
+
+// Multiplies the speed multiplier by `factor` unless that takes it past
+// `maximum`; returns whether it did.
+template<typename S>
+bool increaseMultiplier(S& multiplier, S factor, S maximum)
+{
+    const S next = multiplier * factor;
+    if (next > maximum) return false;
+    multiplier = next;
+    return true;
+}
+
+// Bounces the ball off the left, right and top of the window.
+template<typename S>
+void bounceOffWalls(S& x, S& y, S& vx, S& vy, S radius, S width)
+{
+    if (x - radius < S(0.0f))
+    {
+        x = radius;
+        vx = -vx;
+    }
+    if (x + radius > width)
+    {
+        x = width - radius;
+        vx = -vx;
+    }
+    if (y - radius < S(0.0f))
+    {
+        y = radius;
+        vy = -vy;
+    }
+}
+
+template<typename S>
+S clampPaddle(S x, S paddleWidth, S width)
+{
+    if (x < S(0.0f)) x = S(0.0f);
+    if (x + paddleWidth > width) x = width - paddleWidth;
+    return x;
+}
+
+// A ball moving down into the paddle leaves upwards at its speed, angled by
+// how far from the paddle's center it hit, resting on the paddle. Returns
+// whether it bounced.
+template<typename S>
+bool bounceOffPaddle(S x, S& y, S& vx, S& vy, S radius, S speed, S paddleX, S paddleY, S paddleWidth,
+                     S paddleHeight)
+{
+    using std::abs;
+    const bool colliding = x + radius > paddleX && x - radius < paddleX + paddleWidth && y + radius > paddleY &&
+                           y - radius < paddleY + paddleHeight;
+    if (!colliding || !(vy > S(0.0f))) return false;
+
+    vy = -abs(vy);
+    if (paddleWidth > S(0.0f))
+    {
+        const S paddleCenterX = paddleX + paddleWidth / S(2.0f);
+        const S relativeIntersectX = (x - paddleCenterX) / (paddleWidth / S(2.0f));
+        vx = relativeIntersectX * speed * S(0.5f);
+    }
+    else
+    {
+        vx = S(0.0f);
+    }
+    setSpeed(vx, vy, speed);
+    y = paddleY - radius;
+    return true;
+}
+
+// Reflects the ball off the side of the brick nearest its center and puts it
+// against that side.
+template<typename S>
+void bounceOffBrick(S& x, S& y, S& vx, S& vy, S radius, S left, S top, S right, S bottom)
+{
+    using std::abs;
+    const S distLeft = abs(x - left);
+    const S distRight = abs(x - right);
+    const S distTop = abs(y - top);
+    const S distBottom = abs(y - bottom);
+    const S minDist = std::min({distLeft, distRight, distTop, distBottom});
+    if (minDist == distLeft)
+    {
+        vx = -vx;
+        x = left - radius;
+    }
+    else if (minDist == distRight)
+    {
+        vx = -vx;
+        x = right + radius;
+    }
+    else if (minDist == distTop)
+    {
+        vy = -vy;
+        y = top - radius;
+    }
+    else
+    {
+        vy = -vy;
+        y = bottom + radius;
+    }
+}
+
+}
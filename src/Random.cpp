@@ -0,0 +1,87 @@
+#include "Random.h"
+#include <random>
+
+namespace
+{
+constexpr std::uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+// Third counter word; keeps draws and derived keys from ever sharing a counter.
+constexpr std::uint32_t DOMAIN_DRAW = 0;
+constexpr std::uint32_t DOMAIN_SUBSTREAM = 1;
+constexpr std::uint32_t DOMAIN_NAMED = 2;
+
+std::array<std::uint32_t, 2> splitKey(std::uint64_t key)
+{
+    return {static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)};
+}
+
+std::uint64_t deriveKey(std::uint64_t key, std::uint64_t value, std::uint32_t domain)
+{
+    const auto out = philox4x32({static_cast<std::uint32_t>(value), static_cast<std::uint32_t>(value >> 32), domain, 0},
+                                splitKey(key));
+    return static_cast<std::uint64_t>(out[1]) << 32 | out[0];
+}
+}
+
+std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key)
+{
+    for (int round = 0; round < 10; ++round)
+    {
+        const std::uint64_t product0 = static_cast<std::uint64_t>(PHILOX_M0) * counter[0];
+        const std::uint64_t product1 = static_cast<std::uint64_t>(PHILOX_M1) * counter[2];
+        counter = {static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(product1),
+                   static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(product0)};
+        key[0] += PHILOX_W0;
+        key[1] += PHILOX_W1;
+    }
+    return counter;
+}
+
+RandomStream::result_type RandomStream::operator()()
+{
+    if (used == buffer.size())
+    {
+        buffer = philox4x32({static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32), DOMAIN_DRAW, 0},
+                            splitKey(key));
+        block++;
+        used = 0;
+    }
+    return buffer[used++];
+}
+
+float RandomStream::nextFloat()
+{
+    return static_cast<float>((*this)() >> 8) * (1.0f / 16777216.0f);
+}
+
+// Multiply-shift range reduction (Lemire); the bias is below 2^-32 * range.
+int RandomStream::nextInt(int low, int high)
+{
+    const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(high) - low) + 1;
+    return static_cast<int>(low + static_cast<std::int64_t>((range * (*this)()) >> 32));
+}
+
+RandomStream RandomStream::substream(std::uint64_t index) const
+{
+    return RandomStream(deriveKey(key, index, DOMAIN_SUBSTREAM));
+}
+
+RandomStream RandomService::stream(std::string_view name) const
+{
+    // FNV-1a
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : name)
+    {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+    }
+    return RandomStream(deriveKey(seed, hash, DOMAIN_NAMED));
+}
+
+std::uint64_t RandomService::randomSeed()
+{
+    std::random_device device;
+    return static_cast<std::uint64_t>(device()) << 32 | device();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2,
+// 3"): a keyed bijection on 128-bit counters. Output depends only on the
+// counter and key, so any element of any stream can be computed directly,
+// from any thread, without shared state.
+std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key);
+
+// A sequence of random numbers identified by a 64-bit key. Satisfies
+// UniformRandomBitGenerator, but prefer nextInt/nextFloat: the standard
+// distributions are implementation-defined and would break reproducibility
+// across platforms.
+class RandomStream
+{
+public:
+    using result_type = std::uint32_t;
+
+    RandomStream() = default;
+    explicit RandomStream(std::uint64_t key) : key(key) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()();
+
+    // Uniform in [0, 1).
+    float nextFloat();
+    // Uniform in [low, high].
+    int nextInt(int low, int high);
+
+    // Independent stream for item `index` (a brick, a particle burst...).
+    // Depends only on this stream's key, not on how much of it was used.
+    RandomStream substream(std::uint64_t index) const;
+    std::uint64_t getKey() const { return key; }
+
+private:
+    std::uint64_t key = 0;
+    std::uint64_t block = 0;
+    std::array<std::uint32_t, 4> buffer{};
+    unsigned int used = 4;
+};
+
+// Hands out named streams derived from one seed, so every subsystem draws
+// from its own sequence and a run can be reproduced from the seed alone.
+class RandomService
+{
+public:
+    explicit RandomService(std::uint64_t seed = 0) : seed(seed) {}
+
+    void setSeed(std::uint64_t value) { seed = value; }
+    std::uint64_t getSeed() const { return seed; }
+
+    RandomStream stream(std::string_view name) const;
+
+    // A fresh seed from std::random_device.
+    static std::uint64_t randomSeed();
+
+private:
+    std::uint64_t seed;
+};
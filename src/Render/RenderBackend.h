@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+
+enum class TextAlign
+{
+    Left,
+    Center
+};
+
+// Drawing surface used by RenderSystem and the HUD. Outlines are drawn
+// outside the shape, matching sf::Shape::setOutlineThickness.
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual sf::Vector2u getSize() const = 0;
+
+    virtual void clear(sf::Color color) = 0;
+    virtual void fillRect(sf::Vector2f position, sf::Vector2f size, sf::Color color) = 0;
+    virtual void outlineRect(sf::Vector2f position, sf::Vector2f size, float thickness, sf::Color color) = 0;
+    virtual void fillCircle(sf::Vector2f center, float radius, sf::Color color) = 0;
+    virtual void outlineCircle(sf::Vector2f center, float radius, float thickness, sf::Color color) = 0;
+
+    // With TextAlign::Center, position.x is the horizontal center of the text.
+    virtual void drawText(const sf::String& text, sf::Vector2f position, unsigned int characterSize,
+                          sf::Color color, TextAlign align = TextAlign::Left, bool bold = false) = 0;
+
+    // Batched square particles centered on (x[i], y[i]); colors are RGBA as
+    // produced by sf::Color::toInteger().
+    virtual void drawParticles(const float* x, const float* y, const std::uint32_t* colors,
+                               std::size_t count, float size) = 0;
+
+    virtual void present() = 0;
+};
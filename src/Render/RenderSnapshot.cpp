@@ -0,0 +1,94 @@
+#include "RenderSnapshot.h"
+
+void RenderSnapshot::push(CommandType type, sf::Vector2f position, sf::Vector2f commandSize, float thickness, sf::Color color)
+{
+    commands.push_back({type, TextAlign::Left, false, color, position, commandSize, thickness, 0, 0});
+}
+
+void RenderSnapshot::clear(sf::Color color)
+{
+    commands.clear();
+    textCount = 0;
+    particleX.clear();
+    particleY.clear();
+    particleColors.clear();
+    push(CommandType::Clear, {}, {}, 0.0f, color);
+}
+
+void RenderSnapshot::fillRect(sf::Vector2f position, sf::Vector2f rectSize, sf::Color color)
+{
+    push(CommandType::FillRect, position, rectSize, 0.0f, color);
+}
+
+void RenderSnapshot::outlineRect(sf::Vector2f position, sf::Vector2f rectSize, float thickness, sf::Color color)
+{
+    push(CommandType::OutlineRect, position, rectSize, thickness, color);
+}
+
+void RenderSnapshot::fillCircle(sf::Vector2f center, float radius, sf::Color color)
+{
+    push(CommandType::FillCircle, center, {radius, radius}, 0.0f, color);
+}
+
+void RenderSnapshot::outlineCircle(sf::Vector2f center, float radius, float thickness, sf::Color color)
+{
+    push(CommandType::OutlineCircle, center, {radius, radius}, thickness, color);
+}
+
+void RenderSnapshot::drawText(const sf::String& text, sf::Vector2f position, unsigned int characterSize,
+                              sf::Color color, TextAlign align, bool bold)
+{
+    if (textCount == texts.size())
+        texts.push_back(text);
+    else
+        texts[textCount] = text;
+
+    commands.push_back({CommandType::Text, align, bold, color, position, {}, 0.0f,
+                        static_cast<std::uint32_t>(textCount), characterSize});
+    textCount++;
+}
+
+void RenderSnapshot::drawParticles(const float* x, const float* y, const std::uint32_t* colors,
+                                   std::size_t count, float size)
+{
+    const std::size_t first = particleX.size();
+    particleX.insert(particleX.end(), x, x + count);
+    particleY.insert(particleY.end(), y, y + count);
+    particleColors.insert(particleColors.end(), colors, colors + count);
+
+    commands.push_back({CommandType::Particles, TextAlign::Left, false, sf::Color::White, {}, {}, size,
+                        static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(count)});
+}
+
+void RenderSnapshot::replay(RenderBackend& target) const
+{
+    for (const Command& command : commands)
+    {
+        switch (command.type)
+        {
+            case CommandType::Clear:
+                target.clear(command.color);
+                break;
+            case CommandType::FillRect:
+                target.fillRect(command.position, command.size, command.color);
+                break;
+            case CommandType::OutlineRect:
+                target.outlineRect(command.position, command.size, command.thickness, command.color);
+                break;
+            case CommandType::FillCircle:
+                target.fillCircle(command.position, command.size.x, command.color);
+                break;
+            case CommandType::OutlineCircle:
+                target.outlineCircle(command.position, command.size.x, command.thickness, command.color);
+                break;
+            case CommandType::Text:
+                target.drawText(texts[command.index], command.position, command.count,
+                                command.color, command.align, command.bold);
+                break;
+            case CommandType::Particles:
+                target.drawParticles(particleX.data() + command.index, particleY.data() + command.index,
+                                     particleColors.data() + command.index, command.count, command.thickness);
+                break;
+        }
+    }
+}
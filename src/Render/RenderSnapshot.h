@@ -0,0 +1,68 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <cstdint>
+#include <vector>
+
+// Immutable-once-published record of one frame: every draw call made against
+// it is stored by value and replayed later on another backend. Calling
+// clear() starts a new frame and reuses the previous allocations.
+class RenderSnapshot : public RenderBackend
+{
+public:
+    void setSize(sf::Vector2u newSize) { size = newSize; }
+    sf::Vector2u getSize() const override { return size; }
+
+    void clear(sf::Color color) override;
+    void fillRect(sf::Vector2f position, sf::Vector2f size, sf::Color color) override;
+    void outlineRect(sf::Vector2f position, sf::Vector2f size, float thickness, sf::Color color) override;
+    void fillCircle(sf::Vector2f center, float radius, sf::Color color) override;
+    void outlineCircle(sf::Vector2f center, float radius, float thickness, sf::Color color) override;
+    void drawText(const sf::String& text, sf::Vector2f position, unsigned int characterSize,
+                  sf::Color color, TextAlign align = TextAlign::Left, bool bold = false) override;
+
+    void drawParticles(const float* x, const float* y, const std::uint32_t* colors,
+                       std::size_t count, float size) override;
+
+    void present() override {}
+
+    void replay(RenderBackend& target) const;
+    std::size_t getCommandCount() const { return commands.size(); }
+
+private:
+    enum class CommandType : std::uint8_t
+    {
+        Clear,
+        FillRect,
+        OutlineRect,
+        FillCircle,
+        OutlineCircle,
+        Text,
+        Particles
+    };
+
+    struct Command
+    {
+        CommandType type;
+        TextAlign align;
+        bool bold;
+        sf::Color color;
+        sf::Vector2f position;
+        sf::Vector2f size;
+        float thickness;
+        // Text: index into texts and character size.
+        // Particles: first element in the particle arrays and element count.
+        std::uint32_t index;
+        std::uint32_t count;
+    };
+
+    void push(CommandType type, sf::Vector2f position, sf::Vector2f size, float thickness, sf::Color color);
+
+    sf::Vector2u size;
+    std::vector<Command> commands;
+    std::vector<sf::String> texts;
+    std::size_t textCount = 0;
+    std::vector<float> particleX;
+    std::vector<float> particleY;
+    std::vector<std::uint32_t> particleColors;
+};
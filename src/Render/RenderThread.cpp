@@ -0,0 +1,65 @@
+#include "RenderThread.h"
+
+RenderThread::RenderThread(RenderBackend& backend, sf::RenderWindow* window)
+    : backend(backend), window(window)
+{
+}
+
+RenderThread::~RenderThread()
+{
+    stop();
+}
+
+void RenderThread::start()
+{
+    if (running) return;
+
+    if (window)
+        (void)window->setActive(false);
+
+    running = true;
+    thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop()
+{
+    if (!running) return;
+
+    running = false;
+    snapshots.publish();
+    thread.join();
+
+    if (window)
+        (void)window->setActive(true);
+}
+
+RenderSnapshot& RenderThread::beginFrame()
+{
+    RenderSnapshot& snapshot = snapshots.writeBuffer();
+    snapshot.setSize(backend.getSize());
+    return snapshot;
+}
+
+void RenderThread::publish()
+{
+    snapshots.publish();
+}
+
+void RenderThread::run()
+{
+    if (window)
+        (void)window->setActive(true);
+
+    while (true)
+    {
+        snapshots.waitForPublish();
+        snapshots.consume();
+        if (!running) break;
+
+        snapshots.readBuffer().replay(backend);
+        backend.present();
+    }
+
+    if (window)
+        (void)window->setActive(false);
+}
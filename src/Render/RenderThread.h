@@ -0,0 +1,34 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <thread>
+
+// Replays published RenderSnapshots on a dedicated thread so that presenting
+// (and vsync blocking) never stalls the simulation. When a window is given,
+// its GL context is moved to the render thread for the thread's lifetime.
+class RenderThread
+{
+public:
+    explicit RenderThread(RenderBackend& backend, sf::RenderWindow* window = nullptr);
+    ~RenderThread();
+
+    void start();
+    void stop();
+
+    // Producer side: record into beginFrame(), then publish().
+    RenderSnapshot& beginFrame();
+    void publish();
+
+private:
+    void run();
+
+    RenderBackend& backend;
+    sf::RenderWindow* window;
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::atomic<bool> running{false};
+    std::thread thread;
+};
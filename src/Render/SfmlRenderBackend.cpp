@@ -0,0 +1,111 @@
+#include "SfmlRenderBackend.h"
+#include "../GameState.h"
+
+SfmlRenderBackend::SfmlRenderBackend(sf::RenderWindow& window)
+    : window(window)
+{
+}
+
+sf::Vector2u SfmlRenderBackend::getSize() const
+{
+    return {GAME_STATE.WINDOW_WIDTH, GAME_STATE.WINDOW_HEIGHT};
+}
+
+void SfmlRenderBackend::clear(sf::Color color)
+{
+    sf::View view;
+    view.setSize({static_cast<float>(GAME_STATE.WINDOW_WIDTH), static_cast<float>(GAME_STATE.WINDOW_HEIGHT)});
+    view.setCenter({static_cast<float>(GAME_STATE.WINDOW_WIDTH) / 2.0f, static_cast<float>(GAME_STATE.WINDOW_HEIGHT) / 2.0f});
+    window.setView(view);
+
+    window.clear(color);
+}
+
+void SfmlRenderBackend::fillRect(sf::Vector2f position, sf::Vector2f size, sf::Color color)
+{
+    sf::RectangleShape rect(size);
+    rect.setPosition(position);
+    rect.setFillColor(color);
+    window.draw(rect);
+}
+
+void SfmlRenderBackend::outlineRect(sf::Vector2f position, sf::Vector2f size, float thickness, sf::Color color)
+{
+    sf::RectangleShape rect(size);
+    rect.setPosition(position);
+    rect.setFillColor(sf::Color::Transparent);
+    rect.setOutlineColor(color);
+    rect.setOutlineThickness(thickness);
+    window.draw(rect);
+}
+
+void SfmlRenderBackend::fillCircle(sf::Vector2f center, float radius, sf::Color color)
+{
+    sf::CircleShape circle(radius);
+    circle.setPosition({center.x - radius, center.y - radius});
+    circle.setFillColor(color);
+    window.draw(circle);
+}
+
+void SfmlRenderBackend::outlineCircle(sf::Vector2f center, float radius, float thickness, sf::Color color)
+{
+    sf::CircleShape circle(radius);
+    circle.setPosition({center.x - radius, center.y - radius});
+    circle.setFillColor(sf::Color::Transparent);
+    circle.setOutlineColor(color);
+    circle.setOutlineThickness(thickness);
+    window.draw(circle);
+}
+
+void SfmlRenderBackend::drawText(const sf::String& string, sf::Vector2f position, unsigned int characterSize,
+                                 sf::Color color, TextAlign align, bool bold)
+{
+    const sf::Font* currentFont = font.load();
+    if (!currentFont || currentFont->getInfo().family.empty()) return;
+
+    sf::Text text(*currentFont);
+    text.setString(string);
+    text.setCharacterSize(characterSize);
+    text.setFillColor(color);
+    text.setStyle(bold ? sf::Text::Bold : sf::Text::Regular);
+
+    if (align == TextAlign::Center)
+    {
+        sf::FloatRect bounds = text.getLocalBounds();
+        position.x -= (bounds.position.x + bounds.size.x) / 2.0f;
+    }
+
+    text.setPosition(position);
+    window.draw(text);
+}
+
+void SfmlRenderBackend::drawParticles(const float* x, const float* y, const std::uint32_t* colors,
+                                      std::size_t count, float size)
+{
+    if (count == 0) return;
+
+    const float half = size / 2.0f;
+    particleVertices.resize(count * 6);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const sf::Color color(colors[i]);
+        const sf::Vector2f topLeft{x[i] - half, y[i] - half};
+        const sf::Vector2f topRight{x[i] + half, y[i] - half};
+        const sf::Vector2f bottomLeft{x[i] - half, y[i] + half};
+        const sf::Vector2f bottomRight{x[i] + half, y[i] + half};
+
+        sf::Vertex* quad = &particleVertices[i * 6];
+        quad[0] = sf::Vertex{topLeft, color, {}};
+        quad[1] = sf::Vertex{topRight, color, {}};
+        quad[2] = sf::Vertex{bottomLeft, color, {}};
+        quad[3] = sf::Vertex{bottomLeft, color, {}};
+        quad[4] = sf::Vertex{topRight, color, {}};
+        quad[5] = sf::Vertex{bottomRight, color, {}};
+    }
+    window.draw(particleVertices);
+}
+
+void SfmlRenderBackend::present()
+{
+    window.display();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+
+class SfmlRenderBackend : public RenderBackend
+{
+public:
+    explicit SfmlRenderBackend(sf::RenderWindow& window);
+
+    // May be called while the render thread is drawing.
+    void setFont(const sf::Font* font) { this->font.store(font); }
+
+    sf::Vector2u getSize() const override;
+
+    void clear(sf::Color color) override;
+    void fillRect(sf::Vector2f position, sf::Vector2f size, sf::Color color) override;
+    void outlineRect(sf::Vector2f position, sf::Vector2f size, float thickness, sf::Color color) override;
+    void fillCircle(sf::Vector2f center, float radius, sf::Color color) override;
+    void outlineCircle(sf::Vector2f center, float radius, float thickness, sf::Color color) override;
+    void drawText(const sf::String& text, sf::Vector2f position, unsigned int characterSize,
+                  sf::Color color, TextAlign align = TextAlign::Left, bool bold = false) override;
+
+    void drawParticles(const float* x, const float* y, const std::uint32_t* colors,
+                       std::size_t count, float size) override;
+
+    void present() override;
+
+private:
+    sf::RenderWindow& window;
+    std::atomic<const sf::Font*> font{nullptr};
+    sf::VertexArray particleVertices{sf::PrimitiveType::Triangles};
+};
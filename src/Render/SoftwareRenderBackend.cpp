@@ -0,0 +1,358 @@
+#include "SoftwareRenderBackend.h"
+#include "../Checksum.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFTWARE_RENDER_SSE2 1
+#endif
+
+namespace {
+std::uint32_t packPixel(sf::Color color)
+{
+    const std::uint8_t bytes[4] = {color.r, color.g, color.b, color.a};
+    std::uint32_t pixel;
+    std::memcpy(&pixel, bytes, sizeof(pixel));
+    return pixel;
+}
+
+// Pixel covers [x, x + 1); it is inside a span when its center is.
+int toPixel(float coordinate)
+{
+    return static_cast<int>(std::ceil(coordinate - 0.5f));
+}
+
+// 3x5 glyphs, row 0 in the top bits.
+constexpr std::uint16_t glyph(int r0, int r1, int r2, int r3, int r4)
+{
+    return static_cast<std::uint16_t>((r0 << 12) | (r1 << 9) | (r2 << 6) | (r3 << 3) | r4);
+}
+
+std::uint16_t glyphFor(char32_t c)
+{
+    static const std::array<std::uint16_t, 10> digits = {
+        glyph(0b111, 0b101, 0b101, 0b101, 0b111), glyph(0b010, 0b110, 0b010, 0b010, 0b111),
+        glyph(0b111, 0b001, 0b111, 0b100, 0b111), glyph(0b111, 0b001, 0b111, 0b001, 0b111),
+        glyph(0b101, 0b101, 0b111, 0b001, 0b001), glyph(0b111, 0b100, 0b111, 0b001, 0b111),
+        glyph(0b111, 0b100, 0b111, 0b101, 0b111), glyph(0b111, 0b001, 0b001, 0b001, 0b001),
+        glyph(0b111, 0b101, 0b111, 0b101, 0b111), glyph(0b111, 0b101, 0b111, 0b001, 0b111),
+    };
+    static const std::array<std::uint16_t, 26> letters = {
+        glyph(0b010, 0b101, 0b111, 0b101, 0b101), glyph(0b110, 0b101, 0b110, 0b101, 0b110),
+        glyph(0b011, 0b100, 0b100, 0b100, 0b011), glyph(0b110, 0b101, 0b101, 0b101, 0b110),
+        glyph(0b111, 0b100, 0b110, 0b100, 0b111), glyph(0b111, 0b100, 0b110, 0b100, 0b100),
+        glyph(0b011, 0b100, 0b101, 0b101, 0b011), glyph(0b101, 0b101, 0b111, 0b101, 0b101),
+        glyph(0b111, 0b010, 0b010, 0b010, 0b111), glyph(0b001, 0b001, 0b001, 0b101, 0b010),
+        glyph(0b101, 0b101, 0b110, 0b101, 0b101), glyph(0b100, 0b100, 0b100, 0b100, 0b111),
+        glyph(0b101, 0b111, 0b111, 0b101, 0b101), glyph(0b110, 0b101, 0b101, 0b101, 0b101),
+        glyph(0b010, 0b101, 0b101, 0b101, 0b010), glyph(0b110, 0b101, 0b110, 0b100, 0b100),
+        glyph(0b010, 0b101, 0b101, 0b110, 0b011), glyph(0b110, 0b101, 0b110, 0b101, 0b101),
+        glyph(0b011, 0b100, 0b010, 0b001, 0b110), glyph(0b111, 0b010, 0b010, 0b010, 0b010),
+        glyph(0b101, 0b101, 0b101, 0b101, 0b111), glyph(0b101, 0b101, 0b101, 0b101, 0b010),
+        glyph(0b101, 0b101, 0b111, 0b111, 0b101), glyph(0b101, 0b101, 0b010, 0b101, 0b101),
+        glyph(0b101, 0b101, 0b010, 0b010, 0b010), glyph(0b111, 0b001, 0b010, 0b100, 0b111),
+    };
+
+    if (c >= U'0' && c <= U'9') return digits[c - U'0'];
+    if (c >= U'A' && c <= U'Z') return letters[c - U'A'];
+    if (c >= U'a' && c <= U'z') return letters[c - U'a'];
+    switch (c)
+    {
+        case U':': return glyph(0b000, 0b010, 0b000, 0b010, 0b000);
+        case U'.': return glyph(0b000, 0b000, 0b000, 0b000, 0b010);
+        case U'-': return glyph(0b000, 0b000, 0b111, 0b000, 0b000);
+        case U'/': return glyph(0b001, 0b001, 0b010, 0b100, 0b100);
+        default: return 0;
+    }
+}
+
+void appendBigEndian(std::vector<std::uint8_t>& out, std::uint32_t value)
+{
+    out.push_back(static_cast<std::uint8_t>(value >> 24));
+    out.push_back(static_cast<std::uint8_t>(value >> 16));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void appendChunk(std::vector<std::uint8_t>& png, const char* type, const std::vector<std::uint8_t>& data)
+{
+    appendBigEndian(png, static_cast<std::uint32_t>(data.size()));
+    const std::size_t typeOffset = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    appendBigEndian(png, crc32(png.data() + typeOffset, data.size() + 4));
+}
+}
+
+SoftwareRenderBackend::SoftwareRenderBackend(unsigned int width, unsigned int height)
+    : width(width), height(height), pixels(static_cast<std::size_t>(width) * height, packPixel(sf::Color::Black))
+{
+}
+
+sf::Color SoftwareRenderBackend::getPixel(unsigned int x, unsigned int y) const
+{
+    std::uint8_t bytes[4];
+    std::memcpy(bytes, &pixels[static_cast<std::size_t>(y) * width + x], sizeof(bytes));
+    return sf::Color(bytes[0], bytes[1], bytes[2], bytes[3]);
+}
+
+void SoftwareRenderBackend::fillSpan(int y, int x0, int x1, std::uint32_t pixel, std::uint8_t alpha)
+{
+    if (y < 0 || y >= static_cast<int>(height) || alpha == 0) return;
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, static_cast<int>(width));
+    if (x0 >= x1) return;
+
+    std::uint32_t* row = pixels.data() + static_cast<std::size_t>(y) * width;
+    int x = x0;
+
+    if (alpha == 255)
+    {
+#ifdef SOFTWARE_RENDER_SSE2
+        const __m128i fill = _mm_set1_epi32(static_cast<int>(pixel));
+        for (; x + 16 <= x1; x += 16)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), fill);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x + 4), fill);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x + 8), fill);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x + 12), fill);
+        }
+        for (; x + 4 <= x1; x += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), fill);
+#endif
+        std::fill(row + x, row + x1, pixel);
+        return;
+    }
+
+    // out = (src * a + dst * (255 - a)) / 255, rounded identically on both paths.
+#ifdef SOFTWARE_RENDER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i source = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(pixel)), zero);
+    const __m128i srcTerm = _mm_add_epi16(_mm_mullo_epi16(source, _mm_set1_epi16(alpha)), _mm_set1_epi16(128));
+    const __m128i inverse = _mm_set1_epi16(static_cast<short>(255 - alpha));
+    for (; x + 4 <= x1; x += 4)
+    {
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), inverse), srcTerm);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), inverse), srcTerm);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    std::uint8_t src[4];
+    std::memcpy(src, &pixel, sizeof(src));
+    for (; x < x1; ++x)
+    {
+        std::uint8_t dst[4];
+        std::memcpy(dst, &row[x], sizeof(dst));
+        for (int c = 0; c < 4; ++c)
+        {
+            unsigned int t = src[c] * alpha + dst[c] * (255u - alpha) + 128u;
+            dst[c] = static_cast<std::uint8_t>((t + (t >> 8)) >> 8);
+        }
+        std::memcpy(&row[x], dst, sizeof(dst));
+    }
+}
+
+void SoftwareRenderBackend::fillPixelRect(int x0, int y0, int x1, int y1, sf::Color color)
+{
+    const std::uint32_t pixel = packPixel(color);
+    y0 = std::max(y0, 0);
+    y1 = std::min(y1, static_cast<int>(height));
+    for (int y = y0; y < y1; ++y)
+        fillSpan(y, x0, x1, pixel, color.a);
+}
+
+void SoftwareRenderBackend::clear(sf::Color color)
+{
+    std::fill(pixels.begin(), pixels.end(), packPixel(color));
+}
+
+void SoftwareRenderBackend::fillRect(sf::Vector2f position, sf::Vector2f size, sf::Color color)
+{
+    fillPixelRect(toPixel(position.x), toPixel(position.y),
+                  toPixel(position.x + size.x), toPixel(position.y + size.y), color);
+}
+
+void SoftwareRenderBackend::outlineRect(sf::Vector2f position, sf::Vector2f size, float thickness, sf::Color color)
+{
+    if (thickness <= 0.0f) return;
+
+    // Thin outlines would vanish under center sampling; draw them as hairlines.
+    const int t = std::max(1, toPixel(thickness));
+    const int x0 = toPixel(position.x);
+    const int y0 = toPixel(position.y);
+    const int x1 = toPixel(position.x + size.x);
+    const int y1 = toPixel(position.y + size.y);
+
+    fillPixelRect(x0 - t, y0 - t, x1 + t, y0, color);
+    fillPixelRect(x0 - t, y1, x1 + t, y1 + t, color);
+    fillPixelRect(x0 - t, y0, x0, y1, color);
+    fillPixelRect(x1, y0, x1 + t, y1, color);
+}
+
+void SoftwareRenderBackend::fillCircle(sf::Vector2f center, float radius, sf::Color color)
+{
+    if (radius <= 0.0f) return;
+
+    const std::uint32_t pixel = packPixel(color);
+    const int yBegin = std::max(toPixel(center.y - radius), 0);
+    const int yEnd = std::min(toPixel(center.y + radius), static_cast<int>(height));
+    const float radiusSq = radius * radius;
+
+    for (int y = yBegin; y < yEnd; ++y)
+    {
+        const float dy = static_cast<float>(y) + 0.5f - center.y;
+        const float halfWidth = std::sqrt(std::max(radiusSq - dy * dy, 0.0f));
+        fillSpan(y, toPixel(center.x - halfWidth), toPixel(center.x + halfWidth), pixel, color.a);
+    }
+}
+
+void SoftwareRenderBackend::outlineCircle(sf::Vector2f center, float radius, float thickness, sf::Color color)
+{
+    if (thickness <= 0.0f) return;
+
+    const std::uint32_t pixel = packPixel(color);
+    const float outer = radius + thickness;
+    const int yBegin = std::max(toPixel(center.y - outer), 0);
+    const int yEnd = std::min(toPixel(center.y + outer), static_cast<int>(height));
+    const float outerSq = outer * outer;
+    const float innerSq = radius * radius;
+
+    for (int y = yBegin; y < yEnd; ++y)
+    {
+        const float dy = static_cast<float>(y) + 0.5f - center.y;
+        const float dySq = dy * dy;
+        const float outerHalf = std::sqrt(std::max(outerSq - dySq, 0.0f));
+        const int left = toPixel(center.x - outerHalf);
+        const int right = toPixel(center.x + outerHalf);
+
+        if (dySq >= innerSq)
+        {
+            fillSpan(y, left, right, pixel, color.a);
+            continue;
+        }
+
+        const float innerHalf = std::sqrt(innerSq - dySq);
+        fillSpan(y, left, toPixel(center.x - innerHalf), pixel, color.a);
+        fillSpan(y, toPixel(center.x + innerHalf), right, pixel, color.a);
+    }
+}
+
+void SoftwareRenderBackend::drawText(const sf::String& text, sf::Vector2f position, unsigned int characterSize,
+                                     sf::Color color, TextAlign align, bool bold)
+{
+    const int scale = std::max(1, static_cast<int>(characterSize + 3) / 6);
+    const int advance = 4 * scale;
+    const int count = static_cast<int>(text.getSize());
+
+    int x = toPixel(position.x);
+    const int y = toPixel(position.y) + scale;
+    if (align == TextAlign::Center)
+        x -= (count * advance - scale) / 2;
+
+    for (int i = 0; i < count; ++i, x += advance)
+    {
+        const std::uint16_t bits = glyphFor(text[i]);
+        for (int row = 0; row < 5; ++row)
+        {
+            for (int col = 0; col < 3; ++col)
+            {
+                if (!(bits & (1u << (14 - row * 3 - col)))) continue;
+                const int px = x + col * scale;
+                const int py = y + row * scale;
+                fillPixelRect(px, py, px + scale + (bold ? 1 : 0), py + scale, color);
+            }
+        }
+    }
+}
+
+void SoftwareRenderBackend::drawParticles(const float* x, const float* y, const std::uint32_t* colors,
+                                          std::size_t count, float size)
+{
+    const float half = size / 2.0f;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const int x0 = toPixel(x[i] - half);
+        const int y0 = toPixel(y[i] - half);
+        fillPixelRect(x0, y0, toPixel(x[i] + half), toPixel(y[i] + half), sf::Color(colors[i]));
+    }
+}
+
+bool SoftwareRenderBackend::writePPM(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    const std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+    std::vector<std::uint8_t> data(header.begin(), header.end());
+    data.reserve(data.size() + pixels.size() * 3);
+    for (std::uint32_t pixel : pixels)
+    {
+        std::uint8_t bytes[4];
+        std::memcpy(bytes, &pixel, sizeof(bytes));
+        data.insert(data.end(), bytes, bytes + 3);
+    }
+
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+// Writes an RGBA PNG using stored (uncompressed) deflate blocks, so no zlib is needed.
+bool SoftwareRenderBackend::writePNG(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    const std::size_t stride = static_cast<std::size_t>(width) * 4;
+    std::vector<std::uint8_t> raw;
+    raw.reserve((stride + 1) * height);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        raw.push_back(0);
+        const auto* row = reinterpret_cast<const std::uint8_t*>(pixels.data() + static_cast<std::size_t>(y) * width);
+        raw.insert(raw.end(), row, row + stride);
+    }
+
+    std::vector<std::uint8_t> idat = {0x78, 0x01};
+    for (std::size_t offset = 0; offset < raw.size() || offset == 0;)
+    {
+        const std::size_t blockSize = std::min<std::size_t>(raw.size() - offset, 65535);
+        const bool last = offset + blockSize == raw.size();
+        idat.push_back(last ? 1 : 0);
+        idat.push_back(static_cast<std::uint8_t>(blockSize));
+        idat.push_back(static_cast<std::uint8_t>(blockSize >> 8));
+        idat.push_back(static_cast<std::uint8_t>(~blockSize));
+        idat.push_back(static_cast<std::uint8_t>(~blockSize >> 8));
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+        offset += blockSize;
+        if (last) break;
+    }
+
+    std::uint32_t a = 1, b = 0;
+    for (std::uint8_t byte : raw)
+    {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    appendBigEndian(idat, (b << 16) | a);
+
+    std::vector<std::uint8_t> ihdr;
+    appendBigEndian(ihdr, width);
+    appendBigEndian(ihdr, height);
+    ihdr.insert(ihdr.end(), {8, 6, 0, 0, 0});
+
+    std::vector<std::uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    appendChunk(png, "IHDR", ihdr);
+    appendChunk(png, "IDAT", idat);
+    appendChunk(png, "IEND", {});
+
+    file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+    return file.good();
+}
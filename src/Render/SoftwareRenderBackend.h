@@ -0,0 +1,47 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CPU rasterizer drawing into an RGBA8 framebuffer (bytes R, G, B, A per
+// pixel). Needs no window or GPU; frames can be dumped with writePPM/writePNG.
+// Text uses a built-in 3x5 bitmap font covering ASCII letters, digits and a
+// few punctuation marks; other glyphs are skipped.
+class SoftwareRenderBackend : public RenderBackend
+{
+public:
+    SoftwareRenderBackend(unsigned int width, unsigned int height);
+
+    sf::Vector2u getSize() const override { return {width, height}; }
+
+    void clear(sf::Color color) override;
+    void fillRect(sf::Vector2f position, sf::Vector2f size, sf::Color color) override;
+    void outlineRect(sf::Vector2f position, sf::Vector2f size, float thickness, sf::Color color) override;
+    void fillCircle(sf::Vector2f center, float radius, sf::Color color) override;
+    void outlineCircle(sf::Vector2f center, float radius, float thickness, sf::Color color) override;
+    void drawText(const sf::String& text, sf::Vector2f position, unsigned int characterSize,
+                  sf::Color color, TextAlign align = TextAlign::Left, bool bold = false) override;
+
+    void drawParticles(const float* x, const float* y, const std::uint32_t* colors,
+                       std::size_t count, float size) override;
+
+    void present() override { frameCount++; }
+
+    const std::uint32_t* getPixels() const { return pixels.data(); }
+    sf::Color getPixel(unsigned int x, unsigned int y) const;
+    std::uint64_t getFrameCount() const { return frameCount; }
+
+    bool writePPM(const std::string& filename) const;
+    bool writePNG(const std::string& filename) const;
+
+private:
+    void fillSpan(int y, int x0, int x1, std::uint32_t pixel, std::uint8_t alpha);
+    void fillPixelRect(int x0, int y0, int x1, int y1, sf::Color color);
+
+    unsigned int width;
+    unsigned int height;
+    std::vector<std::uint32_t> pixels;
+    std::uint64_t frameCount = 0;
+};
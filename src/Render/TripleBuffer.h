@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer triple buffer. The producer
+// fills writeBuffer() and publishes it; the consumer picks up the latest
+// published buffer. Neither side ever blocks the other; stale frames are
+// simply overwritten.
+template<typename T>
+class TripleBuffer
+{
+public:
+    T& writeBuffer() { return buffers[back]; }
+
+    void publish()
+    {
+        std::uint8_t previous = state.exchange(static_cast<std::uint8_t>(back | dirtyBit), std::memory_order_acq_rel);
+        back = previous & indexMask;
+        state.notify_one();
+    }
+
+    // Returns true if a newer buffer became readable.
+    bool consume()
+    {
+        if (!(state.load(std::memory_order_relaxed) & dirtyBit)) return false;
+        std::uint8_t previous = state.exchange(front, std::memory_order_acq_rel);
+        front = previous & indexMask;
+        return true;
+    }
+
+    void waitForPublish() const
+    {
+        std::uint8_t current = state.load(std::memory_order_acquire);
+        while (!(current & dirtyBit))
+        {
+            state.wait(current, std::memory_order_acquire);
+            current = state.load(std::memory_order_acquire);
+        }
+    }
+
+    const T& readBuffer() const { return buffers[front]; }
+
+private:
+    static constexpr std::uint8_t indexMask = 0x3;
+    static constexpr std::uint8_t dirtyBit = 0x4;
+
+    std::array<T, 3> buffers;
+    std::uint8_t back = 0;
+    std::uint8_t front = 1;
+    std::atomic<std::uint8_t> state{2};
+};
@@ -0,0 +1,146 @@
+#include "ResourceManager.h"
+#include "BakedAssets.h"
+#include <iostream>
+
+ResourceManager::~ResourceManager()
+{
+    stop();
+}
+
+void ResourceManager::start()
+{
+    loader.start();
+}
+
+void ResourceManager::stop()
+{
+    loader.stop();
+}
+
+ResourceHandle<FontResource> ResourceManager::loadFont(const std::string& name)
+{
+    return request<FontResource>("font:" + name, [name](FontResource& font)
+    {
+        const BakedAsset* asset = BakedAssets::findFont(name);
+        return asset && BakedAssets::unpack(*asset, font.data) &&
+               font.font.openFromMemory(font.data.data(), font.data.size());
+    });
+}
+
+ResourceHandle<TextureResource> ResourceManager::loadTexture(const std::string& filename)
+{
+    return request<TextureResource>("texture:" + filename,
+        [filename](TextureResource& texture) { return texture.image.loadFromFile(filename); },
+        [](TextureResource& texture)
+        {
+            const bool uploaded = texture.texture.loadFromImage(texture.image);
+            texture.image = sf::Image();
+            return uploaded;
+        });
+}
+
+ResourceHandle<LevelData> ResourceManager::loadLevel(int number)
+{
+    return request<LevelData>("level:" + std::to_string(number),
+        [number](LevelData& level) { return LevelLoader::decodeBaked(number, level); });
+}
+
+ResourceHandle<LevelData> ResourceManager::generateLevel(int number, const LevelGeneratorParams& params,
+                                                         const RandomStream& layout)
+{
+    return request<LevelData>("generated:" + std::to_string(number) + ":" + std::to_string(layout.getKey()),
+        [params, layout](LevelData& level) { return LevelGenerator::generate(params, layout, level); });
+}
+
+ResourceHandle<Leaderboard> ResourceManager::loadScores(const std::string& filename, const std::string& legacyFilename,
+                                                        const std::string& playerName)
+{
+    return request<Leaderboard>("scores:" + filename, [=](Leaderboard& scores)
+    {
+        if (!scores.open(filename))
+        {
+            scores.importLegacy(legacyFilename, playerName);
+        }
+        return true;
+    });
+}
+
+bool ResourceManager::update()
+{
+    if (unfinished == 0) return false;
+
+    bool changed = false;
+    for (Slot& slot : slots)
+    {
+        if (slot.finished || slot.state == ResourceState::Loading) continue;
+        finishSlot(slot);
+        changed = true;
+    }
+    return changed;
+}
+
+void ResourceManager::finishSlot(Slot& slot)
+{
+    if (slot.state == ResourceState::Loaded)
+    {
+        slot.state = !slot.finish || slot.finish() ? ResourceState::Ready : ResourceState::Failed;
+    }
+    if (slot.state == ResourceState::Failed)
+    {
+        std::cerr << "Failed to load resource " << slot.key << std::endl;
+    }
+    slot.finish = nullptr;
+    slot.finished = true;
+    unfinished--;
+}
+
+void ResourceManager::waitFor(std::uint32_t index)
+{
+    Slot& slot = slots[index];
+    if (slot.finished) return;
+
+    {
+        std::unique_lock<std::mutex> lock(loadedMutex);
+        loadedCondition.wait(lock, [&slot] { return slot.state != ResourceState::Loading; });
+    }
+    finishSlot(slot);
+}
+
+float ResourceManager::getProgress() const
+{
+    return requested == 0 ? 1.0f : static_cast<float>(completed.load()) / static_cast<float>(requested);
+}
+
+void ResourceManager::collectUnused()
+{
+    for (std::uint32_t index = 0; index < slots.size(); ++index)
+    {
+        Slot& slot = slots[index];
+        if (slot.key.empty() || slot.references > 0 || !slot.finished) continue;
+
+        slotsByKey.erase(slot.key);
+        slot.key.clear();
+        slot.resource.reset();
+        slot.state = ResourceState::Loading;
+        slot.finished = false;
+        freeSlots.push_back(index);
+    }
+}
+
+std::uint32_t ResourceManager::allocateSlot(const std::string& key)
+{
+    std::uint32_t index;
+    if (!freeSlots.empty())
+    {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<std::uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    slots[index].key = key;
+    slotsByKey[key] = index;
+    return index;
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "TaskWorker.h"
+#include "Leaderboard.h"
+#include "LevelGenerator.h"
+#include "LevelLoader.h"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class ResourceState : std::uint8_t
+{
+    Loading,
+    // Decoded on the loader thread, waiting for update() on the main thread.
+    Loaded,
+    Ready,
+    Failed,
+};
+
+struct FontResource
+{
+    // sf::Font reads from this buffer for as long as it is in use.
+    std::vector<std::byte> data;
+    sf::Font font;
+};
+
+struct TextureResource
+{
+    sf::Image image;
+    sf::Texture texture;
+};
+
+class ResourceManager;
+
+// Reference-counted handle to a cached resource. Copying a handle shares
+// the resource; it stays cached until the last handle is gone and
+// collectUnused() runs. Handles belong to the main thread.
+template<typename T>
+class ResourceHandle
+{
+public:
+    ResourceHandle() = default;
+    ResourceHandle(const ResourceHandle& other);
+    ResourceHandle(ResourceHandle&& other) noexcept;
+    ResourceHandle& operator=(ResourceHandle other) noexcept;
+    ~ResourceHandle();
+
+    bool isValid() const { return manager != nullptr; }
+    bool isReady() const;
+    bool hasFailed() const;
+    // nullptr until the resource is ready.
+    T* get() const;
+    T* operator->() const { return get(); }
+
+private:
+    friend class ResourceManager;
+    ResourceHandle(ResourceManager* manager, std::uint32_t index);
+
+    ResourceManager* manager = nullptr;
+    std::uint32_t index = 0;
+};
+
+// Loads fonts, textures, levels and score tables on a background thread and
+// caches them by name, so requesting something already loaded (or loading)
+// returns the same resource. Work that must happen on the main thread, such
+// as uploading a texture, is finished in update().
+class ResourceManager
+{
+public:
+    ResourceManager() = default;
+    ~ResourceManager();
+
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+
+    void start();
+    // Finishes queued loads before returning.
+    void stop();
+
+    // Fonts and levels come from the assets baked into the executable.
+    ResourceHandle<FontResource> loadFont(const std::string& name);
+    ResourceHandle<TextureResource> loadTexture(const std::string& filename);
+    ResourceHandle<LevelData> loadLevel(int number);
+    // Generates level `number` from `layout`; cached per number and stream.
+    ResourceHandle<LevelData> generateLevel(int number, const LevelGeneratorParams& params, const RandomStream& layout);
+    // Falls back to importing the legacy text list when `filename` is missing.
+    ResourceHandle<Leaderboard> loadScores(const std::string& filename, const std::string& legacyFilename,
+                                           const std::string& playerName);
+
+    // Main thread, once per frame. Returns true if any resource finished
+    // loading (or failed) since the last call.
+    bool update();
+    // Blocks until the resource has finished loading.
+    template<typename T>
+    void wait(const ResourceHandle<T>& handle) { waitFor(handle.index); }
+
+    bool isLoading() const { return completed.load() < requested; }
+    // Share of the resources requested since the manager was last idle that
+    // have finished loading, in [0, 1].
+    float getProgress() const;
+
+    // Drops cached resources that no handle refers to.
+    void collectUnused();
+
+private:
+    template<typename T>
+    friend class ResourceHandle;
+
+    struct Slot
+    {
+        std::string key;
+        std::shared_ptr<void> resource;
+        // Main-thread step run by update(); may be empty.
+        std::function<bool()> finish;
+        std::atomic<ResourceState> state{ResourceState::Loading};
+        // Set by update() once the load has been reported.
+        bool finished = false;
+        int references = 0;
+    };
+
+    template<typename T>
+    ResourceHandle<T> request(const std::string& key, std::function<bool(T&)> load,
+                              std::function<bool(T&)> finish = nullptr);
+    std::uint32_t allocateSlot(const std::string& key);
+    void finishSlot(Slot& slot);
+    void waitFor(std::uint32_t index);
+    void retain(std::uint32_t index) { slots[index].references++; }
+    void release(std::uint32_t index) { slots[index].references--; }
+
+    TaskWorker loader;
+    // A deque keeps slots in place while the loader thread writes to them.
+    std::deque<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+    std::unordered_map<std::string, std::uint32_t> slotsByKey;
+
+    std::size_t requested = 0;
+    std::atomic<std::size_t> completed{0};
+    std::size_t unfinished = 0;
+    std::mutex loadedMutex;
+    std::condition_variable loadedCondition;
+};
+
+template<typename T>
+ResourceHandle<T> ResourceManager::request(const std::string& key, std::function<bool(T&)> load,
+                                           std::function<bool(T&)> finish)
+{
+    if (auto it = slotsByKey.find(key); it != slotsByKey.end())
+    {
+        return ResourceHandle<T>(this, it->second);
+    }
+
+    if (!isLoading())
+    {
+        requested = 0;
+        completed = 0;
+    }
+    requested++;
+    unfinished++;
+
+    const std::uint32_t index = allocateSlot(key);
+    Slot& slot = slots[index];
+    auto resource = std::make_shared<T>();
+    slot.resource = resource;
+    if (finish)
+    {
+        slot.finish = [finish = std::move(finish), resource] { return finish(*resource); };
+    }
+
+    loader.post([this, &slot, resource, load = std::move(load)] {
+        const bool loaded = load(*resource);
+        {
+            std::lock_guard<std::mutex> lock(loadedMutex);
+            slot.state = loaded ? ResourceState::Loaded : ResourceState::Failed;
+            completed++;
+        }
+        loadedCondition.notify_all();
+    });
+    return ResourceHandle<T>(this, index);
+}
+
+template<typename T>
+ResourceHandle<T>::ResourceHandle(ResourceManager* manager, std::uint32_t index)
+    : manager(manager), index(index)
+{
+    manager->retain(index);
+}
+
+template<typename T>
+ResourceHandle<T>::ResourceHandle(const ResourceHandle& other)
+    : manager(other.manager), index(other.index)
+{
+    if (manager) manager->retain(index);
+}
+
+template<typename T>
+ResourceHandle<T>::ResourceHandle(ResourceHandle&& other) noexcept
+    : manager(other.manager), index(other.index)
+{
+    other.manager = nullptr;
+}
+
+template<typename T>
+ResourceHandle<T>& ResourceHandle<T>::operator=(ResourceHandle other) noexcept
+{
+    std::swap(manager, other.manager);
+    std::swap(index, other.index);
+    return *this;
+}
+
+template<typename T>
+ResourceHandle<T>::~ResourceHandle()
+{
+    if (manager) manager->release(index);
+}
+
+template<typename T>
+bool ResourceHandle<T>::isReady() const
+{
+    return manager && manager->slots[index].state == ResourceState::Ready;
+}
+
+template<typename T>
+bool ResourceHandle<T>::hasFailed() const
+{
+    return manager && manager->slots[index].state == ResourceState::Failed;
+}
+
+template<typename T>
+T* ResourceHandle<T>::get() const
+{
+    return isReady() ? static_cast<T*>(manager->slots[index].resource.get()) : nullptr;
+}
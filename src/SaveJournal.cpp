@@ -0,0 +1,232 @@
+#include "SaveJournal.h"
+#include "ECS/ECSManager.h"
+#include "FileIO.h"
+#include "Checksum.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+constexpr std::uint32_t JOURNAL_FRAME_MAGIC = 0x4C4E524A; // "JRNL"
+
+void applyRecord(const JournalRecord& record, ECSManager& ecs, Entity entity, int& score)
+{
+    switch (record.type)
+    {
+        case JournalRecordType::Tick:
+            for (Entity target : ecs.getEntitiesWithComponent<StatModifiersComponent>())
+            {
+                auto modifiers = ecs.getComponent<StatModifiersComponent>(target);
+                for (std::size_t i = 0; i < modifiers->count; ++i)
+                {
+                    modifiers->modifiers[i].remainingTime -= record.data[0];
+                }
+            }
+            break;
+        case JournalRecordType::ScoreDelta:
+            score += record.value;
+            break;
+        case JournalRecordType::BrickHit:
+            if (auto durable = ecs.getComponent<DurableBrick>(entity)) durable->currentHits = record.value;
+            if (auto shape = ecs.getComponent<ShapeComponent>(entity)) shape->color = sf::Color(record.color);
+            break;
+        case JournalRecordType::BrickDestroyed:
+            ecs.destroyEntity(entity);
+            break;
+        // Only the modifier lists change here; the stats themselves come from
+        // Body records, and bases are derived from both after loading.
+        case JournalRecordType::BonusApplied:
+        {
+            auto modifiers = ecs.getComponent<StatModifiersComponent>(entity);
+            if (!modifiers)
+            {
+                modifiers = std::make_shared<StatModifiersComponent>();
+                ecs.addComponent<StatModifiersComponent>(entity, modifiers);
+            }
+            StatModifier modifier;
+            modifier.source = static_cast<BonusType>(record.bonusType);
+            modifier.stat = static_cast<Stat>(record.value);
+            modifier.remainingTime = record.data[0];
+            modifier.factor = record.data[1];
+            modifier.offset = record.data[2];
+            modifiers->set(modifier);
+            break;
+        }
+        case JournalRecordType::BonusExpired:
+            if (auto modifiers = ecs.getComponent<StatModifiersComponent>(entity))
+            {
+                modifiers->erase(static_cast<BonusType>(record.bonusType));
+            }
+            break;
+        case JournalRecordType::Body:
+            if (auto position = ecs.getComponent<PositionComponent>(entity))
+            {
+                position->position = {record.data[0], record.data[1]};
+            }
+            if (auto velocity = ecs.getComponent<VelocityComponent>(entity))
+            {
+                velocity->velocity = {record.data[2], record.data[3]};
+                velocity->speed = record.data[4];
+            }
+            if (auto input = ecs.getComponent<InputComponent>(entity))
+            {
+                input->moveSpeed = record.data[6];
+            }
+            if (record.value != 0)
+            {
+                if (auto shape = ecs.getComponent<ShapeComponent>(entity)) shape->rectangle.width = record.data[5];
+                if (auto collider = ecs.getComponent<ColliderComponent>(entity)) collider->size.x = record.data[5];
+            }
+            break;
+    }
+}
+}
+
+JournalRecord& SaveJournal::append(JournalRecordType type, Entity entity)
+{
+    JournalRecord& record = records.emplace_back();
+    record = {};
+    record.type = type;
+    record.entity = entity;
+    return record;
+}
+
+void SaveJournal::recordTick(float deltaTime)
+{
+    if (!records.empty() && records.back().type == JournalRecordType::Tick)
+    {
+        records.back().data[0] += deltaTime;
+        return;
+    }
+    append(JournalRecordType::Tick).data[0] = deltaTime;
+}
+
+void SaveJournal::recordBrickHit(Entity brick, int currentHits, sf::Color color)
+{
+    JournalRecord& record = append(JournalRecordType::BrickHit, brick);
+    record.value = currentHits;
+    record.color = color.toInteger();
+}
+
+void SaveJournal::recordBrickDestroyed(Entity brick)
+{
+    append(JournalRecordType::BrickDestroyed, brick);
+}
+
+void SaveJournal::recordScoreDelta(int delta)
+{
+    append(JournalRecordType::ScoreDelta).value = delta;
+}
+
+void SaveJournal::recordBonusApplied(Entity target, const StatModifier& modifier)
+{
+    JournalRecord& record = append(JournalRecordType::BonusApplied, target);
+    record.bonusType = static_cast<std::uint8_t>(modifier.source);
+    record.value = static_cast<std::int32_t>(modifier.stat);
+    record.data[0] = modifier.remainingTime;
+    record.data[1] = modifier.factor;
+    record.data[2] = modifier.offset;
+}
+
+void SaveJournal::recordBonusExpired(Entity target, BonusType source)
+{
+    JournalRecord& record = append(JournalRecordType::BonusExpired, target);
+    record.bonusType = static_cast<std::uint8_t>(source);
+}
+
+void SaveJournal::recordBody(const ECSManager& ecs, Entity entity)
+{
+    JournalRecord& record = append(JournalRecordType::Body, entity);
+    if (auto position = ecs.getComponent<PositionComponent>(entity))
+    {
+        record.data[0] = position->position.x;
+        record.data[1] = position->position.y;
+    }
+    if (auto velocity = ecs.getComponent<VelocityComponent>(entity))
+    {
+        record.data[2] = velocity->velocity.x;
+        record.data[3] = velocity->velocity.y;
+        record.data[4] = velocity->speed;
+    }
+    if (auto shape = ecs.getComponent<ShapeComponent>(entity); shape && shape->type == ShapeComponent::Type::Rectangle)
+    {
+        record.value = 1;
+        record.data[5] = shape->rectangle.width;
+    }
+    if (auto input = ecs.getComponent<InputComponent>(entity))
+    {
+        record.data[6] = input->moveSpeed;
+    }
+}
+
+std::vector<std::byte> SaveJournal::takeFrame()
+{
+    const std::size_t payloadSize = records.size() * sizeof(JournalRecord);
+    std::vector<std::byte> frame(sizeof(JournalFrameHeader) + payloadSize);
+
+    JournalFrameHeader header{};
+    header.magic = JOURNAL_FRAME_MAGIC;
+    header.recordCount = static_cast<std::uint32_t>(records.size());
+    header.crc = crc32(records.data(), payloadSize);
+    std::memcpy(frame.data(), &header, sizeof(header));
+    std::memcpy(frame.data() + sizeof(header), records.data(), payloadSize);
+
+    records.clear();
+    return frame;
+}
+
+std::string SaveJournal::segmentName(const std::string& saveFilename, std::uint32_t sequence)
+{
+    return saveFilename + ".journal." + std::to_string(sequence);
+}
+
+bool SaveJournal::segmentExists(const std::string& saveFilename, std::uint32_t sequence)
+{
+    std::ifstream file(segmentName(saveFilename, sequence), std::ios::binary);
+    return file.good();
+}
+
+void SaveJournal::replaySegment(const std::string& path, ECSManager& ecs,
+                                const std::unordered_map<Entity, Entity>& remap, int& score)
+{
+    MappedFile file;
+    if (!file.open(path)) return;
+
+    std::size_t offset = 0;
+    std::vector<JournalRecord> frameRecords;
+    while (file.size() - offset >= sizeof(JournalFrameHeader))
+    {
+        JournalFrameHeader header;
+        std::memcpy(&header, file.data() + offset, sizeof(header));
+        const std::size_t available = file.size() - offset - sizeof(header);
+        if (header.magic != JOURNAL_FRAME_MAGIC || header.recordCount > available / sizeof(JournalRecord)) break;
+
+        const std::byte* payload = file.data() + offset + sizeof(header);
+        const std::size_t payloadSize = header.recordCount * sizeof(JournalRecord);
+        if (crc32(payload, payloadSize) != header.crc) break;
+
+        frameRecords.resize(header.recordCount);
+        std::memcpy(frameRecords.data(), payload, payloadSize);
+        for (const JournalRecord& record : frameRecords)
+        {
+            Entity entity = INVALID_ENTITY;
+            if (record.entity != INVALID_ENTITY)
+            {
+                auto it = remap.find(record.entity);
+                if (it == remap.end()) continue;
+                entity = it->second;
+            }
+            applyRecord(record, ecs, entity, score);
+        }
+        offset += sizeof(header) + payloadSize;
+    }
+}
+
+void SaveJournal::removeSegments(const std::string& saveFilename, std::uint32_t first, std::uint32_t end)
+{
+    for (std::uint32_t sequence = first; sequence < end; ++sequence)
+    {
+        std::remove(segmentName(saveFilename, sequence).c_str());
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ECS/Entity.h"
+#include "ECS/Components.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+class ECSManager;
+
+// Write-ahead log of gameplay changes since the last full save.
+//
+// Records are buffered in memory and flushed as CRC-checked frames to a
+// segment file, savegame.dat.journal.<sequence>. A checkpoint (the regular
+// save file) stores the sequence of the first segment not folded into it;
+// loading replays that segment and every following one. Records hold the
+// resulting state rather than the input that caused it, so replay never runs
+// game logic. A torn frame at the end of a segment marks the crash point and
+// ends replay of that segment.
+enum class JournalRecordType : std::uint8_t
+{
+    Tick = 1,
+    BrickHit,
+    BrickDestroyed,
+    ScoreDelta,
+    BonusApplied,
+    BonusExpired,
+    Body,
+};
+
+struct JournalRecord
+{
+    JournalRecordType type;
+    std::uint8_t bonusType;
+    std::uint16_t reserved;
+    Entity entity;
+    std::int32_t value;
+    std::uint32_t color;
+    float data[7];
+};
+
+struct JournalFrameHeader
+{
+    std::uint32_t magic;
+    std::uint32_t recordCount;
+    std::uint32_t crc;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(JournalRecord) == 44 && std::is_trivially_copyable_v<JournalRecord>);
+static_assert(sizeof(JournalFrameHeader) == 16 && std::is_trivially_copyable_v<JournalFrameHeader>);
+
+class SaveJournal
+{
+public:
+    // Consecutive ticks are merged into one record.
+    void recordTick(float deltaTime);
+    void recordBrickHit(Entity brick, int currentHits, sf::Color color);
+    void recordBrickDestroyed(Entity brick);
+    void recordScoreDelta(int delta);
+    void recordBonusApplied(Entity target, const StatModifier& modifier);
+    void recordBonusExpired(Entity target, BonusType source);
+    // Position, velocity and bonus-affected stats of a paddle or ball.
+    void recordBody(const ECSManager& ecs, Entity entity);
+
+    bool empty() const { return records.empty(); }
+    void clear() { records.clear(); }
+    std::size_t getRecordCount() const { return records.size(); }
+
+    // Encodes the buffered records as one frame and clears the buffer.
+    std::vector<std::byte> takeFrame();
+
+    std::uint32_t getSequence() const { return sequence; }
+    void setSequence(std::uint32_t value) { sequence = value; }
+
+    static std::string segmentName(const std::string& saveFilename, std::uint32_t sequence);
+    static bool segmentExists(const std::string& saveFilename, std::uint32_t sequence);
+
+    // Applies a segment to a world restored from a checkpoint. `remap` maps
+    // the entity ids seen by the journal to ids in `ecs`; records for other
+    // entities are skipped.
+    static void replaySegment(const std::string& path, ECSManager& ecs,
+                              const std::unordered_map<Entity, Entity>& remap, int& score);
+
+    // Deletes segments [first, end) once a checkpoint no longer needs them.
+    static void removeSegments(const std::string& saveFilename, std::uint32_t first, std::uint32_t end);
+
+private:
+    JournalRecord& append(JournalRecordType type, Entity entity = INVALID_ENTITY);
+
+    std::vector<JournalRecord> records;
+    std::uint32_t sequence = 0;
+};
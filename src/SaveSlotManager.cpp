@@ -0,0 +1,178 @@
+#include "SaveSlotManager.h"
+#include "SaveSystem.h"
+#include "FileIO.h"
+#include "Checksum.h"
+#include "GameState.h"
+#include "ECS/ECSManager.h"
+#include "ECS/Components.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+constexpr char SAVE_INDEX_MAGIC[8] = {'A', 'R', 'C', 'S', 'L', 'O', 'T', 'S'};
+constexpr std::uint32_t SAVE_INDEX_VERSION = 1;
+
+std::uint8_t toRgb332(sf::Color color)
+{
+    return static_cast<std::uint8_t>((color.r & 0xE0) | ((color.g & 0xE0) >> 3) | (color.b >> 6));
+}
+}
+
+SaveSlotManager::SaveSlotManager(std::string indexFilename)
+    : indexFilename(std::move(indexFilename))
+{
+}
+
+void SaveSlotManager::open(int slotCount)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (readIndex())
+    {
+        if (static_cast<int>(slots.size()) < slotCount) slots.resize(slotCount, SaveSlotInfo{});
+        return;
+    }
+
+    rebuild(slotCount);
+    if (!writeIndex())
+    {
+        std::cerr << "Failed to write save index: " << indexFilename << std::endl;
+    }
+}
+
+bool SaveSlotManager::hasSave(int slot) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return slot >= 0 && slot < static_cast<int>(slots.size()) && slots[slot].used;
+}
+
+std::optional<SaveSlotInfo> SaveSlotManager::getInfo(int slot) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (slot < 0 || slot >= static_cast<int>(slots.size()) || !slots[slot].used) return std::nullopt;
+    return slots[slot];
+}
+
+int SaveSlotManager::getSlotCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(slots.size());
+}
+
+bool SaveSlotManager::commit(int slot, const SaveSlotInfo& info)
+{
+    if (slot < 0) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (slot >= static_cast<int>(slots.size()))
+    {
+        slots.resize(slot + 1, SaveSlotInfo{});
+    }
+    slots[slot] = info;
+    slots[slot].used = 1;
+
+    if (!writeIndex())
+    {
+        std::cerr << "Failed to write save index: " << indexFilename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string SaveSlotManager::slotFilename(int slot)
+{
+    // Slot 0 keeps the name used before slots existed.
+    return slot == 0 ? std::string("savegame.dat") : "savegame" + std::to_string(slot) + ".dat";
+}
+
+SaveSlotInfo SaveSlotManager::describe(const ECSManager& ecs, int score)
+{
+    SaveSlotInfo info{};
+    info.saveTime = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    info.score = score;
+    info.used = 1;
+
+    const float scaleX = static_cast<float>(SAVE_THUMBNAIL_WIDTH) / GAME_STATE.WINDOW_WIDTH;
+    const float scaleY = static_cast<float>(SAVE_THUMBNAIL_HEIGHT) / GAME_STATE.WINDOW_HEIGHT;
+    ecs.forEachComponent<ColliderComponent>([&](Entity entity, const ColliderComponent& collider)
+    {
+        if (collider.type != ColliderComponent::Type::Brick) return;
+        info.bricksRemaining++;
+
+        auto position = ecs.getComponent<PositionComponent>(entity);
+        auto shape = ecs.getComponent<ShapeComponent>(entity);
+        if (!position || !shape) return;
+
+        const int x0 = std::clamp(static_cast<int>(position->position.x * scaleX), 0, static_cast<int>(SAVE_THUMBNAIL_WIDTH) - 1);
+        const int y0 = std::clamp(static_cast<int>(position->position.y * scaleY), 0, static_cast<int>(SAVE_THUMBNAIL_HEIGHT) - 1);
+        const int x1 = std::clamp(static_cast<int>((position->position.x + collider.size.x) * scaleX), x0 + 1,
+                                  static_cast<int>(SAVE_THUMBNAIL_WIDTH));
+        const int y1 = std::clamp(static_cast<int>((position->position.y + collider.size.y) * scaleY), y0 + 1,
+                                  static_cast<int>(SAVE_THUMBNAIL_HEIGHT));
+        const std::uint8_t pixel = toRgb332(shape->color);
+        for (int y = y0; y < y1; ++y)
+        {
+            std::fill(info.thumbnail + y * SAVE_THUMBNAIL_WIDTH + x0, info.thumbnail + y * SAVE_THUMBNAIL_WIDTH + x1, pixel);
+        }
+    });
+    return info;
+}
+
+bool SaveSlotManager::readIndex()
+{
+    MappedFile file;
+    if (!file.open(indexFilename) || file.size() < sizeof(SaveIndexHeader)) return false;
+
+    SaveIndexHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    const std::size_t entryBytes = file.size() - sizeof(header);
+    if (std::memcmp(header.magic, SAVE_INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SAVE_INDEX_VERSION || header.entrySize != sizeof(SaveSlotInfo) ||
+        entryBytes != static_cast<std::size_t>(header.slotCount) * sizeof(SaveSlotInfo) ||
+        crc32(file.data() + sizeof(header), entryBytes) != header.crc)
+    {
+        std::cerr << "Save index is corrupt, rebuilding" << std::endl;
+        return false;
+    }
+
+    slots.resize(header.slotCount);
+    std::memcpy(slots.data(), file.data() + sizeof(header), entryBytes);
+    return true;
+}
+
+bool SaveSlotManager::writeIndex() const
+{
+    const std::size_t entryBytes = slots.size() * sizeof(SaveSlotInfo);
+    std::vector<std::byte> image(sizeof(SaveIndexHeader) + entryBytes);
+
+    SaveIndexHeader header{};
+    std::memcpy(header.magic, SAVE_INDEX_MAGIC, sizeof(header.magic));
+    header.version = SAVE_INDEX_VERSION;
+    header.entrySize = sizeof(SaveSlotInfo);
+    header.slotCount = static_cast<std::uint32_t>(slots.size());
+    header.crc = crc32(slots.data(), entryBytes);
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(image.data() + sizeof(header), slots.data(), entryBytes);
+
+    return replaceFileAtomically(indexFilename, image.data(), image.size());
+}
+
+// Slow path: opens every slot file. Only runs when the index is lost.
+void SaveSlotManager::rebuild(int slotCount)
+{
+    slots.assign(std::max(slotCount, static_cast<int>(slots.size())), SaveSlotInfo{});
+    for (int slot = 0; slot < static_cast<int>(slots.size()); ++slot)
+    {
+        ECSManager world;
+        int score = 0;
+        std::int64_t saveTime = 0;
+        if (SaveSystem::loadWorld(slotFilename(slot), world, score, saveTime))
+        {
+            slots[slot] = describe(world, score);
+            slots[slot].saveTime = saveTime;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class ECSManager;
+
+constexpr unsigned int SAVE_THUMBNAIL_WIDTH = 24;
+constexpr unsigned int SAVE_THUMBNAIL_HEIGHT = 16;
+
+// Index entry describing one save slot. The thumbnail is the brick layout
+// downscaled to SAVE_THUMBNAIL_WIDTH x SAVE_THUMBNAIL_HEIGHT, one RGB332 byte
+// per pixel.
+struct SaveSlotInfo
+{
+    std::int64_t saveTime;
+    std::int32_t score;
+    std::int32_t bricksRemaining;
+    std::uint8_t used;
+    std::uint8_t reserved[7];
+    std::uint8_t thumbnail[SAVE_THUMBNAIL_WIDTH * SAVE_THUMBNAIL_HEIGHT];
+};
+
+struct SaveIndexHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t entrySize;
+    std::uint32_t slotCount;
+    std::uint32_t crc;
+};
+
+static_assert(sizeof(SaveSlotInfo) == 408 && std::is_trivially_copyable_v<SaveSlotInfo>);
+static_assert(sizeof(SaveIndexHeader) == 24 && std::is_trivially_copyable_v<SaveIndexHeader>);
+
+// Keeps per-slot metadata in one small index file (a header followed by one
+// SaveSlotInfo per slot, indexed by slot number) so that listing slots never
+// touches the save files themselves. commit() is called after the slot file
+// has been replaced and rewrites the index with replaceFileAtomically, so a
+// crash leaves the previous index intact. Safe to use from the save thread
+// and the main thread at the same time.
+class SaveSlotManager
+{
+public:
+    explicit SaveSlotManager(std::string indexFilename);
+
+    // Reads the index, rebuilding it from the slot files when it is missing
+    // or corrupt.
+    void open(int slotCount);
+
+    bool hasSave(int slot) const;
+    std::optional<SaveSlotInfo> getInfo(int slot) const;
+    int getSlotCount() const;
+
+    bool commit(int slot, const SaveSlotInfo& info);
+
+    static std::string slotFilename(int slot);
+    static SaveSlotInfo describe(const ECSManager& ecs, int score);
+
+private:
+    bool readIndex();
+    bool writeIndex() const;
+    void rebuild(int slotCount);
+
+    std::string indexFilename;
+    mutable std::mutex mutex;
+    std::vector<SaveSlotInfo> slots;
+};
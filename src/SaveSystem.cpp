@@ -1,260 +1,309 @@
 #include "SaveSystem.h"
 #include "Game.h"
-#include "EntityFactory.h"
 #include "ECS/ECSManager.h"
+#include "ECS/WorldSerializer.h"
+#include "SaveJournal.h"
+#include "SaveSlotManager.h"
 #include "ECS/Components.h"
 #include "GameState.h"
-#include <fstream>
+#include "FileIO.h"
+#include "Checksum.h"
+#include <bit>
 #include <iostream>
 #include <cstring>
 #include <chrono>
+#include <limits>
+
+namespace {
+constexpr char SAVE_MAGIC[8] = {'A', 'R', 'C', 'S', 'A', 'V', 'E', '\0'};
+
+std::size_t alignSection(std::size_t offset) {
+    return (offset + SAVE_SECTION_ALIGNMENT - 1) & ~(SAVE_SECTION_ALIGNMENT - 1);
+}
+
+const SaveSectionEntry* findSection(std::span<const SaveSectionEntry> sections, SaveSectionId id) {
+    for (const auto& section : sections) {
+        if (section.id == static_cast<std::uint32_t>(id)) {
+            return &section;
+        }
+    }
+    return nullptr;
+}
+}
 
 bool SaveSystem::saveGame(const Game& game, const std::string& filename) {
-    GameSaveData data = createSaveData(game);
-    return saveToFile(data, filename);
+    return writeSave(captureSave(game), filename);
+}
+
+SaveSnapshot SaveSystem::captureSave(const Game& game) {
+    SaveSnapshot snapshot;
+    snapshot.state = createSaveData(game, snapshot.world);
+    snapshot.random.seed = game.getRandomSeed();
+    snapshot.random.layoutCount = game.getLayoutCount();
+    return snapshot;
+}
+
+bool SaveSystem::writeSave(const SaveSnapshot& snapshot, const std::string& filename) {
+    std::vector<std::byte> image = buildSaveImage(snapshot);
+    if (!replaceFileAtomically(filename, image.data(), image.size())) {
+        std::cerr << "Failed to write save file: " << filename << std::endl;
+        return false;
+    }
+    return true;
 }
 
 bool SaveSystem::loadGame(Game& game, const std::string& filename) {
-    GameSaveData data;
-    if (!loadFromFile(data, filename)) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Failed to open save file: " << filename << std::endl;
         return false;
     }
-    return applySaveData(game, data);
+
+    GameSaveData state;
+    RandomSaveData random{game.getRandomSeed(), game.getLayoutCount(), 0};
+    std::span<const std::byte> world;
+    if (!parseSaveImage({file.data(), file.size()}, state, world, &random)) {
+        return false;
+    }
+    return applySaveData(game, state, random, world, filename);
 }
 
-bool SaveSystem::saveExists(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    return file.good();
+bool SaveSystem::compactJournal(const std::string& filename, std::uint32_t sequence, SaveSlotInfo* info) {
+    SaveSnapshot snapshot;
+    {
+        MappedFile file;
+        GameSaveData state;
+        std::span<const std::byte> world;
+        if (!file.open(filename) || !parseSaveImage({file.data(), file.size()}, state, world, &snapshot.random)) {
+            return false;
+        }
+        
+        if (state.journalSequence > sequence) {
+            return true;
+        }
+        
+        ECSManager ecs;
+        std::unordered_map<Entity, Entity> remap;
+        int score = state.currentScore;
+        if (!restoreWorld(filename, state, world, sequence, ecs, remap, score)) {
+            return false;
+        }
+        
+        
+        std::unordered_map<Entity, Entity> originalIds;
+        originalIds.reserve(remap.size());
+        for (const auto& [saved, restored] : remap) {
+            originalIds.emplace(restored, saved);
+        }
+        
+        if (info) {
+            *info = SaveSlotManager::describe(ecs, score);
+        }
+        snapshot.state = state;
+        snapshot.state.currentScore = score;
+        snapshot.state.journalSequence = sequence + 1;
+        WorldSerializer::writeWorld(ecs, snapshot.world, &originalIds);
+    }
+    return writeSave(snapshot, filename);
 }
 
-bool SaveSystem::saveToFile(const GameSaveData& data, const std::string& filename) {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open save file: " << filename << std::endl;
+bool SaveSystem::loadWorld(const std::string& filename, ECSManager& ecs, int& score, std::int64_t& saveTime) {
+    MappedFile file;
+    GameSaveData state;
+    std::span<const std::byte> world;
+    if (!file.open(filename) || !parseSaveImage({file.data(), file.size()}, state, world)) {
         return false;
     }
     
+    SaveFileHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    saveTime = static_cast<std::int64_t>(header.saveTime);
     
-    const char header[] = "ARCSAVE";
-    file.write(header, 8);
-    
-    
-    file.write(reinterpret_cast<const char*>(&data.platformX), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&data.platformY), sizeof(float));
-    
-    
-    file.write(reinterpret_cast<const char*>(&data.ballX), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&data.ballY), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&data.ballVelX), sizeof(float));
-    file.write(reinterpret_cast<const char*>(&data.ballVelY), sizeof(float));
-    
-    
-    file.write(reinterpret_cast<const char*>(&data.currentScore), sizeof(int));
-    
-    
-    uint32_t brickCount = static_cast<uint32_t>(data.bricks.size());
-    file.write(reinterpret_cast<const char*>(&brickCount), sizeof(uint32_t));
-    
-    
-    for (const auto& brick : data.bricks) {
-        file.write(reinterpret_cast<const char*>(&brick.x), sizeof(float));
-        file.write(reinterpret_cast<const char*>(&brick.y), sizeof(float));
-        file.write(reinterpret_cast<const char*>(&brick.width), sizeof(float));
-        file.write(reinterpret_cast<const char*>(&brick.height), sizeof(float));
-        file.write(reinterpret_cast<const char*>(&brick.r), sizeof(std::uint8_t));
-        file.write(reinterpret_cast<const char*>(&brick.g), sizeof(std::uint8_t));
-        file.write(reinterpret_cast<const char*>(&brick.b), sizeof(std::uint8_t));
-        file.write(reinterpret_cast<const char*>(&brick.a), sizeof(std::uint8_t));
-        file.write(reinterpret_cast<const char*>(&brick.hitPoints), sizeof(int));
-        file.write(reinterpret_cast<const char*>(&brick.maxHits), sizeof(int));
-        file.write(reinterpret_cast<const char*>(&brick.hasBonus), sizeof(bool));
-        file.write(reinterpret_cast<const char*>(&brick.bonusType), sizeof(int));
+    std::unordered_map<Entity, Entity> remap;
+    score = state.currentScore;
+    return restoreWorld(filename, state, world, std::numeric_limits<std::uint32_t>::max(), ecs, remap, score);
+}
+
+std::uint32_t SaveSystem::readJournalSequence(const std::string& filename) {
+    MappedFile file;
+    GameSaveData state;
+    std::span<const std::byte> world;
+    if (!file.open(filename) || !parseSaveImage({file.data(), file.size()}, state, world)) {
+        return 0;
     }
-    
-    
-    file.write(reinterpret_cast<const char*>(&data.saveTime), sizeof(std::uint64_t));
-    
-    return file.good();
+    return state.journalSequence;
 }
 
-bool SaveSystem::loadFromFile(GameSaveData& data, const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open save file: " << filename << std::endl;
+std::vector<std::byte> SaveSystem::buildSaveImage(const SaveSnapshot& snapshot) {
+    const GameSaveData& state = snapshot.state;
+    const std::span<const std::byte> world = snapshot.world;
+    const std::size_t sectionCount = 3;
+    const std::size_t tableOffset = sizeof(SaveFileHeader);
+    const std::size_t stateOffset = alignSection(tableOffset + sectionCount * sizeof(SaveSectionEntry));
+    const std::size_t randomOffset = alignSection(stateOffset + sizeof(GameSaveData));
+    const std::size_t worldOffset = alignSection(randomOffset + sizeof(RandomSaveData));
+    const std::size_t fileSize = worldOffset + world.size();
+
+    std::vector<std::byte> image(fileSize);
+
+    const SaveSectionEntry sections[sectionCount] = {
+        {static_cast<std::uint32_t>(SaveSectionId::State), sizeof(GameSaveData), stateOffset, 1},
+        {static_cast<std::uint32_t>(SaveSectionId::Random), sizeof(RandomSaveData), randomOffset, 1},
+        {static_cast<std::uint32_t>(SaveSectionId::Components), 1, worldOffset, world.size()},
+    };
+    std::memcpy(image.data() + tableOffset, sections, sizeof(sections));
+    std::memcpy(image.data() + stateOffset, &state, sizeof(state));
+    std::memcpy(image.data() + randomOffset, &snapshot.random, sizeof(snapshot.random));
+    if (!world.empty()) {
+        std::memcpy(image.data() + worldOffset, world.data(), world.size());
+    }
+
+    SaveFileHeader header{};
+    std::memcpy(header.magic, SAVE_MAGIC, sizeof(header.magic));
+    header.version = SAVE_FORMAT_VERSION;
+    header.endianTag = SAVE_ENDIAN_TAG;
+    header.headerSize = sizeof(SaveFileHeader);
+    header.sectionCount = sectionCount;
+    header.fileSize = fileSize;
+    header.saveTime = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.crc = crc32(image.data() + sizeof(SaveFileHeader), fileSize - sizeof(SaveFileHeader));
+    std::memcpy(image.data(), &header, sizeof(header));
+
+    return image;
+}
+
+bool SaveSystem::parseSaveImage(std::span<const std::byte> image, GameSaveData& state, std::span<const std::byte>& world,
+                                RandomSaveData* random) {
+    if constexpr (std::endian::native != std::endian::little) {
+        std::cerr << "Save files are little-endian; this platform is not supported" << std::endl;
         return false;
     }
-    
-    
-    char header[9] = {0};
-    file.read(header, 8);
-    if (std::strcmp(header, "ARCSAVE") != 0) {
+
+    if (image.size() < sizeof(SaveFileHeader)) {
         std::cerr << "Invalid save file format" << std::endl;
         return false;
     }
-    
-    
-    file.read(reinterpret_cast<char*>(&data.platformX), sizeof(float));
-    file.read(reinterpret_cast<char*>(&data.platformY), sizeof(float));
-    
-    
-    file.read(reinterpret_cast<char*>(&data.ballX), sizeof(float));
-    file.read(reinterpret_cast<char*>(&data.ballY), sizeof(float));
-    file.read(reinterpret_cast<char*>(&data.ballVelX), sizeof(float));
-    file.read(reinterpret_cast<char*>(&data.ballVelY), sizeof(float));
-    
-    
-    file.read(reinterpret_cast<char*>(&data.currentScore), sizeof(int));
-    
-    
-    uint32_t brickCount = 0;
-    file.read(reinterpret_cast<char*>(&brickCount), sizeof(uint32_t));
-    
-    
-    data.bricks.resize(brickCount);
-    for (uint32_t i = 0; i < brickCount; ++i) {
-        auto& brick = data.bricks[i];
-        file.read(reinterpret_cast<char*>(&brick.x), sizeof(float));
-        file.read(reinterpret_cast<char*>(&brick.y), sizeof(float));
-        file.read(reinterpret_cast<char*>(&brick.width), sizeof(float));
-        file.read(reinterpret_cast<char*>(&brick.height), sizeof(float));
-        file.read(reinterpret_cast<char*>(&brick.r), sizeof(std::uint8_t));
-        file.read(reinterpret_cast<char*>(&brick.g), sizeof(std::uint8_t));
-        file.read(reinterpret_cast<char*>(&brick.b), sizeof(std::uint8_t));
-        file.read(reinterpret_cast<char*>(&brick.a), sizeof(std::uint8_t));
-        file.read(reinterpret_cast<char*>(&brick.hitPoints), sizeof(int));
-        file.read(reinterpret_cast<char*>(&brick.maxHits), sizeof(int));
-        file.read(reinterpret_cast<char*>(&brick.hasBonus), sizeof(bool));
-        file.read(reinterpret_cast<char*>(&brick.bonusType), sizeof(int));
-    }
-    
-    
-    file.read(reinterpret_cast<char*>(&data.saveTime), sizeof(std::uint64_t));
-    
-    return file.good();
-}
 
-GameSaveData SaveSystem::createSaveData(const Game& game) {
-    GameSaveData data;
-    const auto& ecs = game.getECS();
-    Entity platform = game.getPlatform();
-    Entity ball = game.getBall();
-    const auto& bricks = game.getBricks();
-    
-    
-    if (auto pos = ecs.getComponent<PositionComponent>(platform)) {
-        data.platformX = pos->position.x;
-        data.platformY = pos->position.y;
+    SaveFileHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    if (std::memcmp(header.magic, SAVE_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << "Invalid save file format" << std::endl;
+        return false;
     }
-    
-    
-    if (auto pos = ecs.getComponent<PositionComponent>(ball)) {
-        data.ballX = pos->position.x;
-        data.ballY = pos->position.y;
+    if (header.version != SAVE_FORMAT_VERSION || header.endianTag != SAVE_ENDIAN_TAG ||
+        header.headerSize != sizeof(SaveFileHeader)) {
+        std::cerr << "Unsupported save file version " << header.version << std::endl;
+        return false;
+    }
+    if (header.fileSize != image.size() || header.sectionCount > 16 ||
+        sizeof(SaveFileHeader) + header.sectionCount * sizeof(SaveSectionEntry) > image.size()) {
+        std::cerr << "Truncated or corrupt save file" << std::endl;
+        return false;
     }
-    if (auto vel = ecs.getComponent<VelocityComponent>(ball)) {
-        data.ballVelX = vel->velocity.x;
-        data.ballVelY = vel->velocity.y;
+    if (crc32(image.data() + sizeof(SaveFileHeader), image.size() - sizeof(SaveFileHeader)) != header.crc) {
+        std::cerr << "Save file checksum mismatch" << std::endl;
+        return false;
     }
-    
-    
-    data.currentScore = GAME_STATE.getCurrentScore();
-    
-    
-    for (Entity brickEntity : bricks) {
-        auto pos = ecs.getComponent<PositionComponent>(brickEntity);
-        auto shape = ecs.getComponent<ShapeComponent>(brickEntity);
-        auto collider = ecs.getComponent<ColliderComponent>(brickEntity);
-        auto durable = ecs.getComponent<DurableBrick>(brickEntity);
-        
-        if (pos && shape && collider) {
-            BrickSaveData brickData;
-            brickData.x = pos->position.x;
-            brickData.y = pos->position.y;
-            brickData.width = shape->rectangle.width;
-            brickData.height = shape->rectangle.height;
-            brickData.r = shape->color.r;
-            brickData.g = shape->color.g;
-            brickData.b = shape->color.b;
-            brickData.a = shape->color.a;
-            
-            if (durable) {
-                brickData.hitPoints = durable->currentHits;
-                brickData.maxHits = durable->maxHits;
-            } else {
-                brickData.hitPoints = 0;
-                brickData.maxHits = 1;
-            }
-            
-            
-            auto bonus = ecs.getComponent<BonusComponent>(brickEntity);
-            brickData.hasBonus = (bonus != nullptr);
-            if (bonus) {
-                brickData.bonusType = static_cast<int>(bonus->type);
-            } else {
-                brickData.bonusType = 0;
-            }
-            
-            data.bricks.push_back(brickData);
+
+    std::vector<SaveSectionEntry> sections(header.sectionCount);
+    std::memcpy(sections.data(), image.data() + sizeof(SaveFileHeader), sections.size() * sizeof(SaveSectionEntry));
+    for (const auto& section : sections) {
+        if (section.offset % SAVE_SECTION_ALIGNMENT != 0 || section.offset > image.size() ||
+            section.elementSize == 0 || section.count > (image.size() - section.offset) / section.elementSize) {
+            std::cerr << "Save file section out of bounds" << std::endl;
+            return false;
         }
     }
+
+    const SaveSectionEntry* stateSection = findSection(sections, SaveSectionId::State);
+    const SaveSectionEntry* worldSection = findSection(sections, SaveSectionId::Components);
+    if (!stateSection || stateSection->elementSize != sizeof(GameSaveData) || stateSection->count != 1 ||
+        !worldSection || worldSection->elementSize != 1) {
+        std::cerr << "Save file is missing required sections" << std::endl;
+        return false;
+    }
+
+    std::memcpy(&state, image.data() + stateSection->offset, sizeof(state));
+    world = image.subspan(static_cast<std::size_t>(worldSection->offset), static_cast<std::size_t>(worldSection->count));
     
+    const SaveSectionEntry* randomSection = findSection(sections, SaveSectionId::Random);
+    if (random && randomSection && randomSection->elementSize == sizeof(RandomSaveData) && randomSection->count == 1) {
+        std::memcpy(random, image.data() + randomSection->offset, sizeof(*random));
+    }
+    return true;
+}
+
+GameSaveData SaveSystem::createSaveData(const Game& game, std::vector<std::byte>& world) {
+    GameSaveData data{};
+    data.platform = game.getPlatform();
+    data.ball = game.getBall();
+    data.currentScore = GAME_STATE.getCurrentScore();
     
-    data.saveTime = std::chrono::system_clock::now().time_since_epoch().count();
+    world.clear();
+    WorldSerializer::writeWorld(game.getECS(), world);
     
     return data;
 }
 
-bool SaveSystem::applySaveData(Game& game, const GameSaveData& data) {
-    auto& ecs = game.getECS();
-    Entity platform = game.getPlatform();
-    Entity ball = game.getBall();
-    auto& bricks = game.getBricks();
-    
-    
-    for (Entity brick : bricks) {
-        ecs.destroyEntity(brick);
+bool SaveSystem::restoreWorld(const std::string& filename, const GameSaveData& state, std::span<const std::byte> world,
+                              std::uint32_t lastSegment, ECSManager& ecs, std::unordered_map<Entity, Entity>& remap,
+                              int& score) {
+    if (!WorldSerializer::readWorld(world, ecs, remap)) {
+        std::cerr << "Corrupt component data in save file" << std::endl;
+        return false;
     }
-    bricks.clear();
     
-    
-    if (auto pos = ecs.getComponent<PositionComponent>(platform)) {
-        pos->position.x = data.platformX;
-        pos->position.y = data.platformY;
+    for (std::uint32_t sequence = state.journalSequence;
+         sequence <= lastSegment && SaveJournal::segmentExists(filename, sequence); ++sequence) {
+        SaveJournal::replaySegment(SaveJournal::segmentName(filename, sequence), ecs, remap, score);
     }
     
-    
-    if (auto pos = ecs.getComponent<PositionComponent>(ball)) {
-        pos->position.x = data.ballX;
-        pos->position.y = data.ballY;
+    if (!WorldSerializer::validateWorld(ecs)) {
+        std::cerr << "Invalid component values in save file" << std::endl;
+        return false;
     }
-    if (auto vel = ecs.getComponent<VelocityComponent>(ball)) {
-        vel->velocity.x = data.ballVelX;
-        vel->velocity.y = data.ballVelY;
-        
-        vel->speed = std::sqrt(vel->velocity.x * vel->velocity.x + vel->velocity.y * vel->velocity.y);
+    return true;
+}
+
+bool SaveSystem::applySaveData(Game& game, const GameSaveData& data, const RandomSaveData& random,
+                               std::span<const std::byte> world, const std::string& filename) {
+    
+    ECSManager loaded;
+    std::unordered_map<Entity, Entity> remap;
+    int score = data.currentScore;
+    if (!restoreWorld(filename, data, world, std::numeric_limits<std::uint32_t>::max(), loaded, remap, score)) {
+        return false;
     }
     
+    auto platform = remap.find(data.platform);
+    auto ball = remap.find(data.ball);
+    if (platform == remap.end() || ball == remap.end()) {
+        std::cerr << "Save file is missing the platform or ball" << std::endl;
+        return false;
+    }
     
-    GAME_STATE.resetCurrentScore();
-    GAME_STATE.addScore(data.currentScore);
+    auto& ecs = game.getECS();
+    game.flushDestroyedBricks();
+    game.cancelBonusTimers();
+    ecs.swapComponents(loaded);
+    game.setPlatform(platform->second);
+    game.setBall(ball->second);
+    game.restoreRandom(random.seed, random.layoutCount);
+    game.restoreBonusTimers();
     
     
-    for (const auto& brickData : data.bricks) {
-        sf::Color color(brickData.r, brickData.g, brickData.b, brickData.a);
-        
-        Entity brick = EntityFactory::createBrick(ecs, brickData.x, brickData.y, brickData.width, brickData.height, color, brickData.maxHits);
-        
-        if (auto durable = ecs.getComponent<DurableBrick>(brick)) {
-            durable->currentHits = brickData.hitPoints;
-            
-        }
-        
-        if (brickData.hasBonus) {
-            BonusType type = static_cast<BonusType>(brickData.bonusType);
-            ecs.addComponent<BonusComponent>(brick, std::make_shared<BonusComponent>(type));
+    auto& bricks = game.getBricks();
+    bricks.clear();
+    ecs.forEachComponent<ColliderComponent>([&](Entity entity, const ColliderComponent& collider) {
+        if (collider.type == ColliderComponent::Type::Brick) {
+            bricks.push_back(entity);
         }
-        bricks.push_back(brick);
-    }
+    });
+    
+    
+    GAME_STATE.resetCurrentScore();
+    GAME_STATE.addScore(score);
     
     return true;
-}
\ No newline at end of file
+}
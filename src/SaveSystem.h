@@ -2,59 +2,130 @@
 
 #include <string>
 #include <vector>
+#include <span>
+#include <unordered_map>
 #include <cstdint>
-#include <SFML/System/Vector2.hpp>
+#include <type_traits>
 #include "ECS/Entity.h"
 
 
 class Game;
 class ECSManager;
+struct SaveSlotInfo;
 
-struct BrickSaveData {
-    float x, y;
-    float width, height;
-    std::uint8_t r, g, b, a;
-    int hitPoints;
-    int maxHits;
-    bool hasBonus;
-    int bonusType; 
+// Save file layout (version 3, little-endian, every section 16-byte aligned):
+//
+//   SaveFileHeader
+//   SaveSectionEntry[sectionCount]
+//   section payloads
+//
+// The State section holds one GameSaveData; the Components section is a
+// WorldSerializer snapshot of every reflected component. The optional Random
+// section holds one RandomSaveData; older saves without it keep the running
+// game's seed. The CRC covers
+// every byte after the header. Loading maps the file, deserializes the
+// snapshot straight from the mapping and then replays the SaveJournal
+// segments starting at GameSaveData::journalSequence. Components are copied
+// out of the mapping, one pass per column: the ECS keeps them as structs,
+// not as the file's columns, so they are not used in place.
+constexpr std::uint32_t SAVE_FORMAT_VERSION = 3;
+constexpr std::uint32_t SAVE_ENDIAN_TAG = 0x01020304;
+constexpr std::size_t SAVE_SECTION_ALIGNMENT = 16;
+
+enum class SaveSectionId : std::uint32_t {
+    State = 1,
+    Components = 3,
+    Random = 4,
+};
+
+struct SaveFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianTag;
+    std::uint32_t headerSize;
+    std::uint32_t sectionCount;
+    std::uint64_t fileSize;
+    std::uint32_t crc;
+    std::uint32_t reserved;
+    std::uint64_t saveTime;
+};
+
+struct SaveSectionEntry {
+    std::uint32_t id;
+    std::uint32_t elementSize;
+    std::uint64_t offset;
+    std::uint64_t count;
 };
 
 struct GameSaveData {
     
-    float platformX, platformY;
+    Entity platform;
+    Entity ball;
     
     
-    float ballX, ballY;
-    float ballVelX, ballVelY;
+    std::int32_t currentScore;
+    std::uint32_t journalSequence;
+};
+
+// Seed of the game's RandomService and how many brick layouts it has
+// generated, so a loaded game continues the same sequence of levels.
+struct RandomSaveData {
+    std::uint64_t seed;
+    std::uint32_t layoutCount;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(SaveFileHeader) == 48 && std::is_trivially_copyable_v<SaveFileHeader>);
+static_assert(sizeof(SaveSectionEntry) == 24 && std::is_trivially_copyable_v<SaveSectionEntry>);
+static_assert(sizeof(GameSaveData) == 16 && std::is_trivially_copyable_v<GameSaveData>);
+static_assert(sizeof(RandomSaveData) == 16 && std::is_trivially_copyable_v<RandomSaveData>);
+
+// Everything needed to write a save, detached from the live game so it can be
+// written on another thread.
+struct SaveSnapshot {
+    GameSaveData state{};
+    RandomSaveData random{};
+    std::vector<std::byte> world;
+};
+
+class SaveSystem {
+public:
     
+    static bool saveGame(const Game& game, const std::string& filename);
     
-    std::vector<BrickSaveData> bricks;
     
+    static SaveSnapshot captureSave(const Game& game);
+    static bool writeSave(const SaveSnapshot& snapshot, const std::string& filename);
     
-    int currentScore;
     
+    // Folds journal segments up to and including `sequence` into a new
+    // checkpoint whose journalSequence is sequence + 1. `info` receives the
+    // slot metadata of the new checkpoint.
+    static bool compactJournal(const std::string& filename, std::uint32_t sequence, SaveSlotInfo* info = nullptr);
     
-    std::uint64_t saveTime;
-};
-
-class SaveSystem {
-public:
+    // Restores a save (checkpoint plus journal) into `ecs` without touching
+    // the running game. saveTime is in seconds since the epoch.
+    static bool loadWorld(const std::string& filename, ECSManager& ecs, int& score, std::int64_t& saveTime);
     
-    static bool saveGame(const Game& game, const std::string& filename);
+    // journalSequence of the checkpoint on disk, or 0 when there is none.
+    static std::uint32_t readJournalSequence(const std::string& filename);
     
     
     static bool loadGame(Game& game, const std::string& filename);
     
     
-    static bool saveExists(const std::string& filename);
-    
 private:
     
-    static bool saveToFile(const GameSaveData& data, const std::string& filename);
-    static bool loadFromFile(GameSaveData& data, const std::string& filename);
+    static std::vector<std::byte> buildSaveImage(const SaveSnapshot& snapshot);
+    // `random` is left unchanged when the save has no Random section.
+    static bool parseSaveImage(std::span<const std::byte> image, GameSaveData& state, std::span<const std::byte>& world,
+                               RandomSaveData* random = nullptr);
     
     
-    static GameSaveData createSaveData(const Game& game);
-    static bool applySaveData(Game& game, const GameSaveData& data);
-};
\ No newline at end of file
+    static GameSaveData createSaveData(const Game& game, std::vector<std::byte>& world);
+    static bool restoreWorld(const std::string& filename, const GameSaveData& state, std::span<const std::byte> world,
+                             std::uint32_t lastSegment, ECSManager& ecs, std::unordered_map<Entity, Entity>& remap,
+                             int& score);
+    static bool applySaveData(Game& game, const GameSaveData& state, const RandomSaveData& random,
+                              std::span<const std::byte> world, const std::string& filename);
+};
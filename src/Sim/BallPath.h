@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cmath>
+
+// Where a ball of `radius` at (x, y) moving at (vx, vy) has its center at
+// height `targetY` on the way down, bouncing inside [0, width] and off the
+// ceiling at 0. Returns x if it never gets there.
+//
+// Reflection off a wall is the same as going straight on into a mirrored
+// copy of the field: the ball travels |dy| vertically (via the ceiling when
+// rising), and its unfolded x is folded back into the field with a
+// triangle wave of period twice the field width.
+inline float predictBallCrossingX(float x, float y, float vx, float vy, float radius, float targetY, float width)
+{
+    if (vy == 0.0f) return x;
+
+    const float top = radius;
+    const float distance = vy > 0.0f ? targetY - y : (y - top) + (targetY - top);
+    if (distance <= 0.0f) return x;
+
+    const float span = width - 2.0f * radius;
+    if (span <= 0.0f) return width / 2.0f;
+
+    const float unfolded = x - radius + vx * (distance / std::abs(vy));
+    float folded = std::fmod(unfolded, 2.0f * span);
+    if (folded < 0.0f) folded += 2.0f * span;
+    if (folded > span) folded = 2.0f * span - folded;
+    return radius + folded;
+}
@@ -0,0 +1,316 @@
+#include "BeamSolver.h"
+#include "BallPath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+namespace
+{
+
+constexpr std::uint32_t NONE = UINT32_MAX;
+
+enum class Outcome : std::uint8_t
+{
+    Bounced,
+    Cleared,
+    Lost,
+    Stalled
+};
+
+// A bounce on the path to a beam game, for rebuilding contact sequences.
+struct PathNode
+{
+    std::uint32_t parent;
+    float contact;
+};
+
+struct BeamEntry
+{
+    std::uint32_t node;
+    std::uint32_t frames;
+    std::uint32_t bricksLeft;
+    std::uint32_t bounces;
+};
+
+struct Child
+{
+    Outcome outcome;
+    std::uint32_t frames;
+    std::uint32_t bricksLeft;
+};
+
+// Plays children [first, last) of the beam to their next bounce in one
+// environment, one instance per child.
+class Expander
+{
+public:
+    Expander(const LevelData& level, std::size_t capacity, const EnvSettings& settings, std::uint64_t seed)
+        : env(level, capacity, settings), observations(capacity * VectorEnv::OBSERVATION_SIZE), rewards(capacity),
+          dones(capacity), actions(capacity), contacts(capacity), startBounces(capacity), resolved(capacity)
+    {
+        env.setAutoReset(false);
+        env.reset(seed, observations);
+    }
+
+    std::uint64_t expand(std::size_t first, std::size_t last, const std::vector<BeamEntry>& beam,
+                         const std::vector<std::byte>& beamStates, std::vector<std::byte>& childStates,
+                         std::vector<Child>& children, const std::vector<float>& branchContacts,
+                         std::uint32_t maxFrames)
+    {
+        const std::size_t stateSize = env.getStateSize();
+        const std::size_t branches = branchContacts.size();
+        const std::size_t n = last - first;
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const std::size_t parent = (first + k) / branches;
+            env.loadState(k, std::span(beamStates).subspan(parent * stateSize, stateSize));
+            env.observe(k, observations);
+            contacts[k] = branchContacts[(first + k) % branches];
+            startBounces[k] = env.getBounces(k);
+            resolved[k] = 0;
+        }
+        std::fill(actions.begin(), actions.end(), 0);
+
+        const EnvSettings& settings = env.getSettings();
+        const float halfWidth = settings.paddleWidth / 2.0f;
+        const float contactY = settings.paddleStartY - settings.ballRadius;
+        // Half a frame of paddle travel: the paddle settles within it of the
+        // target without stepping back and forth.
+        const float deadZone = settings.paddleSpeed * settings.frameTime / 2.0f;
+
+        std::uint64_t steps = 0;
+        std::size_t pending = n;
+        for (std::uint32_t frame = 1; frame <= maxFrames && pending > 0; ++frame)
+        {
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                if (resolved[k]) continue;
+                const float* observation = observations.data() + k * VectorEnv::OBSERVATION_SIZE;
+                const float landing = predictBallCrossingX(observation[0], observation[1], observation[2],
+                                                           observation[3], settings.ballRadius, contactY,
+                                                           settings.windowWidth);
+                const float offset = landing - contacts[k] * halfWidth - (observation[4] + halfWidth);
+                actions[k] = offset < -deadZone ? -1 : offset > deadZone ? 1 : 0;
+            }
+            env.step(actions, observations, rewards, dones);
+            steps += n;
+
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                if (resolved[k]) continue;
+                Child& child = children[first + k];
+                if (dones[k])
+                {
+                    child.outcome = env.getBricksLeft(k) == 0 ? Outcome::Cleared : Outcome::Lost;
+                }
+                else if (env.getBounces(k) != startBounces[k])
+                {
+                    child.outcome = Outcome::Bounced;
+                    env.saveState(k, std::span(childStates).subspan((first + k) * stateSize, stateSize));
+                }
+                else
+                {
+                    continue;
+                }
+                child.frames = beam[(first + k) / branches].frames + frame;
+                child.bricksLeft = env.getBricksLeft(k);
+                resolved[k] = 1;
+                actions[k] = 0;
+                pending--;
+            }
+        }
+
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            if (!resolved[k]) children[first + k].outcome = Outcome::Stalled;
+        }
+        return steps;
+    }
+
+private:
+    VectorEnv env;
+    std::vector<float> observations;
+    std::vector<float> rewards;
+    std::vector<std::uint8_t> dones;
+    std::vector<std::int8_t> actions;
+    std::vector<float> contacts;
+    std::vector<std::uint32_t> startBounces;
+    std::vector<std::uint8_t> resolved;
+};
+
+std::vector<float> contactsOf(const std::vector<PathNode>& path, std::uint32_t node)
+{
+    std::vector<float> contacts;
+    for (; node != NONE && path[node].parent != NONE; node = path[node].parent)
+    {
+        contacts.push_back(path[node].contact);
+    }
+    std::reverse(contacts.begin(), contacts.end());
+    return contacts;
+}
+
+}
+
+SolverResult BeamSolver::solve(const LevelData& level, const SolverParams& params, const EnvSettings& settings)
+{
+    SolverResult result;
+    if (params.beamWidth == 0 || params.branches == 0 || settings.frameTime <= 0.0f)
+    {
+        std::cerr << "BeamSolver::solve: beam width, branches and frame time must be positive" << std::endl;
+        return result;
+    }
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<float> branchContacts(params.branches, 0.0f);
+    for (std::uint32_t b = 0; params.branches > 1 && b < params.branches; ++b)
+    {
+        branchContacts[b] = params.maxContact * (2.0f * static_cast<float>(b) / (params.branches - 1) - 1.0f);
+    }
+    const std::uint32_t maxFrames = static_cast<std::uint32_t>(std::ceil(params.maxFlightTime / settings.frameTime));
+
+    unsigned int threads = params.threads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t maxChildren = params.beamWidth * params.branches;
+    threads = static_cast<unsigned int>(std::min<std::size_t>(threads, maxChildren));
+    const std::size_t chunk = (maxChildren + threads - 1) / threads;
+
+    std::vector<std::unique_ptr<Expander>> expanders;
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        expanders.push_back(std::make_unique<Expander>(level, chunk, settings, params.seed));
+    }
+
+    // The root is the game as dealt, before the first bounce.
+    std::size_t stateSize;
+    std::vector<std::byte> beamStates;
+    std::vector<BeamEntry> beam{{0, 0, 0, 0}};
+    {
+        VectorEnv root(level, 1, settings);
+        std::vector<float> observations(VectorEnv::OBSERVATION_SIZE);
+        root.reset(params.seed, observations);
+        stateSize = root.getStateSize();
+        beamStates.resize(params.beamWidth * stateSize);
+        root.saveState(0, std::span(beamStates).first(stateSize));
+        beam[0].bricksLeft = root.getBricksLeft(0);
+        if (beam[0].bricksLeft == 0)
+        {
+            result.cleared = true;
+            return result;
+        }
+    }
+    std::vector<PathNode> path{{NONE, 0.0f}};
+
+    std::vector<std::byte> childStates(maxChildren * stateSize);
+    std::vector<std::byte> nextStates(params.beamWidth * stateSize);
+    std::vector<Child> children(maxChildren);
+    std::vector<std::uint32_t> ranked;
+    ranked.reserve(maxChildren);
+
+    std::uint32_t bestClear = UINT32_MAX;
+    std::uint32_t bestClearNode = NONE;
+    std::uint32_t clearBounces = 0;
+    BeamEntry bestPartial = beam[0];
+
+    for (std::uint32_t depth = 0; depth < params.maxBounces && !beam.empty(); ++depth)
+    {
+        const std::size_t childCount = beam.size() * params.branches;
+        const std::size_t share = (childCount + threads - 1) / threads;
+        std::vector<std::uint64_t> steps(threads, 0);
+        auto expandChunk = [&](unsigned int t)
+        {
+            const std::size_t first = std::min(t * share, childCount);
+            const std::size_t last = std::min(first + share, childCount);
+            if (first < last)
+            {
+                steps[t] = expanders[t]->expand(first, last, beam, beamStates, childStates, children,
+                                                branchContacts, maxFrames);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            workers.emplace_back(expandChunk, t);
+        }
+        expandChunk(0);
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        for (std::uint64_t count : steps) result.envSteps += count;
+        result.nodes += childCount;
+
+        ranked.clear();
+        for (std::uint32_t c = 0; c < childCount; ++c)
+        {
+            const Child& child = children[c];
+            const BeamEntry& parent = beam[c / params.branches];
+            if (child.outcome == Outcome::Cleared && child.frames < bestClear)
+            {
+                // The level clears before the ball is back on the paddle.
+                bestClear = child.frames;
+                bestClearNode = parent.node;
+                clearBounces = parent.bounces;
+            }
+            // Games that cannot beat the best clear any more are dropped.
+            else if (child.outcome == Outcome::Bounced && child.frames < bestClear)
+            {
+                ranked.push_back(c);
+            }
+        }
+
+        const std::size_t kept = std::min(ranked.size(), params.beamWidth);
+        std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(kept), ranked.end(),
+                          [&](std::uint32_t a, std::uint32_t b)
+                          {
+                              const Child& x = children[a];
+                              const Child& y = children[b];
+                              if (x.bricksLeft != y.bricksLeft) return x.bricksLeft < y.bricksLeft;
+                              if (x.frames != y.frames) return x.frames < y.frames;
+                              return a < b;
+                          });
+
+        std::vector<BeamEntry> next;
+        next.reserve(kept);
+        for (std::size_t j = 0; j < kept; ++j)
+        {
+            const std::uint32_t c = ranked[j];
+            const BeamEntry& parent = beam[c / params.branches];
+            next.push_back({static_cast<std::uint32_t>(path.size()), children[c].frames, children[c].bricksLeft,
+                            parent.bounces + 1});
+            path.push_back({parent.node, branchContacts[c % params.branches]});
+            std::memcpy(nextStates.data() + j * stateSize, childStates.data() + c * stateSize, stateSize);
+        }
+        beam.swap(next);
+        beamStates.swap(nextStates);
+
+        if (!beam.empty() && (beam[0].bricksLeft < bestPartial.bricksLeft ||
+                              (beam[0].bricksLeft == bestPartial.bricksLeft && beam[0].frames < bestPartial.frames)))
+        {
+            bestPartial = beam[0];
+        }
+    }
+
+    if (bestClearNode != NONE)
+    {
+        result.cleared = true;
+        result.frames = bestClear;
+        result.bounces = clearBounces;
+        result.bricksLeft = 0;
+        result.contacts = contactsOf(path, bestClearNode);
+    }
+    else
+    {
+        result.frames = bestPartial.frames;
+        result.bounces = bestPartial.bounces;
+        result.bricksLeft = bestPartial.bricksLeft;
+        result.contacts = contactsOf(path, bestPartial.node);
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
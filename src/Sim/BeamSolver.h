@@ -0,0 +1,56 @@
+#pragma once
+
+#include "VectorEnv.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct SolverParams
+{
+    // Games kept after every bounce.
+    std::size_t beamWidth = 256;
+    // Contact points tried per bounce, spread evenly across the paddle.
+    std::uint32_t branches = 7;
+    // Outermost contact point, as a fraction of half the paddle width.
+    float maxContact = 0.8f;
+    std::uint32_t maxBounces = 500;
+    // A game that goes this long without touching the paddle is dropped.
+    float maxFlightTime = 30.0f;
+    // 0 uses every hardware thread.
+    unsigned int threads = 0;
+    std::uint64_t seed = 1;
+};
+
+struct SolverResult
+{
+    bool cleared = false;
+    // The fastest clear, or the game closest to one if there is none.
+    std::uint32_t frames = 0;
+    std::uint32_t bounces = 0;
+    std::uint32_t bricksLeft = 0;
+    // Contact point of every bounce, from -1 (left end) to 1 (right end).
+    std::vector<float> contacts;
+
+    // One node is one game played from a bounce to the next.
+    std::uint64_t nodes = 0;
+    std::uint64_t envSteps = 0;
+    double seconds = 0.0;
+};
+
+// Looks for the fastest clear of a level by beam search over paddle
+// contact points. Each node is a game saved right after a bounce; it is
+// expanded by loading it into VectorEnv instances once per contact point
+// and steering each paddle to meet the ball there, until the ball next
+// touches the paddle, falls out or clears the level. The surviving games
+// are ranked by bricks left, then time, and the best beamWidth carried on.
+// Expansions are split across threads, each stepping its share in one
+// VectorEnv, so games cost the environment's per-step rate and a clone is
+// one saved state.
+//
+// The search is deterministic: the result does not depend on the number
+// of threads.
+class BeamSolver
+{
+public:
+    static SolverResult solve(const LevelData& level, const SolverParams& params, const EnvSettings& settings = {});
+};
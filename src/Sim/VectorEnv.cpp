@@ -0,0 +1,635 @@
+#include "VectorEnv.h"
+#include "../Physics.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <cstring>
+#include <limits>
+
+// The vector paths are float math; fixed point builds run the scalar paths.
+#if !defined(ARCANOID_FIXED_POINT) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define VECTOR_ENV_SSE2 1
+#endif
+
+namespace
+{
+#ifdef VECTOR_ENV_SSE2
+// mask ? a : b, lane by lane.
+__m128 select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+// Buckets [first, last] along one axis that can hold a brick of `size`
+// overlapping [low, high]; one either side absorbs rounding.
+void bucketRange(float low, float high, float origin, float step, float size, int buckets, int& first, int& last)
+{
+    if (step <= 0.0f)
+    {
+        first = last = 0;
+        return;
+    }
+    const float limit = static_cast<float>(buckets - 1);
+    first = static_cast<int>(std::clamp(std::floor((low - origin - size) / step) - 1.0f, 0.0f, limit));
+    last = static_cast<int>(std::clamp(std::floor((high - origin) / step) + 1.0f, 0.0f, limit));
+}
+}
+
+VectorEnv::VectorEnv(const LevelData& level, std::size_t count, const EnvSettings& settings)
+    : settings(settings), count(count)
+{
+    ballSpeed0 = Physics::length(Scalar(settings.ballVelocityX), Scalar(settings.ballVelocityY));
+    increaseTicks = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::llround(static_cast<double>(settings.speedIncreaseInterval) *
+                                                   settings.ticksPerSecond)));
+    buildLayout(level);
+
+    ballX.resize(count);
+    ballY.resize(count);
+    ballVX.resize(count);
+    ballVY.resize(count);
+    ballSpeed.resize(count);
+    paddleX.resize(count);
+    speedMultiplier.resize(count);
+    ticks.resize(count);
+    tickCarry.resize(count);
+    nextIncrease.resize(count);
+    bricksLeft.resize(count);
+    gained.resize(count);
+    episodes.resize(count);
+    bounces.resize(count);
+    layouts.resize(count);
+    hits.resize(count * brickCount);
+    maxHits.resize(count * brickCount);
+}
+
+// Brick bounds are worked out as LevelLoader places bricks and
+// CollisionSystem indexes them.
+void VectorEnv::buildLayout(const LevelData& level)
+{
+    const LevelSettings& levelSettings = level.settings;
+    brickCount = level.cells.size();
+    minHitPoints = levelSettings.minHitPoints;
+    maxHitPoints = levelSettings.maxHitPoints;
+    originX = levelSettings.originX;
+    originY = levelSettings.originY;
+    brickWidth = levelSettings.brickWidth;
+    brickHeight = levelSettings.brickHeight;
+    const float cellStepX = levelSettings.brickWidth + levelSettings.spacing;
+    const float cellStepY = levelSettings.brickHeight + levelSettings.spacing;
+    stepX = cellStepX > 0.0f ? cellStepX : 0.0f;
+    stepY = cellStepY > 0.0f ? cellStepY : 0.0f;
+
+    brickLeft.resize(brickCount);
+    brickTop.resize(brickCount);
+    brickRight.resize(brickCount);
+    brickBottom.resize(brickCount);
+    cellHitPoints.resize(brickCount);
+    explosive.resize(brickCount);
+
+    std::uint32_t maxColumn = 0;
+    std::uint32_t maxRow = 0;
+    fieldLeft = fieldTop = std::numeric_limits<float>::max();
+    fieldRight = fieldBottom = std::numeric_limits<float>::lowest();
+    for (std::size_t brick = 0; brick < brickCount; ++brick)
+    {
+        const LevelCell& cell = level.cells[brick];
+        brickLeft[brick] = levelSettings.originX + cell.column * cellStepX;
+        brickTop[brick] = levelSettings.originY + cell.row * cellStepY;
+        brickRight[brick] = brickLeft[brick] + levelSettings.brickWidth;
+        brickBottom[brick] = brickTop[brick] + levelSettings.brickHeight;
+        cellHitPoints[brick] = cell.hitPoints;
+        explosive[brick] = (cell.flags & LEVEL_CELL_EXPLOSIVE) ? 1 : 0;
+
+        maxColumn = std::max<std::uint32_t>(maxColumn, cell.column);
+        maxRow = std::max(maxRow, cell.row);
+        fieldLeft = std::min(fieldLeft, brickLeft[brick]);
+        fieldTop = std::min(fieldTop, brickTop[brick]);
+        fieldRight = std::max(fieldRight, brickRight[brick]);
+        fieldBottom = std::max(fieldBottom, brickBottom[brick]);
+    }
+
+    columns = stepX > 0.0f ? static_cast<int>(maxColumn) + 1 : 1;
+    rows = stepY > 0.0f ? static_cast<int>(maxRow) + 1 : 1;
+    auto bucketOf = [&](const LevelCell& cell) {
+        const std::size_t column = stepX > 0.0f ? cell.column : 0;
+        const std::size_t row = stepY > 0.0f ? cell.row : 0;
+        return row * static_cast<std::size_t>(columns) + column;
+    };
+    bucketStart.assign(static_cast<std::size_t>(columns) * rows + 1, 0);
+    for (const LevelCell& cell : level.cells)
+    {
+        bucketStart[bucketOf(cell) + 1]++;
+    }
+    for (std::size_t bucket = 1; bucket < bucketStart.size(); ++bucket)
+    {
+        bucketStart[bucket] += bucketStart[bucket - 1];
+    }
+    bucketBricks.resize(brickCount);
+    std::vector<std::uint32_t> next(bucketStart.begin(), bucketStart.end() - 1);
+    for (std::size_t brick = 0; brick < brickCount; ++brick)
+    {
+        bucketBricks[next[bucketOf(level.cells[brick])]++] = static_cast<std::uint32_t>(brick);
+    }
+
+    // SpatialGrid::queryRadius around each explosive brick's center, which
+    // CollisionSystem takes from the index box.
+    const float radius = settings.explosionRadius;
+    const float radiusSquared = radius * radius;
+    blastStart.assign(brickCount + 1, 0);
+    blastTargets.clear();
+    for (std::size_t brick = 0; brick < brickCount; ++brick)
+    {
+        blastStart[brick] = static_cast<std::uint32_t>(blastTargets.size());
+        if (!explosive[brick]) continue;
+
+        const float centerX = brickLeft[brick] + (brickRight[brick] - brickLeft[brick]) / 2.0f;
+        const float centerY = brickTop[brick] + (brickBottom[brick] - brickTop[brick]) / 2.0f;
+        const float minX = centerX - radius;
+        const float minY = centerY - radius;
+        const float maxX = centerX + radius;
+        const float maxY = centerY + radius;
+        forEachCandidate(minX, minY, maxX, maxY, [&](std::uint32_t target) {
+            if (target == brick) return;
+            if (!(brickRight[target] > minX && brickLeft[target] < maxX && brickBottom[target] > minY &&
+                  brickTop[target] < maxY))
+                return;
+            const float dx = centerX < brickLeft[target] ? brickLeft[target] - centerX
+                           : centerX > brickRight[target] ? centerX - brickRight[target] : 0.0f;
+            const float dy = centerY < brickTop[target] ? brickTop[target] - centerY
+                           : centerY > brickBottom[target] ? centerY - brickBottom[target] : 0.0f;
+            if (dx * dx + dy * dy <= radiusSquared) blastTargets.push_back(target);
+        });
+    }
+    blastStart[brickCount] = static_cast<std::uint32_t>(blastTargets.size());
+}
+
+template<typename Fn>
+void VectorEnv::forEachCandidate(float minX, float minY, float maxX, float maxY, Fn&& fn) const
+{
+    if (brickCount == 0) return;
+
+    int firstColumn, lastColumn, firstRow, lastRow;
+    bucketRange(minX, maxX, originX, stepX, brickWidth, columns, firstColumn, lastColumn);
+    bucketRange(minY, maxY, originY, stepY, brickHeight, rows, firstRow, lastRow);
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+        for (int column = firstColumn; column <= lastColumn; ++column)
+        {
+            const std::size_t bucket = static_cast<std::size_t>(row) * columns + column;
+            for (std::uint32_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i)
+            {
+                fn(bucketBricks[i]);
+            }
+        }
+    }
+}
+
+void VectorEnv::reset(std::uint64_t seed, std::span<float> observations)
+{
+    if (observations.size() < count * OBSERVATION_SIZE)
+    {
+        std::cerr << "VectorEnv::reset: observation buffer too small" << std::endl;
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        layouts[i] = RandomService(seed + i).stream("bricks");
+        episodes[i] = 0;
+        resetInstance(i);
+        observe(i, observations);
+    }
+}
+
+// Game::initializeGameObjects and Game::recreateBricks; the speed-up timer
+// is due one interval after the first frame, where BallSpeedSystem
+// schedules it.
+void VectorEnv::resetInstance(std::size_t i)
+{
+    ballX[i] = settings.ballStartX;
+    ballY[i] = settings.ballStartY;
+    ballVX[i] = settings.ballVelocityX;
+    ballVY[i] = settings.ballVelocityY;
+    ballSpeed[i] = static_cast<float>(ballSpeed0);
+    paddleX[i] = settings.paddleStartX;
+    speedMultiplier[i] = 1.0f;
+    ticks[i] = 0;
+    tickCarry[i] = 0.0;
+    nextIncrease[i] = increaseTicks;
+    bricksLeft[i] = static_cast<std::uint32_t>(brickCount);
+    bounces[i] = 0;
+
+    const RandomStream layout = layouts[i].substream(episodes[i]);
+    std::int32_t* instanceHits = hits.data() + i * brickCount;
+    std::int32_t* instanceMaxHits = maxHits.data() + i * brickCount;
+    for (std::size_t brick = 0; brick < brickCount; ++brick)
+    {
+        instanceHits[brick] = 0;
+        instanceMaxHits[brick] = cellHitPoints[brick] == LEVEL_HIT_POINTS_RANDOM
+                                     ? layout.substream(brick).nextInt(minHitPoints, maxHitPoints)
+                                     : cellHitPoints[brick];
+    }
+}
+
+void VectorEnv::step(std::span<const std::int8_t> actions, std::span<float> observations, std::span<float> rewards,
+                     std::span<std::uint8_t> dones)
+{
+    if (actions.size() < count || observations.size() < count * OBSERVATION_SIZE || rewards.size() < count ||
+        dones.size() < count)
+    {
+        std::cerr << "VectorEnv::step: buffers smaller than the number of instances" << std::endl;
+        return;
+    }
+
+    std::fill(gained.begin(), gained.end(), 0);
+    move(actions);
+    collideWalls();
+    collidePaddle();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        collideBricks(i);
+    }
+    advanceTimers();
+
+    const float floor = settings.windowHeight;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        rewards[i] = static_cast<float>(gained[i]);
+        const bool done = bricksLeft[i] == 0 || ballY[i] - settings.ballRadius > floor;
+        dones[i] = done ? 1 : 0;
+        if (done && autoReset)
+        {
+            episodes[i]++;
+            resetInstance(i);
+        }
+        observe(i, observations);
+    }
+}
+
+void VectorEnv::saveState(std::size_t i, std::span<std::byte> state) const
+{
+    if (state.size() < getStateSize())
+    {
+        std::cerr << "VectorEnv::saveState: buffer too small" << std::endl;
+        return;
+    }
+
+    const InstanceState fields{ballX[i],      ballY[i],     ballVX[i],   ballVY[i],
+                               ballSpeed[i],  paddleX[i],   speedMultiplier[i],
+                               bricksLeft[i], episodes[i],  bounces[i],
+                               ticks[i],      tickCarry[i], nextIncrease[i]};
+    const std::size_t brickBytes = brickCount * sizeof(std::int32_t);
+    std::memcpy(state.data(), &fields, sizeof(fields));
+    std::memcpy(state.data() + sizeof(fields), hits.data() + i * brickCount, brickBytes);
+    std::memcpy(state.data() + sizeof(fields) + brickBytes, maxHits.data() + i * brickCount, brickBytes);
+}
+
+void VectorEnv::loadState(std::size_t i, std::span<const std::byte> state)
+{
+    if (state.size() < getStateSize())
+    {
+        std::cerr << "VectorEnv::loadState: state too small" << std::endl;
+        return;
+    }
+
+    InstanceState fields;
+    const std::size_t brickBytes = brickCount * sizeof(std::int32_t);
+    std::memcpy(&fields, state.data(), sizeof(fields));
+    std::memcpy(hits.data() + i * brickCount, state.data() + sizeof(fields), brickBytes);
+    std::memcpy(maxHits.data() + i * brickCount, state.data() + sizeof(fields) + brickBytes, brickBytes);
+
+    ballX[i] = fields.ballX;
+    ballY[i] = fields.ballY;
+    ballVX[i] = fields.ballVX;
+    ballVY[i] = fields.ballVY;
+    ballSpeed[i] = fields.ballSpeed;
+    paddleX[i] = fields.paddleX;
+    speedMultiplier[i] = fields.speedMultiplier;
+    bricksLeft[i] = fields.bricksLeft;
+    episodes[i] = fields.episode;
+    bounces[i] = fields.bounces;
+    ticks[i] = fields.ticks;
+    tickCarry[i] = fields.tickCarry;
+    nextIncrease[i] = fields.nextIncrease;
+}
+
+// MovementSystem.
+void VectorEnv::move(std::span<const std::int8_t> actions)
+{
+    const float deltaTime = settings.frameTime;
+    const float moveSpeed = settings.paddleSpeed;
+    const std::int8_t* __restrict action = actions.data();
+    float* __restrict x = ballX.data();
+    float* __restrict y = ballY.data();
+    const float* __restrict vx = ballVX.data();
+    const float* __restrict vy = ballVY.data();
+    float* __restrict platformX = paddleX.data();
+
+    std::size_t i = 0;
+#ifdef VECTOR_ENV_SSE2
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 speed = _mm_set1_ps(moveSpeed);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        std::int32_t packed;
+        std::memcpy(&packed, action + i, sizeof(packed));
+        __m128i widened = _mm_cvtsi32_si128(packed);
+        widened = _mm_unpacklo_epi8(widened, widened);
+        widened = _mm_srai_epi32(_mm_unpacklo_epi16(widened, widened), 24);
+        const __m128 moveDirection = _mm_min_ps(_mm_max_ps(_mm_cvtepi32_ps(widened), minusOne), one);
+
+        _mm_storeu_ps(platformX + i,
+                      _mm_add_ps(_mm_loadu_ps(platformX + i), _mm_mul_ps(_mm_mul_ps(moveDirection, speed), dt)));
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), dt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), dt)));
+    }
+#endif
+    const Scalar frameTime(deltaTime);
+    for (; i < count; ++i)
+    {
+        const float moveDirection = action[i] < 0 ? -1.0f : action[i] > 0 ? 1.0f : 0.0f;
+        // Through float, as the paddle's VelocityComponent holds it.
+        const Scalar platformVX(static_cast<float>(Scalar(moveDirection) * Scalar(moveSpeed)));
+        platformX[i] = static_cast<float>(Physics::advance(Scalar(platformX[i]), platformVX, frameTime));
+        x[i] = static_cast<float>(Physics::advance(Scalar(x[i]), Scalar(vx[i]), frameTime));
+        y[i] = static_cast<float>(Physics::advance(Scalar(y[i]), Scalar(vy[i]), frameTime));
+    }
+}
+
+// The wall bounces and paddle clamp at the top of CollisionSystem::update.
+void VectorEnv::collideWalls()
+{
+    const float radius = settings.ballRadius;
+    const float width = settings.windowWidth;
+    const float platformWidth = settings.paddleWidth;
+    float* __restrict x = ballX.data();
+    float* __restrict y = ballY.data();
+    float* __restrict vx = ballVX.data();
+    float* __restrict vy = ballVY.data();
+    float* __restrict platformX = paddleX.data();
+
+    std::size_t i = 0;
+#ifdef VECTOR_ENV_SSE2
+    const __m128 r = _mm_set1_ps(radius);
+    const __m128 w = _mm_set1_ps(width);
+    const __m128 rightLimit = _mm_set1_ps(width - radius);
+    const __m128 platformW = _mm_set1_ps(platformWidth);
+    const __m128 platformLimit = _mm_set1_ps(width - platformWidth);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 positionX = _mm_loadu_ps(x + i);
+        __m128 velocityX = _mm_loadu_ps(vx + i);
+        const __m128 left = _mm_cmplt_ps(_mm_sub_ps(positionX, r), zero);
+        positionX = select(left, r, positionX);
+        velocityX = _mm_xor_ps(velocityX, _mm_and_ps(left, sign));
+        const __m128 right = _mm_cmpgt_ps(_mm_add_ps(positionX, r), w);
+        _mm_storeu_ps(x + i, select(right, rightLimit, positionX));
+        _mm_storeu_ps(vx + i, _mm_xor_ps(velocityX, _mm_and_ps(right, sign)));
+
+        const __m128 positionY = _mm_loadu_ps(y + i);
+        const __m128 top = _mm_cmplt_ps(_mm_sub_ps(positionY, r), zero);
+        _mm_storeu_ps(y + i, select(top, r, positionY));
+        _mm_storeu_ps(vy + i, _mm_xor_ps(_mm_loadu_ps(vy + i), _mm_and_ps(top, sign)));
+
+        __m128 platformPositionX = _mm_loadu_ps(platformX + i);
+        platformPositionX = select(_mm_cmplt_ps(platformPositionX, zero), zero, platformPositionX);
+        platformPositionX =
+            select(_mm_cmpgt_ps(_mm_add_ps(platformPositionX, platformW), w), platformLimit, platformPositionX);
+        _mm_storeu_ps(platformX + i, platformPositionX);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        Scalar positionX(x[i]);
+        Scalar positionY(y[i]);
+        Scalar velocityX(vx[i]);
+        Scalar velocityY(vy[i]);
+        Physics::bounceOffWalls(positionX, positionY, velocityX, velocityY, Scalar(radius), Scalar(width));
+        x[i] = static_cast<float>(positionX);
+        y[i] = static_cast<float>(positionY);
+        vx[i] = static_cast<float>(velocityX);
+        vy[i] = static_cast<float>(velocityY);
+        platformX[i] =
+            static_cast<float>(Physics::clampPaddle(Scalar(platformX[i]), Scalar(platformWidth), Scalar(width)));
+    }
+}
+
+// CollisionSystem's paddle bounce. The vector path works out the bounce for
+// every game and keeps it where the ball is on the paddle.
+void VectorEnv::collidePaddle()
+{
+    const float radius = settings.ballRadius;
+    const float platformY = settings.paddleStartY;
+    const float platformWidth = settings.paddleWidth;
+    const float platformHeight = settings.paddleHeight;
+    const float* __restrict x = ballX.data();
+    float* __restrict y = ballY.data();
+    float* __restrict vx = ballVX.data();
+    float* __restrict vy = ballVY.data();
+    const float* __restrict speed = ballSpeed.data();
+    const float* __restrict platformX = paddleX.data();
+    std::uint32_t* __restrict bounceCount = bounces.data();
+
+    std::size_t i = 0;
+#ifdef VECTOR_ENV_SSE2
+    const __m128 r = _mm_set1_ps(radius);
+    const __m128 top = _mm_set1_ps(platformY);
+    const __m128 bottom = _mm_set1_ps(platformY + platformHeight);
+    const __m128 platformW = _mm_set1_ps(platformWidth);
+    const __m128 halfWidth = _mm_set1_ps(platformWidth / 2.0f);
+    const __m128 landing = _mm_set1_ps(platformY - radius);
+    const __m128 hasWidth = platformWidth > 0.0f ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps();
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 positionX = _mm_loadu_ps(x + i);
+        const __m128 positionY = _mm_loadu_ps(y + i);
+        const __m128 velocityX = _mm_loadu_ps(vx + i);
+        const __m128 velocityY = _mm_loadu_ps(vy + i);
+        const __m128 ballSpeedV = _mm_loadu_ps(speed + i);
+        const __m128 platformPositionX = _mm_loadu_ps(platformX + i);
+
+        __m128 colliding = _mm_cmpgt_ps(_mm_add_ps(positionX, r), platformPositionX);
+        colliding = _mm_and_ps(colliding, _mm_cmplt_ps(_mm_sub_ps(positionX, r),
+                                                       _mm_add_ps(platformPositionX, platformW)));
+        colliding = _mm_and_ps(colliding, _mm_cmpgt_ps(_mm_add_ps(positionY, r), top));
+        colliding = _mm_and_ps(colliding, _mm_cmplt_ps(_mm_sub_ps(positionY, r), bottom));
+        colliding = _mm_and_ps(colliding, _mm_cmpgt_ps(velocityY, zero));
+
+        const __m128 platformCenterX = _mm_add_ps(platformPositionX, halfWidth);
+        const __m128 relativeIntersectX = _mm_div_ps(_mm_sub_ps(positionX, platformCenterX), halfWidth);
+        __m128 bounceX = _mm_and_ps(hasWidth, _mm_mul_ps(_mm_mul_ps(relativeIntersectX, ballSpeedV), half));
+        __m128 bounceY = _mm_or_ps(velocityY, sign);
+        const __m128 currentSpeed =
+            _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(bounceX, bounceX), _mm_mul_ps(bounceY, bounceY)));
+        const __m128 scale = select(_mm_cmpgt_ps(currentSpeed, zero), _mm_div_ps(ballSpeedV, currentSpeed), one);
+        bounceX = _mm_mul_ps(bounceX, scale);
+        bounceY = _mm_mul_ps(bounceY, scale);
+
+        _mm_storeu_ps(vx + i, select(colliding, bounceX, velocityX));
+        _mm_storeu_ps(vy + i, select(colliding, bounceY, velocityY));
+        _mm_storeu_ps(y + i, select(colliding, landing, positionY));
+        // The mask is -1 where the ball bounced.
+        __m128i* bounceLanes = reinterpret_cast<__m128i*>(bounceCount + i);
+        _mm_storeu_si128(bounceLanes, _mm_sub_epi32(_mm_loadu_si128(bounceLanes), _mm_castps_si128(colliding)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        Scalar positionY(y[i]);
+        Scalar velocityX(vx[i]);
+        Scalar velocityY(vy[i]);
+        if (!Physics::bounceOffPaddle(Scalar(x[i]), positionY, velocityX, velocityY, Scalar(radius),
+                                      Scalar(speed[i]), Scalar(platformX[i]), Scalar(platformY),
+                                      Scalar(platformWidth), Scalar(platformHeight)))
+        {
+            continue;
+        }
+        y[i] = static_cast<float>(positionY);
+        vx[i] = static_cast<float>(velocityX);
+        vy[i] = static_cast<float>(velocityY);
+        bounceCount[i]++;
+    }
+}
+
+// The ball's brick hits in CollisionSystem::update, in entity order, which
+// is brick order here.
+void VectorEnv::collideBricks(std::size_t i)
+{
+    const float radius = settings.ballRadius;
+    const float minX = ballX[i] - radius;
+    const float minY = ballY[i] - radius;
+    const float maxX = ballX[i] + radius;
+    const float maxY = ballY[i] + radius;
+    if (!(fieldRight > minX && fieldLeft < maxX && fieldBottom > minY && fieldTop < maxY)) return;
+
+    const std::int32_t* instanceHits = hits.data() + i * brickCount;
+    ballHits.clear();
+    forEachCandidate(minX, minY, maxX, maxY, [&](std::uint32_t brick) {
+        if (instanceHits[brick] != DESTROYED && brickRight[brick] > minX && brickLeft[brick] < maxX &&
+            brickBottom[brick] > minY && brickTop[brick] < maxY)
+        {
+            ballHits.push_back(brick);
+        }
+    });
+    if (ballHits.empty()) return;
+    std::sort(ballHits.begin(), ballHits.end());
+
+    // The first brick decides the bounce.
+    const std::uint32_t first = ballHits.front();
+    Scalar positionX(ballX[i]);
+    Scalar positionY(ballY[i]);
+    Scalar velocityX(ballVX[i]);
+    Scalar velocityY(ballVY[i]);
+    Physics::bounceOffBrick(positionX, positionY, velocityX, velocityY, Scalar(radius), Scalar(brickLeft[first]),
+                            Scalar(brickTop[first]), Scalar(brickRight[first]), Scalar(brickBottom[first]));
+    ballX[i] = static_cast<float>(positionX);
+    ballY[i] = static_cast<float>(positionY);
+    ballVX[i] = static_cast<float>(velocityX);
+    ballVY[i] = static_cast<float>(velocityY);
+
+    // CollisionSystem::hitBrick: each hit settles its whole blast chain
+    // before the next. Which blast reaches a brick first does not change
+    // what the chain destroys, so targets are visited in brick order.
+    // Bricks after the first are hit only if the ball still overlaps them
+    // where the bounce left it.
+    for (std::uint32_t brick : ballHits)
+    {
+        if (brick != first &&
+            !(ballX[i] + radius > brickLeft[brick] && ballX[i] - radius < brickRight[brick] &&
+              ballY[i] + radius > brickTop[brick] && ballY[i] - radius < brickBottom[brick]))
+        {
+            continue;
+        }
+        damageBrick(i, brick);
+        for (std::size_t next = 0; next < blasts.size(); ++next)
+        {
+            const std::uint32_t source = blasts[next];
+            for (std::uint32_t t = blastStart[source]; t < blastStart[source + 1]; ++t)
+            {
+                damageBrick(i, blastTargets[t]);
+            }
+        }
+        blasts.clear();
+    }
+}
+
+// CollisionSystem::damageBrick without the particles, bonuses and journal.
+void VectorEnv::damageBrick(std::size_t i, std::uint32_t brick)
+{
+    std::int32_t& brickHits = hits[i * brickCount + brick];
+    if (brickHits == DESTROYED) return;
+
+    const std::int32_t brickMaxHits = maxHits[i * brickCount + brick];
+    if (brickHits < brickMaxHits) brickHits++;
+    if (brickHits < brickMaxHits) return;
+
+    gained[i] += brickMaxHits * 10;
+    brickHits = DESTROYED;
+    bricksLeft[i]--;
+    if (explosive[brick]) blasts.push_back(brick);
+}
+
+// TimerWheel::advanceSeconds and BallSpeedSystem::increaseSpeed. The timer
+// fires on the tick it is due, so the next one is due an interval later
+// however far this frame overshot it.
+void VectorEnv::advanceTimers()
+{
+    if (settings.frameTime <= 0.0f) return;
+
+    const double frameTicks = static_cast<double>(settings.frameTime) * settings.ticksPerSecond;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        tickCarry[i] += frameTicks;
+        const double whole = std::floor(tickCarry[i]);
+        tickCarry[i] -= whole;
+        ticks[i] += static_cast<std::uint64_t>(whole);
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        while (ticks[i] >= nextIncrease[i])
+        {
+            Scalar multiplier(speedMultiplier[i]);
+            if (!Physics::increaseMultiplier(multiplier, Scalar(settings.speedIncreaseMultiplier),
+                                             Scalar(settings.maxSpeedMultiplier)))
+            {
+                nextIncrease[i] = NEVER;
+                break;
+            }
+            speedMultiplier[i] = static_cast<float>(multiplier);
+            nextIncrease[i] += increaseTicks;
+
+            // StatModifiers sets the new speed on the ball's VelocityComponent.
+            ballSpeed[i] = static_cast<float>(ballSpeed0 * multiplier);
+            Scalar velocityX(ballVX[i]);
+            Scalar velocityY(ballVY[i]);
+            Physics::setSpeed(velocityX, velocityY, Scalar(ballSpeed[i]));
+            ballVX[i] = static_cast<float>(velocityX);
+            ballVY[i] = static_cast<float>(velocityY);
+        }
+    }
+}
+
+void VectorEnv::observe(std::size_t i, std::span<float> observations) const
+{
+    float* observation = observations.data() + i * OBSERVATION_SIZE;
+    observation[0] = ballX[i];
+    observation[1] = ballY[i];
+    observation[2] = ballVX[i];
+    observation[3] = ballVY[i];
+    observation[4] = paddleX[i];
+    observation[5] = speedMultiplier[i];
+    observation[6] = brickCount ? static_cast<float>(bricksLeft[i]) / static_cast<float>(brickCount) : 0.0f;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "../LevelLoader.h"
+#include "../Physics.h"
+#include "../Random.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Rules the environment plays by; the defaults are GameState's.
+struct EnvSettings
+{
+    float windowWidth = 800.0f;
+    float windowHeight = 600.0f;
+    float paddleStartX = 350.0f;
+    float paddleStartY = 550.0f;
+    float paddleWidth = 100.0f;
+    float paddleHeight = 20.0f;
+    float paddleSpeed = 400.0f;
+    float ballStartX = 400.0f;
+    float ballStartY = 400.0f;
+    float ballRadius = 10.0f;
+    float ballVelocityX = 200.0f;
+    float ballVelocityY = -200.0f;
+    float speedIncreaseInterval = 10.0f;
+    float speedIncreaseMultiplier = 1.2f;
+    float maxSpeedMultiplier = 3.0f;
+    float explosionRadius = 50.0f;
+    std::uint32_t ticksPerSecond = 1000;
+    // Game time covered by one step.
+    float frameTime = 1.0f / 60.0f;
+};
+
+// Many independent games of one level stepped in lockstep, for training and
+// evaluating paddle policies without a window or an ECS. Each step runs the
+// frame the game runs: MovementSystem, then CollisionSystem (walls, paddle,
+// bricks and explosive chains), then BallSpeedSystem's timer, with the same
+// float expressions in the same order, so an instance replays a game seeded
+// with the instance's seed bit for bit. Bonuses and lasers are not
+// simulated: a bonus brick is a plain brick here.
+//
+// Ball and paddle state is stored one array per field across instances, so
+// movement, walls and the paddle run four games per SSE2 instruction where
+// available in float builds; with ARCANOID_FIXED_POINT every instance runs
+// the game's fixed-point physics. Only games whose ball is inside the brick
+// field look up bricks, in a bucket grid of the level shared by every
+// instance.
+//
+// An episode ends when the ball falls out or no bricks are left; that
+// instance is reset within the same step, so the observation returned
+// alongside done = 1 is the first of its next episode. With auto reset off
+// a finished instance keeps playing its lost or cleared game instead.
+//
+// An instance's game can be saved to and loaded from getStateSize() bytes
+// (a few hundred for a screen-sized level), so searches can clone games
+// cheaply and play them out in any instance.
+class VectorEnv
+{
+public:
+    // Per instance: ball x, y, velocity x, y, paddle x, ball speed
+    // multiplier, fraction of bricks left.
+    static constexpr std::size_t OBSERVATION_SIZE = 7;
+
+    VectorEnv(const LevelData& level, std::size_t count, const EnvSettings& settings = {});
+
+    // Starts every instance on its first episode. Instance i plays the
+    // layout a game seeded with seed + i deals, and episode n of it the
+    // game's n-th layout, so random hit points match.
+    void reset(std::uint64_t seed, std::span<float> observations);
+    // Actions are -1 (left), 0 or 1 (right) per instance; rewards are the
+    // score gained during the step.
+    void step(std::span<const std::int8_t> actions, std::span<float> observations, std::span<float> rewards,
+              std::span<std::uint8_t> dones);
+
+    void setAutoReset(bool enabled) { autoReset = enabled; }
+
+    std::size_t getStateSize() const { return sizeof(InstanceState) + 2 * brickCount * sizeof(std::int32_t); }
+    // The game in `instance`: ball, paddle, speed timer, bricks, episode and
+    // bounce count. Loading keeps the instance's seed for later episodes.
+    void saveState(std::size_t instance, std::span<std::byte> state) const;
+    void loadState(std::size_t instance, std::span<const std::byte> state);
+    // Writes the instance's current observation into its slot.
+    void observe(std::size_t instance, std::span<float> observations) const;
+
+    std::size_t size() const { return count; }
+    std::size_t getBrickCount() const { return brickCount; }
+    std::uint32_t getEpisode(std::size_t instance) const { return episodes[instance]; }
+    std::uint32_t getBricksLeft(std::size_t instance) const { return bricksLeft[instance]; }
+    // Paddle bounces this episode.
+    std::uint32_t getBounces(std::size_t instance) const { return bounces[instance]; }
+    const EnvSettings& getSettings() const { return settings; }
+
+private:
+    static constexpr std::uint64_t NEVER = UINT64_MAX;
+    static constexpr std::int32_t DESTROYED = -1;
+
+    // Per-instance fields of a saved state; hits and maxHits follow.
+    struct InstanceState
+    {
+        float ballX;
+        float ballY;
+        float ballVX;
+        float ballVY;
+        float ballSpeed;
+        float paddleX;
+        float speedMultiplier;
+        std::uint32_t bricksLeft;
+        std::uint32_t episode;
+        std::uint32_t bounces;
+        std::uint64_t ticks;
+        double tickCarry;
+        std::uint64_t nextIncrease;
+    };
+
+    void buildLayout(const LevelData& level);
+    void resetInstance(std::size_t instance);
+    void move(std::span<const std::int8_t> actions);
+    void collideWalls();
+    void collidePaddle();
+    void collideBricks(std::size_t instance);
+    void damageBrick(std::size_t instance, std::uint32_t brick);
+    void advanceTimers();
+    // Calls fn(brick) for every brick in the buckets that can hold a brick
+    // overlapping the box; each brick at most once, in brick order per bucket.
+    template<typename Fn>
+    void forEachCandidate(float minX, float minY, float maxX, float maxY, Fn&& fn) const;
+
+    EnvSettings settings;
+    std::size_t count;
+    bool autoReset = true;
+    Scalar ballSpeed0;
+    std::uint64_t increaseTicks;
+
+    // Level, shared by every instance. Bricks are in level cell order,
+    // which is the order the game creates their entities in.
+    std::size_t brickCount = 0;
+    std::int32_t minHitPoints = 1;
+    std::int32_t maxHitPoints = 1;
+    std::vector<float> brickLeft;
+    std::vector<float> brickTop;
+    std::vector<float> brickRight;
+    std::vector<float> brickBottom;
+    std::vector<std::uint8_t> cellHitPoints;
+    std::vector<std::uint8_t> explosive;
+    // Bricks in each blast's radius, by explosive brick.
+    std::vector<std::uint32_t> blastStart;
+    std::vector<std::uint32_t> blastTargets;
+    // Bricks by level column and row; a step of 0 puts every brick in one
+    // bucket along that axis.
+    float originX = 0.0f;
+    float originY = 0.0f;
+    float stepX = 0.0f;
+    float stepY = 0.0f;
+    float brickWidth = 0.0f;
+    float brickHeight = 0.0f;
+    int columns = 0;
+    int rows = 0;
+    std::vector<std::uint32_t> bucketStart;
+    std::vector<std::uint32_t> bucketBricks;
+    float fieldLeft = 0.0f;
+    float fieldTop = 0.0f;
+    float fieldRight = 0.0f;
+    float fieldBottom = 0.0f;
+
+    // Per instance.
+    std::vector<float> ballX;
+    std::vector<float> ballY;
+    std::vector<float> ballVX;
+    std::vector<float> ballVY;
+    std::vector<float> ballSpeed;
+    std::vector<float> paddleX;
+    std::vector<float> speedMultiplier;
+    std::vector<std::uint64_t> ticks;
+    std::vector<double> tickCarry;
+    std::vector<std::uint64_t> nextIncrease;
+    std::vector<std::uint32_t> bricksLeft;
+    // Score gained in the current step.
+    std::vector<std::int32_t> gained;
+    std::vector<std::uint32_t> episodes;
+    std::vector<std::uint32_t> bounces;
+    std::vector<RandomStream> layouts;
+
+    // Per instance and brick, instance-major: DurableBrick's counters, with
+    // hits set to DESTROYED once the brick is gone.
+    std::vector<std::int32_t> hits;
+    std::vector<std::int32_t> maxHits;
+
+    std::vector<std::uint32_t> ballHits;
+    std::vector<std::uint32_t> blasts;
+};
@@ -0,0 +1,61 @@
+#include "TaskWorker.h"
+
+TaskWorker::~TaskWorker()
+{
+    stop();
+}
+
+void TaskWorker::start()
+{
+    if (thread.joinable()) return;
+
+    stopping = false;
+    thread = std::thread(&TaskWorker::run, this);
+}
+
+void TaskWorker::stop()
+{
+    if (!thread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    thread.join();
+}
+
+void TaskWorker::post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    wakeUp.notify_one();
+}
+
+bool TaskWorker::isIdle() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return tasks.empty() && !working;
+}
+
+void TaskWorker::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wakeUp.wait(lock, [this] { return !tasks.empty() || stopping; });
+        if (tasks.empty()) break;
+
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        working = true;
+        lock.unlock();
+
+        task();
+
+        lock.lock();
+        working = false;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Runs tasks on a background thread, one at a time in submission order.
+// Used for save I/O (checkpoints, journal appends, compaction) and resource
+// loading so that disk latency never lands in a frame.
+class TaskWorker
+{
+public:
+    TaskWorker() = default;
+    ~TaskWorker();
+
+    TaskWorker(const TaskWorker&) = delete;
+    TaskWorker& operator=(const TaskWorker&) = delete;
+
+    void start();
+    // Finishes all queued tasks before returning.
+    void stop();
+
+    void post(std::function<void()> task);
+    bool isIdle() const;
+
+private:
+    void run();
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::deque<std::function<void()>> tasks;
+    bool working = false;
+    bool stopping = false;
+    std::thread thread;
+};
@@ -0,0 +1,192 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+TimerWheel::TimerWheel(std::uint32_t ticksPerSecond)
+    : ticksPerSecond(ticksPerSecond)
+{
+    heads.fill(NONE);
+}
+
+const TimerWheel::Timer* TimerWheel::find(TimerHandle handle) const
+{
+    if (handle.index >= timers.size()) return nullptr;
+    const Timer& timer = timers[handle.index];
+    return timer.pending && timer.generation == handle.generation ? &timer : nullptr;
+}
+
+TimerHandle TimerWheel::schedule(Tick delay, Callback callback)
+{
+    std::uint32_t index;
+    if (!freeTimers.empty())
+    {
+        index = freeTimers.back();
+        freeTimers.pop_back();
+    }
+    else
+    {
+        index = static_cast<std::uint32_t>(timers.size());
+        timers.emplace_back();
+    }
+
+    Timer& timer = timers[index];
+    timer.expiry = currentTick + std::clamp<Tick>(delay, 1, MAX_DELAY);
+    timer.callback = std::move(callback);
+    timer.pending = true;
+    link(index);
+    pendingCount++;
+    return {index, timer.generation};
+}
+
+bool TimerWheel::cancel(TimerHandle handle)
+{
+    if (!find(handle)) return false;
+    unlink(handle.index);
+    release(handle.index);
+    return true;
+}
+
+bool TimerWheel::reschedule(TimerHandle handle, Tick delay)
+{
+    if (!find(handle)) return false;
+    unlink(handle.index);
+    timers[handle.index].expiry = currentTick + std::clamp<Tick>(delay, 1, MAX_DELAY);
+    link(handle.index);
+    return true;
+}
+
+bool TimerWheel::isPending(TimerHandle handle) const
+{
+    return find(handle) != nullptr;
+}
+
+TimerWheel::Tick TimerWheel::remaining(TimerHandle handle) const
+{
+    const Timer* timer = find(handle);
+    return timer ? timer->expiry - currentTick : 0;
+}
+
+// A timer goes to the lowest level whose span covers its delay, in the slot
+// its expiry falls into at that level's resolution.
+void TimerWheel::link(std::uint32_t index)
+{
+    Timer& timer = timers[index];
+    const Tick delta = timer.expiry - currentTick;
+    unsigned int level = 0;
+    while (level + 1 < LEVELS && delta >= (Tick(1) << ((level + 1) * SLOT_BITS)))
+    {
+        level++;
+    }
+    const std::uint32_t slot = static_cast<std::uint32_t>((timer.expiry >> (level * SLOT_BITS)) & (SLOTS - 1));
+
+    timer.slot = level * SLOTS + slot;
+    timer.prev = NONE;
+    timer.next = heads[timer.slot];
+    if (timer.next != NONE) timers[timer.next].prev = index;
+    heads[timer.slot] = index;
+    occupied[level] |= std::uint64_t(1) << slot;
+}
+
+void TimerWheel::unlink(std::uint32_t index)
+{
+    Timer& timer = timers[index];
+    if (timer.prev != NONE)
+    {
+        timers[timer.prev].next = timer.next;
+    }
+    else
+    {
+        heads[timer.slot] = timer.next;
+        if (timer.next == NONE) occupied[timer.slot / SLOTS] &= ~(std::uint64_t(1) << (timer.slot % SLOTS));
+    }
+    if (timer.next != NONE) timers[timer.next].prev = timer.prev;
+}
+
+void TimerWheel::release(std::uint32_t index)
+{
+    Timer& timer = timers[index];
+    timer.callback = nullptr;
+    timer.pending = false;
+    timer.generation++;
+    freeTimers.push_back(index);
+    pendingCount--;
+}
+
+// Called when every level below `level` has wrapped around; the current slot
+// of `level` holds the timers due within the next turn of the level below.
+void TimerWheel::cascade(unsigned int level)
+{
+    const std::uint32_t slot =
+        level * SLOTS + static_cast<std::uint32_t>((currentTick >> (level * SLOT_BITS)) & (SLOTS - 1));
+    std::uint32_t index = heads[slot];
+    heads[slot] = NONE;
+    occupied[level] &= ~(std::uint64_t(1) << (slot % SLOTS));
+    while (index != NONE)
+    {
+        const std::uint32_t next = timers[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+// Timers scheduled by the callbacks are at least one tick out, so they never
+// land in the slot being fired.
+void TimerWheel::fire(std::uint32_t slot)
+{
+    while (heads[slot] != NONE)
+    {
+        const std::uint32_t index = heads[slot];
+        unlink(index);
+        Callback callback = std::move(timers[index].callback);
+        release(index);
+        callback();
+    }
+}
+
+void TimerWheel::advance(Tick ticks)
+{
+    const Tick target = currentTick + ticks;
+    while (currentTick < target)
+    {
+        // Next occupied level-0 slot in this turn, else the end of the turn.
+        const unsigned int position = static_cast<unsigned int>(currentTick & (SLOTS - 1));
+        const std::uint64_t ahead = position + 1 < SLOTS ? occupied[0] & (~std::uint64_t(0) << (position + 1)) : 0;
+        const Tick step = ahead ? static_cast<Tick>(std::countr_zero(ahead)) - position : SLOTS - position;
+        if (target - currentTick < step)
+        {
+            currentTick = target;
+            break;
+        }
+        currentTick += step;
+
+        if ((currentTick & (SLOTS - 1)) == 0)
+        {
+            for (unsigned int level = LEVELS - 1; level > 0; --level)
+            {
+                if ((currentTick & ((Tick(1) << (level * SLOT_BITS)) - 1)) == 0) cascade(level);
+            }
+        }
+        fire(static_cast<std::uint32_t>(currentTick & (SLOTS - 1)));
+    }
+}
+
+void TimerWheel::advanceSeconds(float seconds)
+{
+    if (seconds <= 0.0f) return;
+    carry += static_cast<double>(seconds) * ticksPerSecond;
+    const double whole = std::floor(carry);
+    carry -= whole;
+    advance(static_cast<Tick>(whole));
+}
+
+TimerWheel::Tick TimerWheel::toTicks(float seconds) const
+{
+    if (seconds <= 0.0f) return 0;
+    return static_cast<Tick>(std::llround(static_cast<double>(seconds) * ticksPerSecond));
+}
+
+float TimerWheel::toSeconds(Tick ticks) const
+{
+    return static_cast<float>(static_cast<double>(ticks) / ticksPerSecond);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Refers to one scheduled timer. Once the timer fires or is cancelled the
+// handle goes stale, and every TimerWheel call ignores it.
+struct TimerHandle
+{
+    std::uint32_t index = UINT32_MAX;
+    std::uint32_t generation = 0;
+
+    bool operator==(const TimerHandle&) const = default;
+};
+
+// Hierarchical timer wheel counting game-time ticks. Level 0 has one slot
+// per tick for the next 64 ticks; each level above has 64 slots, each 64
+// times coarser, and a slot's timers move down a level when the level below
+// wraps around to it. A bitmap of occupied slots lets advance() jump
+// straight to the next due slot. So a frame costs the timers that fire or
+// cascade plus one step per 64 ticks, however many timers are pending.
+class TimerWheel
+{
+public:
+    using Tick = std::uint64_t;
+    using Callback = std::function<void()>;
+
+    static constexpr unsigned int LEVELS = 5;
+    static constexpr unsigned int SLOT_BITS = 6;
+    static constexpr unsigned int SLOTS = 1u << SLOT_BITS;
+    // Longer delays are clamped to this.
+    static constexpr Tick MAX_DELAY = (Tick(1) << (LEVELS * SLOT_BITS)) - 1;
+
+    explicit TimerWheel(std::uint32_t ticksPerSecond = 1000);
+
+    // Runs `callback` from advance() once `delay` ticks have passed; a delay
+    // of 0 counts as 1. Callbacks may schedule, cancel and reschedule.
+    TimerHandle schedule(Tick delay, Callback callback);
+    // False if the timer has already fired or been cancelled.
+    bool cancel(TimerHandle handle);
+    // Moves a pending timer to fire `delay` ticks from now.
+    bool reschedule(TimerHandle handle, Tick delay);
+    bool isPending(TimerHandle handle) const;
+    // Ticks until a pending timer fires; 0 for a stale handle.
+    Tick remaining(TimerHandle handle) const;
+
+    void advance(Tick ticks);
+    // Advances by game time; fractions of a tick carry over to the next call.
+    void advanceSeconds(float seconds);
+
+    Tick now() const { return currentTick; }
+    std::size_t size() const { return pendingCount; }
+    Tick toTicks(float seconds) const;
+    float toSeconds(Tick ticks) const;
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Timer
+    {
+        Tick expiry = 0;
+        Callback callback;
+        std::uint32_t generation = 0;
+        std::uint32_t prev = NONE;
+        std::uint32_t next = NONE;
+        // level * SLOTS + slot
+        std::uint32_t slot = 0;
+        bool pending = false;
+    };
+
+    const Timer* find(TimerHandle handle) const;
+    void link(std::uint32_t index);
+    void unlink(std::uint32_t index);
+    void release(std::uint32_t index);
+    void cascade(unsigned int level);
+    void fire(std::uint32_t slot);
+
+    std::vector<Timer> timers;
+    std::vector<std::uint32_t> freeTimers;
+    std::array<std::uint32_t, LEVELS * SLOTS> heads;
+    std::array<std::uint64_t, LEVELS> occupied{};
+    Tick currentTick = 0;
+    double carry = 0.0;
+    std::uint32_t ticksPerSecond;
+    std::size_t pendingCount = 0;
+};
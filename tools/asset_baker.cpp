@@ -0,0 +1,169 @@
+// Build step: compresses fonts and levels into a C++ source file of constexpr
+// byte arrays plus the tables read by src/BakedAssets.h. Levels are parsed
+// here, so a broken level fails the build instead of the game.
+//
+// usage: arcanoid-asset-baker <output.cpp> --fonts <file>... --levels <level<n>.txt>...
+
+#include "../src/Checksum.h"
+#include "../src/Compression.h"
+#include "../src/LevelFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Asset
+{
+    std::string symbol;
+    std::string name;
+    std::vector<std::byte> data;
+    int levelNumber = 0;
+    std::uint32_t brickCount = 0;
+};
+
+bool readFile(const std::string& filename, std::vector<std::byte>& data)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    data.resize(bytes.size());
+    std::memcpy(data.data(), bytes.data(), bytes.size());
+    return true;
+}
+
+// Re-encodes the level in the binary form.
+bool bakeLevel(const std::string& filename, Asset& asset)
+{
+    const std::string stem = std::filesystem::path(filename).stem().string();
+    if (stem.rfind("level", 0) != 0 || std::sscanf(stem.c_str() + 5, "%d", &asset.levelNumber) != 1)
+    {
+        std::cerr << filename << ": level files must be named level<n>" << std::endl;
+        return false;
+    }
+
+    LevelReader reader;
+    if (!reader.open(filename)) return false;
+
+    std::ostringstream image(std::ios::binary);
+    LevelWriter writer;
+    writer.open(image, reader.getSettings());
+    std::vector<LevelCell> cells(4096);
+    while (std::size_t count = reader.read(cells))
+    {
+        writer.write(std::span<const LevelCell>(cells.data(), count));
+        asset.brickCount += static_cast<std::uint32_t>(count);
+    }
+    if (reader.failed() || !writer.close()) return false;
+
+    const std::string bytes = image.str();
+    asset.data.resize(bytes.size());
+    std::memcpy(asset.data.data(), bytes.data(), bytes.size());
+    return true;
+}
+
+void writeArray(std::ostream& out, const Asset& asset, const std::vector<std::byte>& compressed)
+{
+    out << "constexpr std::uint8_t " << asset.symbol << "[] = {";
+    for (std::size_t i = 0; i < compressed.size(); ++i)
+    {
+        if (i % 16 == 0) out << "\n   ";
+        char hex[8];
+        std::snprintf(hex, sizeof(hex), " 0x%02x,", static_cast<unsigned>(compressed[i]));
+        out << hex;
+    }
+    out << "\n};\n\n";
+}
+
+std::string describe(const Asset& asset, const std::vector<std::byte>& compressed)
+{
+    std::ostringstream out;
+    out << "{\"" << asset.name << "\", " << asset.symbol << ", " << compressed.size() << ", " << asset.data.size()
+        << ", 0x" << std::hex << crc32(asset.data.data(), asset.data.size()) << "u}";
+    return out.str();
+}
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: arcanoid-asset-baker <output.cpp> --fonts <file>... --levels <file>..." << std::endl;
+        return 2;
+    }
+
+    std::vector<Asset> fonts;
+    std::vector<Asset> levels;
+    std::vector<Asset>* section = nullptr;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--fonts") section = &fonts;
+        else if (arg == "--levels") section = &levels;
+        else if (!section)
+        {
+            std::cerr << "expected --fonts or --levels before " << arg << std::endl;
+            return 2;
+        }
+        else
+        {
+            Asset& asset = section->emplace_back();
+            asset.name = std::filesystem::path(arg).filename().string();
+            const bool ok = section == &levels ? bakeLevel(arg, asset) : readFile(arg, asset.data);
+            if (!ok)
+            {
+                std::cerr << "Cannot bake " << arg << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::sort(levels.begin(), levels.end(),
+              [](const Asset& a, const Asset& b) { return a.levelNumber < b.levelNumber; });
+    for (std::size_t i = 0; i < fonts.size(); ++i) fonts[i].symbol = "font" + std::to_string(i);
+    for (Asset& level : levels) level.symbol = "level" + std::to_string(level.levelNumber);
+
+    std::ostringstream out;
+    out << "// Generated by arcanoid-asset-baker. Do not edit.\n\n"
+        << "#include \"BakedAssets.h\"\n\nnamespace\n{\n";
+
+    std::vector<std::string> fontEntries;
+    std::vector<std::string> levelEntries;
+    for (const Asset& font : fonts)
+    {
+        const auto compressed = lzCompress(font.data);
+        writeArray(out, font, compressed);
+        fontEntries.push_back(describe(font, compressed));
+    }
+    for (const Asset& level : levels)
+    {
+        const auto compressed = lzCompress(level.data);
+        writeArray(out, level, compressed);
+        levelEntries.push_back("{" + std::to_string(level.levelNumber) + ", " + std::to_string(level.brickCount) +
+                               ", " + describe(level, compressed) + "}");
+    }
+
+    out << "constexpr BakedAsset FONTS[] = {\n";
+    for (const std::string& entry : fontEntries) out << "    " << entry << ",\n";
+    out << "};\n\nconstexpr BakedLevel LEVELS[] = {\n";
+    for (const std::string& entry : levelEntries) out << "    " << entry << ",\n";
+    out << "};\n\nstatic_assert(isValidLevelTable(LEVELS), \"levels must be numbered 1..n and not be empty\");\n}\n\n"
+        << "std::span<const BakedAsset> BakedAssets::fonts() { return FONTS; }\n"
+        << "std::span<const BakedLevel> BakedAssets::levels() { return LEVELS; }\n";
+
+    std::ofstream output(argv[1], std::ios::binary | std::ios::trunc);
+    if (!(output << out.str()))
+    {
+        std::cerr << "Cannot write " << argv[1] << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Steps a batch of headless games with a ball-following policy and reports
+// aggregate env-steps per second.
+//
+// usage: arcanoid-env-bench [level] [instances] [steps] [seed]
+
+#include "../src/LevelFile.h"
+#include "../src/LevelLoader.h"
+#include "../src/Sim/VectorEnv.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    const std::string filename = argc > 1 ? argv[1] : "resources/levels/level1.txt";
+    const std::size_t instances = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+    const int steps = argc > 3 ? std::atoi(argv[3]) : 2000;
+    const std::uint64_t seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1;
+
+    LevelReader reader;
+    if (!reader.open(filename)) return 1;
+    LevelData level;
+    level.settings = reader.getSettings();
+    std::vector<LevelCell> cells(LevelLoader::CHUNK_SIZE);
+    while (std::size_t count = reader.read(cells))
+    {
+        level.cells.insert(level.cells.end(), cells.begin(), cells.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+    if (reader.failed()) return 1;
+
+    VectorEnv env(level, instances);
+    std::vector<float> observations(instances * VectorEnv::OBSERVATION_SIZE);
+    std::vector<float> rewards(instances);
+    std::vector<std::uint8_t> dones(instances);
+    std::vector<std::int8_t> actions(instances);
+    env.reset(seed, observations);
+
+    const float halfPaddle = env.getSettings().paddleWidth / 2.0f;
+    double policySeconds = 0.0;
+    double stepSeconds = 0.0;
+    double returns = 0.0;
+    std::size_t episodes = 0;
+
+    for (int step = 0; step < steps; ++step)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < instances; ++i)
+        {
+            const float* observation = observations.data() + i * VectorEnv::OBSERVATION_SIZE;
+            const float offset = observation[0] - (observation[4] + halfPaddle);
+            actions[i] = offset < -4.0f ? -1 : offset > 4.0f ? 1 : 0;
+        }
+        auto mid = std::chrono::steady_clock::now();
+        env.step(actions, observations, rewards, dones);
+        auto end = std::chrono::steady_clock::now();
+
+        policySeconds += std::chrono::duration<double>(mid - start).count();
+        stepSeconds += std::chrono::duration<double>(end - mid).count();
+        for (std::size_t i = 0; i < instances; ++i)
+        {
+            returns += rewards[i];
+            episodes += dones[i];
+        }
+    }
+
+    const double envSteps = static_cast<double>(instances) * steps;
+    std::cout << instances << " games x " << steps << " steps of " << level.cells.size() << " bricks" << std::endl;
+    std::cout << "step:   " << stepSeconds * 1e9 / envSteps << " ns per env-step, "
+              << envSteps / stepSeconds / 1e6 << " M env-steps/s" << std::endl;
+    std::cout << "policy: " << policySeconds * 1e9 / envSteps << " ns per env-step" << std::endl;
+    std::cout << episodes << " episodes finished, " << returns / static_cast<double>(instances)
+              << " score per game" << std::endl;
+    return 0;
+}
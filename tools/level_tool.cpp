@@ -0,0 +1,133 @@
+// Converts text levels to the binary form, generates levels and measures
+// streaming load time.
+//
+// usage: arcanoid-level-tool convert <level.txt> <level.lvl>
+//        arcanoid-level-tool generate <rows> <columns> <level.lvl> [seed [threads]]
+//        arcanoid-level-tool bench [bricks]
+
+#include "../src/ECS/ECSManager.h"
+#include "../src/LevelFile.h"
+#include "../src/LevelGenerator.h"
+#include "../src/LevelLoader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+int convert(const std::string& input, const std::string& output)
+{
+    LevelReader reader;
+    LevelWriter writer;
+    if (!reader.open(input)) return 1;
+    if (!writer.open(output, reader.getSettings()))
+    {
+        std::cerr << "Cannot write " << output << std::endl;
+        return 1;
+    }
+
+    std::vector<LevelCell> cells(LevelLoader::CHUNK_SIZE);
+    std::size_t total = 0;
+    while (std::size_t count = reader.read(cells))
+    {
+        writer.write(std::span<const LevelCell>(cells.data(), count));
+        total += count;
+    }
+    if (reader.failed() || !writer.close()) return 1;
+
+    std::cout << total << " bricks written to " << output << std::endl;
+    return 0;
+}
+
+int generate(std::uint32_t rows, std::uint32_t columns, const std::string& output, std::uint64_t seed,
+             unsigned int threads)
+{
+    LevelGeneratorParams params = LevelGenerator::paramsForLevel(1, 700.0f, 50.0f, 50.0f);
+    params.rows = rows;
+    params.columns = columns;
+    params.bonusSpacing = 4;
+
+    LevelData level;
+    const auto start = std::chrono::steady_clock::now();
+    if (!LevelGenerator::generate(params, RandomService(seed).stream("levels"), level, threads)) return 1;
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::size_t bonuses = 0;
+    for (const LevelCell& cell : level.cells)
+    {
+        if (cell.bonus != LEVEL_BONUS_NONE) bonuses++;
+    }
+    std::cout << level.cells.size() << " bricks (" << bonuses << " bonuses) generated in "
+              << elapsed.count() * 1000.0 << " ms" << std::endl;
+
+    LevelWriter writer;
+    if (!writer.open(output, level.settings) || !writer.write(level.cells) || !writer.close())
+    {
+        std::cerr << "Cannot write " << output << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int bench(std::size_t brickCount)
+{
+    const std::string filename = "level_bench.lvl";
+    LevelSettings settings = defaultLevelSettings();
+    settings.paletteSize = 5;
+    const std::uint32_t colors[] = {0xFF0000FF, 0xFFA500FF, 0xFFFF00FF, 0x00FF00FF, 0x00FFFFFF};
+    std::copy(std::begin(colors), std::end(colors), settings.palette);
+
+    LevelWriter writer;
+    if (!writer.open(filename, settings)) return 1;
+    std::vector<LevelCell> cells;
+    cells.reserve(LevelLoader::CHUNK_SIZE);
+    for (std::size_t i = 0; i < brickCount; ++i)
+    {
+        cells.push_back({static_cast<std::uint32_t>(i / 8), static_cast<std::uint16_t>(i % 8),
+                         static_cast<std::uint8_t>(i / 8 % 5), LEVEL_HIT_POINTS_RANDOM, LEVEL_BONUS_RANDOM, 0, {}});
+        if (cells.size() == LevelLoader::CHUNK_SIZE || i + 1 == brickCount)
+        {
+            writer.write(cells);
+            cells.clear();
+        }
+    }
+    if (!writer.close()) return 1;
+
+    ECSManager ecs;
+    std::vector<Entity> bricks;
+    const RandomStream layout(1);
+    LevelReader reader;
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool loaded = reader.open(filename) && LevelLoader::load(reader, ecs, bricks, layout);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::remove(filename.c_str());
+    if (!loaded) return 1;
+
+    std::cout << bricks.size() << " bricks loaded in " << elapsed.count() * 1000.0 << " ms" << std::endl;
+    return 0;
+}
+}
+
+int main(int argc, char** argv)
+{
+    const std::string command = argc > 1 ? argv[1] : "";
+    if (command == "convert" && argc == 4) return convert(argv[2], argv[3]);
+    if (command == "generate" && argc >= 5 && argc <= 7)
+    {
+        return generate(static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 10)),
+                        static_cast<std::uint32_t>(std::strtoul(argv[3], nullptr, 10)), argv[4],
+                        argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 1,
+                        argc > 6 ? static_cast<unsigned int>(std::strtoul(argv[6], nullptr, 10)) : 0);
+    }
+    if (command == "bench") return bench(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000);
+
+    std::cerr << "usage: arcanoid-level-tool convert <level.txt> <level.lvl>\n"
+                 "       arcanoid-level-tool generate <rows> <columns> <level.lvl> [seed [threads]]\n"
+                 "       arcanoid-level-tool bench [bricks]" << std::endl;
+    return 2;
+}
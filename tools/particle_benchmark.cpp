@@ -0,0 +1,50 @@
+// Keeps the particle pool full and reports the cost of one update and one
+// batched draw into a render snapshot.
+//
+// usage: arcanoid-particle-bench [particles] [frames]
+
+#include "../src/ECS/ECSManager.h"
+#include "../src/ECS/Systems/ParticleSystem.h"
+#include "../src/Render/RenderSnapshot.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    const std::size_t particles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 500;
+
+    ECSManager ecs;
+    ParticleSystem particleSystem(particles);
+    RenderSnapshot snapshot;
+
+    double updateSeconds = 0.0;
+    double renderSeconds = 0.0;
+    std::size_t liveTotal = 0;
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        while (particleSystem.getCount() < particleSystem.getCapacity())
+        {
+            particleSystem.spawnBurst(ParticleKind::Debris, {400.0f, 300.0f}, sf::Color::Yellow, 1024);
+        }
+        liveTotal += particleSystem.getCount();
+
+        auto start = std::chrono::steady_clock::now();
+        particleSystem.update(1.0f / 60.0f, ecs);
+        auto mid = std::chrono::steady_clock::now();
+        snapshot.clear(sf::Color::Black);
+        particleSystem.render(snapshot);
+        auto end = std::chrono::steady_clock::now();
+
+        updateSeconds += std::chrono::duration<double>(mid - start).count();
+        renderSeconds += std::chrono::duration<double>(end - mid).count();
+    }
+
+    std::cout << "live particles (avg): " << liveTotal / frames << "\n"
+              << "update: " << updateSeconds * 1000.0 / frames << " ms/frame\n"
+              << "batch:  " << renderSeconds * 1000.0 / frames << " ms/frame" << std::endl;
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Renders the default board through the software backend without opening a
+// window and reports frames per second. Optionally dumps the last frame.
+//
+// usage: arcanoid-render-bench [frames] [output.png|output.ppm]
+
+#include "../src/ECS/ECSManager.h"
+#include "../src/ECS/Systems/RenderSystem.h"
+#include "../src/EntityFactory.h"
+#include "../src/GameState.h"
+#include "../src/Render/SoftwareRenderBackend.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 5000;
+    const std::string output = argc > 2 ? argv[2] : "";
+
+    ECSManager ecs;
+    EntityFactory::createPlatform(ecs, GAME_STATE.PLATFORM_START_X, GAME_STATE.PLATFORM_START_Y,
+                                  GAME_STATE.PLATFORM_WIDTH, GAME_STATE.PLATFORM_HEIGHT);
+    EntityFactory::createBall(ecs, GAME_STATE.BALL_START_X, GAME_STATE.BALL_START_Y, GAME_STATE.BALL_RADIUS);
+
+    const sf::Color colors[] = {sf::Color::Red, sf::Color(255, 165, 0), sf::Color::Yellow,
+                                sf::Color::Green, sf::Color::Cyan};
+    for (int row = 0; row < 5; ++row)
+    {
+        for (int col = 0; col < 8; ++col)
+        {
+            EntityFactory::createBrick(ecs, 50.0f + col * 85.0f, 50.0f + row * 35.0f, 80.0f, 30.0f,
+                                       colors[row], 1 + (row + col) % 3, (row + col) % 4 == 0,
+                                       static_cast<BonusType>(col % 3));
+        }
+    }
+
+    SoftwareRenderBackend backend(GAME_STATE.WINDOW_WIDTH, GAME_STATE.WINDOW_HEIGHT);
+    RenderSystem renderSystem;
+    renderSystem.setBackend(&backend);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i)
+    {
+        backend.clear(sf::Color::Black);
+        renderSystem.update(0.0f, ecs);
+        backend.drawText("Score: " + std::to_string(i), {GAME_STATE.WINDOW_WIDTH - 150.0f, 10.0f}, 20,
+                         sf::Color::White);
+        backend.outlineCircle({30.0f, 30.0f}, 15.0f, 5.0f, sf::Color::Red);
+        backend.present();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << frames << " frames in " << seconds << " s (" << (frames / seconds) << " FPS)" << std::endl;
+
+    if (!output.empty())
+    {
+        const bool png = output.size() > 4 && output.compare(output.size() - 4, 4, ".png") == 0;
+        if (!(png ? backend.writePNG(output) : backend.writePPM(output)))
+        {
+            std::cerr << "Failed to write " << output << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+// Searches for the fastest clear of a level and reports it with the search
+// rate in nodes (bounce-to-bounce games) and env-steps per second.
+//
+// usage: arcanoid-solver [level] [beam] [branches] [threads] [seed]
+
+#include "../src/LevelFile.h"
+#include "../src/LevelLoader.h"
+#include "../src/Sim/BeamSolver.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    const std::string filename = argc > 1 ? argv[1] : "resources/levels/level1.txt";
+    SolverParams params;
+    if (argc > 2) params.beamWidth = std::strtoull(argv[2], nullptr, 10);
+    if (argc > 3) params.branches = static_cast<std::uint32_t>(std::strtoul(argv[3], nullptr, 10));
+    if (argc > 4) params.threads = static_cast<unsigned int>(std::strtoul(argv[4], nullptr, 10));
+    if (argc > 5) params.seed = std::strtoull(argv[5], nullptr, 10);
+
+    LevelReader reader;
+    if (!reader.open(filename)) return 1;
+    LevelData level;
+    level.settings = reader.getSettings();
+    std::vector<LevelCell> cells(LevelLoader::CHUNK_SIZE);
+    while (std::size_t count = reader.read(cells))
+    {
+        level.cells.insert(level.cells.end(), cells.begin(), cells.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+    if (reader.failed()) return 1;
+
+    const EnvSettings settings;
+    const SolverResult result = BeamSolver::solve(level, params, settings);
+
+    std::cout << level.cells.size() << " bricks, beam " << params.beamWidth << " x " << params.branches
+              << " contact points" << std::endl;
+    const double gameSeconds = result.frames * static_cast<double>(settings.frameTime);
+    if (result.cleared)
+    {
+        std::cout << "cleared in " << gameSeconds << " s (" << result.frames << " frames, " << result.bounces
+                  << " bounces)" << std::endl;
+    }
+    else
+    {
+        std::cout << "no clear found; best game has " << result.bricksLeft << " bricks left after " << gameSeconds
+                  << " s (" << result.bounces << " bounces)" << std::endl;
+    }
+    std::cout << "contacts:";
+    for (float contact : result.contacts)
+    {
+        std::cout << ' ' << std::fixed << std::setprecision(2) << contact;
+    }
+    std::cout << std::defaultfloat << std::endl;
+    std::cout << result.nodes << " nodes, " << result.envSteps << " env-steps in " << result.seconds << " s: "
+              << result.nodes / result.seconds << " nodes/s, " << result.envSteps / result.seconds / 1e6
+              << " M env-steps/s" << std::endl;
+    return 0;
+}